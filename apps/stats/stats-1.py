@@ -37,9 +37,12 @@
 import os
 import gc
 import sys
+import json
 import time
+import tempfile
 import resource
 import collections
+import subprocess32 as subprocess
 
 import IECore
 
@@ -56,7 +59,9 @@ class stats( Gaffer.Application ) :
 			Gaffer that created it, the values of all setting and variables and
 			the types of node in use. May also be used to perform performance
 			analysis of image and scene processing nodes within the script, using
-			a performance monitor to generate advanced statistics.
+			a performance monitor to generate advanced statistics, including
+			the memory each node holds in the compute cache and how often
+			results are recomputed after being evicted.
 
 			To print basic information about a script :
 
@@ -75,6 +80,13 @@ class stats( Gaffer.Application ) :
 			```
 			gaffer stats fileName.gfr -image NameOfNode -performanceMonitor
 			```
+
+			To benchmark a scene with several thread counts, saving the results
+			and comparing them against those from a previous run :
+
+			```
+			gaffer stats fileName.gfr -scene NameOfNode -benchmark -threadCounts 1 8 -json results.json -baseline previousResults.json
+			```
 			"""
 		)
 
@@ -122,6 +134,57 @@ class stats( Gaffer.Application ) :
 					defaultValue = 50,
 				),
 
+				IECore.BoolParameter(
+					name = "benchmark",
+					description = "Evaluates the scene or image repeatedly, alternating "
+						"between cold runs (starting with empty caches) and warm runs "
+						"(reusing the caches from the previous cold run). Timings, "
+						"hash and compute counts, and memory usage are recorded for each run.",
+					defaultValue = False,
+				),
+
+				IECore.IntParameter(
+					name = "repeat",
+					description = "The number of cold and warm runs to perform in "
+						"benchmark mode.",
+					defaultValue = 3,
+					minValue = 1,
+				),
+
+				IECore.IntVectorParameter(
+					name = "threadCounts",
+					description = "The thread counts to benchmark with. Each thread count "
+						"is benchmarked in a separate process. When empty, only the "
+						"value of the threads parameter is used.",
+					defaultValue = IECore.IntVectorData(),
+				),
+
+				IECore.FileNameParameter(
+					name = "json",
+					description = "A file to write the benchmark results to, in JSON format.",
+					defaultValue = "",
+					allowEmptyString = True,
+					extensions = "json",
+				),
+
+				IECore.FileNameParameter(
+					name = "baseline",
+					description = "A file containing the JSON results of a previous benchmark, "
+						"to compare the current results against. The application returns "
+						"a non-zero exit status if a regression is found.",
+					defaultValue = "",
+					allowEmptyString = True,
+					extensions = "json",
+				),
+
+				IECore.FloatParameter(
+					name = "tolerance",
+					description = "The fraction by which a benchmark result may exceed "
+						"the baseline before it is considered to be a regression.",
+					defaultValue = 0.1,
+					minValue = 0,
+				),
+
 			]
 
 		)
@@ -153,6 +216,7 @@ class stats( Gaffer.Application ) :
 
 		self.__memory["Script"] = _Memory.maxRSS() - self.__memory["Application"]
 
+		status = 0
 		with Gaffer.Context( script.context() ) as context :
 
 			context.setFrame( args["frame"].value )
@@ -179,6 +243,10 @@ class stats( Gaffer.Application ) :
 
 				self.__printImage( script, args )
 
+			if args["benchmark"].value :
+
+				status = self.__benchmark( script, args )
+
 		print ""
 
 		self.__printMemory()
@@ -189,6 +257,8 @@ class stats( Gaffer.Application ) :
 
 		print
 
+		return status
+
 	def __printVersion( self, script ) :
 
 		numbers = [ Gaffer.Metadata.nodeValue( script, "serialiser:" + x + "Version" ) for x in ( "milestone", "major", "minor", "patch" ) ]
@@ -266,10 +336,9 @@ class stats( Gaffer.Application ) :
 		print "Nodes :\n"
 		self.__printItems( items )
 
-	def __printScene( self, script, args ) :
+	def __scene( self, script, args ) :
 
 		import GafferScene
-		import GafferSceneTest
 
 		scene = script.descendant( args["scene"].value )
 		if isinstance( scene, Gaffer.Node ) :
@@ -277,6 +346,28 @@ class stats( Gaffer.Application ) :
 
 		if scene is None :
 			IECore.msg( IECore.Msg.Level.Error, "stats", "Scene \"%s\" does not exist" % args["scene"].value )
+
+		return scene
+
+	def __image( self, script, args ) :
+
+		import GafferImage
+
+		image = script.descendant( args["image"].value )
+		if isinstance( image, Gaffer.Node ) :
+			image = next( ( x for x in image.children( GafferImage.ImagePlug ) ), None )
+
+		if image is None :
+			IECore.msg( IECore.Msg.Level.Error, "stats", "Image \"%s\" does not exist" % args["image"].value )
+
+		return image
+
+	def __printScene( self, script, args ) :
+
+		import GafferSceneTest
+
+		scene = self.__scene( script, args )
+		if scene is None :
 			return
 
 		memory = _Memory.maxRSS()
@@ -292,15 +383,10 @@ class stats( Gaffer.Application ) :
 
 	def __printImage( self, script, args ) :
 
-		import GafferImage
 		import GafferImageTest
 
-		image = script.descendant( args["image"].value )
-		if isinstance( image, Gaffer.Node ) :
-			image = next( ( x for x in image.children( GafferImage.ImagePlug ) ), None )
-
+		image = self.__image( script, args )
 		if image is None :
-			IECore.msg( IECore.Msg.Level.Error, "stats", "Image \"%s\" does not exist" % args["image"].value )
 			return
 
 		memory = _Memory.maxRSS()
@@ -319,6 +405,180 @@ class stats( Gaffer.Application ) :
 		print "\nImage :\n"
 		self.__printItems( items )
 
+	def __benchmark( self, script, args ) :
+
+		if len( args["threadCounts"] ) :
+			threads = self.__benchmarkThreadCounts( script, args )
+		else :
+			threads = self.__benchmarkInProcess( script, args )
+
+		if threads is None :
+			return 1
+
+		results = {
+			"script" : script["fileName"].getValue(),
+			"frame" : args["frame"].value,
+			"scene" : args["scene"].value,
+			"image" : args["image"].value,
+			"gafferVersion" : Gaffer.About.versionString(),
+			"threads" : threads,
+		}
+
+		print "\nBenchmark :\n"
+
+		items = []
+		for threadCount in sorted( threads.keys(), key = int ) :
+			for mode in ( "cold", "warm" ) :
+				items.append( (
+					"{0} threads ({1})".format( threadCount if threadCount != "0" else "automatic", mode ),
+					"%.3fs (wall, median)" % _median( [ r["wallTime"] for r in threads[threadCount][mode] ] ),
+				) )
+		self.__printItems( items )
+
+		if args["json"].value :
+			with open( args["json"].value, "w" ) as f :
+				json.dump( results, f, indent = 4, sort_keys = True )
+
+		if args["baseline"].value :
+			with open( args["baseline"].value ) as f :
+				baseline = json.load( f )
+			if not self.__compareBenchmark( results, baseline, args["tolerance"].value ) :
+				return 1
+
+		return 0
+
+	def __benchmarkInProcess( self, script, args ) :
+
+		if args["scene"].value :
+			import GafferSceneTest
+			plug = self.__scene( script, args )
+			evaluate = GafferSceneTest.traverseScene
+		elif args["image"].value :
+			import GafferImageTest
+			plug = self.__image( script, args )
+			evaluate = GafferImageTest.processTiles
+		else :
+			IECore.msg( IECore.Msg.Level.Error, "stats", "Benchmarking requires a scene or an image" )
+			return None
+
+		if plug is None :
+			return None
+
+		result = { "cold" : [], "warm" : [] }
+		for i in range( 0, args["repeat"].value ) :
+
+			# Empty the compute cache, and use a unique context variable
+			# to stop the hash cache from being used, so that the cold
+			# run must start from scratch.
+			cacheMemoryLimit = Gaffer.ValuePlug.getCacheMemoryLimit()
+			Gaffer.ValuePlug.setCacheMemoryLimit( 0 )
+			Gaffer.ValuePlug.setCacheMemoryLimit( cacheMemoryLimit )
+
+			with Gaffer.Context( Gaffer.Context.current() ) as context :
+				context["stats:benchmarkRun"] = i
+				result["cold"].append( self.__benchmarkRun( evaluate, plug ) )
+				result["warm"].append( self.__benchmarkRun( evaluate, plug ) )
+
+		result["maxRSS"] = _Memory.maxRSS().bytes()
+
+		return { str( args["threads"].value ) : result }
+
+	def __benchmarkRun( self, evaluate, plug ) :
+
+		monitor = Gaffer.PerformanceMonitor()
+		with _Timer() as timer :
+			with monitor :
+				evaluate( plug )
+
+		statistics = Gaffer.PerformanceMonitor.Statistics()
+		for s in monitor.allStatistics().values() :
+			statistics.hashCount += s.hashCount
+			statistics.computeCount += s.computeCount
+			statistics.hashDuration += s.hashDuration
+			statistics.computeDuration += s.computeDuration
+
+		return {
+			"wallTime" : timer.wallTime(),
+			"cpuTime" : timer.cpuTime(),
+			"hashCount" : statistics.hashCount,
+			"computeCount" : statistics.computeCount,
+			"hashDuration" : statistics.hashDuration / 1e9,
+			"computeDuration" : statistics.computeDuration / 1e9,
+			"cacheUsage" : Gaffer.ValuePlug.cacheMemoryUsage(),
+		}
+
+	def __benchmarkThreadCounts( self, script, args ) :
+
+		# Each thread count is run in a separate process, as the
+		# thread count can't be changed reliably once the task
+		# scheduler has been initialised.
+
+		result = {}
+		for threadCount in args["threadCounts"] :
+
+			fileName = tempfile.mkstemp( suffix = ".json" )[1]
+			command = [
+				"gaffer", "stats", script["fileName"].getValue(),
+				"-frame", str( args["frame"].value ),
+				"-benchmark",
+				"-repeat", str( args["repeat"].value ),
+				"-threads", str( threadCount ),
+				"-json", fileName,
+			]
+			for name in ( "scene", "image" ) :
+				if args[name].value :
+					command.extend( [ "-" + name, args[name].value ] )
+
+			try :
+				subprocess.check_output( command, stderr = subprocess.STDOUT )
+				with open( fileName ) as f :
+					result.update( json.load( f )["threads"] )
+			except subprocess.CalledProcessError as e :
+				IECore.msg( IECore.Msg.Level.Error, "stats", "Benchmark with {0} threads failed :\n{1}".format( threadCount, e.output ) )
+				return None
+			finally :
+				os.remove( fileName )
+
+		return result
+
+	def __compareBenchmark( self, results, baseline, tolerance ) :
+
+		items = []
+		passed = True
+
+		def compare( name, value, baselineValue ) :
+
+			regression = value > baselineValue * ( 1 + tolerance )
+			items.append( (
+				name,
+				"{0:.6g} (baseline {1:.6g}){2}".format( value, baselineValue, " REGRESSION" if regression else "" )
+			) )
+			return not regression
+
+		for threadCount in sorted( results["threads"].keys(), key = int ) :
+
+			if threadCount not in baseline["threads"] :
+				IECore.msg( IECore.Msg.Level.Warning, "stats", "Baseline has no results for {0} threads".format( threadCount ) )
+				continue
+
+			current = results["threads"][threadCount]
+			previous = baseline["threads"][threadCount]
+
+			for mode in ( "cold", "warm" ) :
+				for metric in ( "wallTime", "hashCount", "computeCount" ) :
+					passed = compare(
+						"{0} threads ({1}) {2}".format( threadCount, mode, metric ),
+						_median( [ r[metric] for r in current[mode] ] ),
+						_median( [ r[metric] for r in previous[mode] ] ),
+					) and passed
+
+			passed = compare( "{0} threads maxRSS".format( threadCount ), current["maxRSS"], previous["maxRSS"] ) and passed
+
+		print "\nBaseline comparison (tolerance {0:.0%}) :\n".format( tolerance )
+		self.__printItems( items )
+
+		return passed
+
 	def __printMemory( self ) :
 
 		objectPool = IECore.ObjectPool.defaultObjectPool()
@@ -356,6 +616,24 @@ class stats( Gaffer.Application ) :
 					maxLinesPerMetric = args["maxLinesPerMetric"].value
 				)
 
+				self.__printCacheMemoryByNode( script, args )
+
+	def __printCacheMemoryByNode( self, script, args ) :
+
+		memory = collections.defaultdict( int )
+		for plug, statistics in self.__performanceMonitor.allStatistics().items() :
+			node = plug.node()
+			if node is not None and statistics.cacheMemory :
+				memory[node] += statistics.cacheMemory
+
+		if not memory :
+			return
+
+		items = sorted( memory.items(), key = lambda x : x[1], reverse = True )[:args["maxLinesPerMetric"].value]
+
+		print "\nTop {0} nodes by memory held in the compute cache :\n".format( len( items ) )
+		self.__printItems( [ ( node.relativeName( script ), _Memory( bytes ) ) for node, bytes in items ] )
+
 class _Timer( object ) :
 
 	def __enter__( self ) :
@@ -370,6 +648,14 @@ class _Timer( object ) :
 		self.__time = time.time() - self.__time
 		self.__clock = time.clock() - self.__clock
 
+	def wallTime( self ) :
+
+		return self.__time
+
+	def cpuTime( self ) :
+
+		return self.__clock
+
 	def __str__( self ) :
 
 		return "%.3fs (wall), %.3fs (CPU)" % ( self.__time, self.__clock )
@@ -388,6 +674,10 @@ class _Memory( object ) :
 		else :
 			return cls( resource.getrusage( resource.RUSAGE_SELF ).ru_maxrss * 1024 )
 
+	def bytes( self ) :
+
+		return self.__bytes
+
 	def __str__( self ) :
 
 		return "%.3fM" % ( self.__bytes / ( 1024 * 1024. ) )
@@ -396,6 +686,15 @@ class _Memory( object ) :
 
 		return _Memory( self.__bytes - other.__bytes )
 
+def _median( values ) :
+
+	values = sorted( values )
+	n = len( values )
+	if n % 2 :
+		return values[n//2]
+	else :
+		return ( values[n//2-1] + values[n//2] ) / 2.0
+
 class _NullContextManager( object ) :
 
 	def __enter__( self ) :
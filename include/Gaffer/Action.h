@@ -98,6 +98,12 @@ class Action : public IECore::RunTimeTyped
 		/// system, so it is sufficient to bind only raw pointers to the subject.
 		static void enact( GraphComponentPtr subject, const Function &doFn, const Function &undoFn );
 
+		/// Returns an estimate of the memory in bytes held by the action.
+		/// This is used by the ScriptNode to limit the size of the undo list.
+		/// Derived classes holding significant amounts of data should
+		/// reimplement it, adding their own usage to that of the base class.
+		virtual size_t memoryUsage() const;
+
 	protected :
 
 		Action();
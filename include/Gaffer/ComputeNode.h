@@ -39,6 +39,7 @@
 #define GAFFER_COMPUTENODE_H
 
 #include "IECore/MurmurHash.h"
+#include "IECore/InternedString.h"
 
 #include "Gaffer/DependencyNode.h"
 
@@ -63,6 +64,20 @@ class ComputeNode : public DependencyNode
 
 		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( Gaffer::ComputeNode, ComputeNodeTypeId, DependencyNode );
 
+		/// May be implemented to declare context variables which can never affect
+		/// the value of an output plug. Before hash() and compute() are called for
+		/// the output, these variables are removed from the context, so they are
+		/// also invisible to any upstream computations. Since they are excluded from
+		/// the keys used by the hash cache, evaluating the output in contexts which
+		/// differ only by these variables (for instance, the "scene:path" for a global
+		/// computation) reuses a single cache entry instead of hashing the upstream
+		/// network repeatedly.
+		///
+		/// The returned vector must remain valid for the lifetime of the node, and
+		/// will typically be a static. The default implementation returns NULL,
+		/// conservatively declaring that all outputs may depend on any variable.
+		virtual const std::vector<IECore::InternedString> *ignoredContextVariables( const ValuePlug *output ) const;
+
 	protected :
 
 		/// Called to compute the hashes for output Plugs. Must be implemented to call the base
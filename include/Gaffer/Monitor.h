@@ -39,6 +39,8 @@
 
 #include "boost/noncopyable.hpp"
 
+#include "IECore/MurmurHash.h"
+
 namespace Gaffer
 {
 
@@ -82,6 +84,21 @@ class Monitor : boost::noncopyable
 		/// Implementations must be safe to call concurrently.
 		virtual void processFinished( const Process *process ) = 0;
 
+		/// Called when a process stores its result in a cache, under
+		/// the specified hash and with the specified memory cost.
+		/// The default implementation does nothing. Implementations
+		/// must be safe to call concurrently.
+		virtual void cacheStored( const Process *process, const IECore::MurmurHash &hash, size_t cost );
+		/// Called when a result is removed from a cache. The `cleared`
+		/// argument is true when the removal was explicitly requested,
+		/// for instance by reducing the cache memory limit, and false
+		/// when the result was evicted to make room for others. Note that
+		/// this may be called for results which were stored before
+		/// the monitor was made active. The default implementation
+		/// does nothing. Implementations must be safe to call concurrently,
+		/// and must not access the cache in question.
+		virtual void cacheRemoved( const IECore::MurmurHash &hash, bool cleared );
+
 };
 
 } // namespace Gaffer
@@ -55,9 +55,13 @@ enum PerformanceMetric
 	PerHashDuration,
 	PerComputeDuration,
 	HashesPerCompute,
+	CacheCount,
+	CacheMemory,
+	EvictionCount,
+	RecomputeCount,
 
 	First = HashCount,
-	Last = HashesPerCompute
+	Last = RecomputeCount
 };
 
 std::string formatStatistics( const PerformanceMonitor &monitor, size_t maxLinesPerMetric = 50 );
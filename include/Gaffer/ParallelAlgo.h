@@ -0,0 +1,72 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFER_PARALLELALGO_H
+#define GAFFER_PARALLELALGO_H
+
+namespace Gaffer
+{
+
+/// Task isolation
+/// ==============
+///
+/// While a thread waits for the TBB tasks it has spawned to complete, it
+/// is free to steal any other task to work on in the meantime. When the
+/// wait occurs inside a compute, the stolen task may be an unrelated one
+/// which itself needs the result of the compute in progress, or which
+/// spawns further nested work, leading to stalls and excessive stack use.
+/// The following functions should therefore be used for any parallel
+/// work launched from within a compute, so that waiting threads will
+/// only take on tasks spawned within the same isolated region.
+
+/// Calls `f()`, ensuring that any tasks it spawns are isolated from tasks
+/// spawned outside it.
+template<typename F>
+void isolate( const F &f );
+
+/// Equivalent to `tbb::parallel_for( range, body )`, but with isolation.
+template<typename Range, typename Body>
+void isolatedParallelFor( const Range &range, const Body &body );
+
+/// Equivalent to `tbb::parallel_reduce( range, body )`, but with isolation.
+template<typename Range, typename Body>
+void isolatedParallelReduce( const Range &range, Body &body );
+
+} // namespace Gaffer
+
+#include "Gaffer/ParallelAlgo.inl"
+
+#endif // GAFFER_PARALLELALGO_H
@@ -0,0 +1,147 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFER_PARALLELALGO_INL
+#define GAFFER_PARALLELALGO_INL
+
+#include "boost/noncopyable.hpp"
+
+#include "tbb/task_arena.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_reduce.h"
+
+namespace Gaffer
+{
+
+namespace Detail
+{
+
+template<typename Range, typename Body>
+struct ParallelForFunctor
+{
+
+	ParallelForFunctor( const Range &range, const Body &body )
+		:	range( range ), body( body )
+	{
+	}
+
+	void operator()() const
+	{
+		tbb::parallel_for( range, body );
+	}
+
+	const Range &range;
+	const Body &body;
+
+};
+
+template<typename Range, typename Body>
+struct ParallelReduceFunctor
+{
+
+	ParallelReduceFunctor( const Range &range, Body &body )
+		:	range( range ), body( body )
+	{
+	}
+
+	void operator()() const
+	{
+		tbb::parallel_reduce( range, body );
+	}
+
+	const Range &range;
+	Body &body;
+
+};
+
+#if TBB_INTERFACE_VERSION < 10000
+
+// Provides the arena used to isolate work on the current thread.
+// Arenas are expensive to create and slow to be populated by
+// worker threads, so rather than make a new one for every call
+// we keep one per thread and per nesting level, reusing them
+// from call to call. Separate nesting levels get separate arenas,
+// so that a thread waiting in an inner region can't steal tasks
+// from the outer region it is nested in.
+class IsolationArenaScope : boost::noncopyable
+{
+
+	public :
+
+		IsolationArenaScope();
+		~IsolationArenaScope();
+
+		tbb::task_arena &arena() const { return *m_arena; }
+
+	private :
+
+		tbb::task_arena *m_arena;
+
+};
+
+#endif
+
+} // namespace Detail
+
+template<typename F>
+void isolate( const F &f )
+{
+#if TBB_INTERFACE_VERSION >= 10000
+	tbb::this_task_arena::isolate( f );
+#else
+	// Task isolation isn't available, so we use a separate arena
+	// instead. While waiting in the arena, the calling thread will
+	// only execute tasks which were spawned within it.
+	Detail::IsolationArenaScope arenaScope;
+	arenaScope.arena().execute( f );
+#endif
+}
+
+template<typename Range, typename Body>
+void isolatedParallelFor( const Range &range, const Body &body )
+{
+	isolate( Detail::ParallelForFunctor<Range, Body>( range, body ) );
+}
+
+template<typename Range, typename Body>
+void isolatedParallelReduce( const Range &range, Body &body )
+{
+	isolate( Detail::ParallelReduceFunctor<Range, Body>( range, body ) );
+}
+
+} // namespace Gaffer
+
+#endif // GAFFER_PARALLELALGO_INL
@@ -113,7 +113,8 @@ class Path : public IECore::RunTimeTyped
 
 		/// Fills the vector with Path instances representing all
 		/// the children of this path. Note that an empty list may
-		/// be returned even if isLeaf() is false.
+		/// be returned even if isLeaf() is false. See PathChildrenTask
+		/// for a means of evaluating children on a background thread.
 		size_t children( std::vector<PathPtr> &children ) const;
 
 		void setFilter( PathFilterPtr filter );
@@ -0,0 +1,154 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFER_PATHCHILDRENTASK_H
+#define GAFFER_PATHCHILDRENTASK_H
+
+#include "boost/shared_ptr.hpp"
+
+#include "IECore/RefCounted.h"
+#include "IECore/RunTimeTyped.h"
+#include "IECore/InternedString.h"
+
+#include "Gaffer/Path.h"
+
+namespace Gaffer
+{
+
+/// Evaluates the children of a Path, along with a set of their
+/// properties, as a background task in the shared TBB thread pool,
+/// so that many tasks may be in flight without each needing a
+/// thread of its own. Results are streamed back
+/// in chunks, so that a UI may populate itself progressively while
+/// the remaining children are still being evaluated. This avoids
+/// blocking the UI thread when exploring large hierarchies or slow
+/// filesystems.
+///
+/// The task operates on a copy of the Path passed to the constructor,
+/// so the original may be modified freely once the task has been
+/// launched. Cancellation is cooperative : cancel() returns immediately,
+/// and no further children are delivered once it has been called. The
+/// background task will stop at the next opportunity, but cannot
+/// interrupt an individual doChildren() or property() call that is
+/// already in progress.
+///
+/// Because cancel() doesn't wait, a background task may still be
+/// evaluating while the caller goes on to do other things. Paths which
+/// evaluate the node graph, such as GafferScene::ScenePath, must therefore
+/// not be evaluated in the background, since the graph may be edited
+/// concurrently on the UI thread, and evaluating it during edits is not
+/// permitted.
+class PathChildrenTask : public IECore::RefCounted
+{
+
+	public :
+
+		IE_CORE_DECLAREMEMBERPTR( PathChildrenTask )
+
+		typedef std::vector<IECore::InternedString> PropertyNames;
+		typedef std::vector<IECore::ConstRunTimeTypedPtr> Properties;
+
+		struct Child
+		{
+			PathPtr path;
+			/// The values of the properties requested in the
+			/// constructor, in the same order as the names.
+			Properties properties;
+		};
+
+		typedef std::vector<Child> Children;
+
+		enum Status
+		{
+			Running,
+			Completed,
+			Cancelled,
+			Errored
+		};
+
+		/// Launches the background evaluation. Children are made available
+		/// in chunks of `chunkSize`, each chunk only being delivered once all
+		/// of its properties have been evaluated.
+		///
+		/// If `background` is false, then everything is instead evaluated
+		/// serially on the calling thread before the constructor returns.
+		/// This must be used for Paths and PathFilters which evaluate the
+		/// node graph, and for those implemented in Python, which may only
+		/// be evaluated (and destroyed) while holding the GIL.
+		PathChildrenTask( const Path *path, const PropertyNames &propertyNames = PropertyNames(), size_t chunkSize = 100, bool background = true );
+		/// Cancels the task if it is still running. Does not wait for
+		/// the background task to finish.
+		virtual ~PathChildrenTask();
+
+		const PropertyNames &propertyNames() const;
+
+		/// Appends all children made available since the last call,
+		/// in the same order as Path::children() would return them.
+		/// Returns the status at the time of the call - if this is
+		/// anything other than Running, then all the children that
+		/// will ever be available have now been taken.
+		Status takeChildren( Children &children );
+
+		/// Requests that the task stops as soon as possible. No further
+		/// children will be delivered by takeChildren().
+		void cancel();
+		Status status() const;
+		/// Blocks until the task is no longer running. Note that
+		/// Python-implemented Paths need the GIL to be evaluated,
+		/// so this must not be called with the GIL held.
+		Status wait();
+		/// Returns the error message for an Errored task.
+		std::string error() const;
+
+	private :
+
+		struct State;
+		typedef boost::shared_ptr<State> StatePtr;
+
+		static void run( StatePtr state, bool parallel );
+
+		// Shared with the background task, so that we don't
+		// need to keep the PathChildrenTask itself alive until
+		// the background task has finished.
+		StatePtr m_state;
+
+};
+
+IE_CORE_DECLAREPTR( PathChildrenTask )
+
+} // namespace Gaffer
+
+#endif // GAFFER_PATHCHILDRENTASK_H
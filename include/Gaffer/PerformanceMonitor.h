@@ -40,6 +40,8 @@
 #include <stack>
 
 #include "tbb/enumerable_thread_specific.h"
+#include "tbb/concurrent_hash_map.h"
+#include "tbb/atomic.h"
 
 #include "boost/unordered_map.hpp"
 #include "boost/chrono.hpp"
@@ -54,7 +56,8 @@ namespace Gaffer
 IE_CORE_FORWARDDECLARE( Plug )
 
 /// A monitor which collects statistics about the frequency
-/// of hash and compute processes per plug.
+/// of hash and compute processes per plug, and about the
+/// use each plug makes of the compute cache.
 class PerformanceMonitor : public Monitor
 {
 
@@ -70,13 +73,34 @@ class PerformanceMonitor : public Monitor
 				size_t hashCount = 0,
 				size_t computeCount = 0,
 				boost::chrono::nanoseconds hashDuration = boost::chrono::nanoseconds( 0 ),
-				boost::chrono::nanoseconds computeDuration = boost::chrono::nanoseconds( 0 )
+				boost::chrono::nanoseconds computeDuration = boost::chrono::nanoseconds( 0 ),
+				size_t cacheCount = 0,
+				size_t cacheMemory = 0,
+				size_t evictionCount = 0,
+				size_t recomputeCount = 0,
+				size_t clearCount = 0
 			);
 
 			size_t hashCount;
 			size_t computeCount;
 			boost::chrono::nanoseconds hashDuration;
 			boost::chrono::nanoseconds computeDuration;
+			/// The number of results stored in the cache
+			/// while the monitor was active, and which have
+			/// not yet been evicted.
+			size_t cacheCount;
+			/// The memory used by the results above.
+			size_t cacheMemory;
+			/// The number of results evicted from the cache
+			/// while the monitor was active.
+			size_t evictionCount;
+			/// The number of results which were computed again
+			/// after having been evicted from the cache. High
+			/// values indicate that the cache is thrashing.
+			size_t recomputeCount;
+			/// The number of results removed from the cache by
+			/// explicit clears, which are not counted as evictions.
+			size_t clearCount;
 
 			Statistics & operator += ( const Statistics &rhs );
 
@@ -94,6 +118,8 @@ class PerformanceMonitor : public Monitor
 
 		virtual void processStarted( const Process *process );
 		virtual void processFinished( const Process *process );
+		virtual void cacheStored( const Process *process, const IECore::MurmurHash &hash, size_t cost );
+		virtual void cacheRemoved( const IECore::MurmurHash &hash, bool cleared );
 
 	private :
 
@@ -114,6 +140,24 @@ class PerformanceMonitor : public Monitor
 		
 		tbb::enumerable_thread_specific<ThreadData, tbb::cache_aligned_allocator<ThreadData>, tbb::ets_key_per_instance> m_threadData;
 
+		// The cache entries we've seen stored, so that we can
+		// attribute removals back to the plug that stored them,
+		// and detect results being recomputed after removal. Live
+		// entries are bounded by the size of the cache itself, and
+		// we keep at most `g_maxRemovedCacheEntries` removed ones,
+		// erasing any beyond that. The plug is held by raw pointer
+		// because the statistics map already keeps it alive.
+		struct CacheEntry
+		{
+			const Plug *plug;
+			size_t cost;
+			bool removed;
+		};
+
+		typedef tbb::concurrent_hash_map<IECore::MurmurHash, CacheEntry> CacheEntries;
+		CacheEntries m_cacheEntries;
+		tbb::atomic<size_t> m_removedCacheEntries;
+
 		// Then when we want to query it, we collate it into m_statistics.
 		void collate() const;
 		mutable StatisticsMap m_statistics;
@@ -42,6 +42,7 @@
 #include "boost/noncopyable.hpp"
 
 #include "IECore/InternedString.h"
+#include "IECore/MurmurHash.h"
 
 namespace Gaffer
 {
@@ -94,6 +95,12 @@ class Process : public boost::noncopyable
 		/// we use C++11's current_exception() in our destructor perhaps?
 		void handleException();
 
+		/// Derived classes which store their results in a cache
+		/// should call these methods so that monitors can track
+		/// the cache usage of each plug.
+		void cacheStored( const IECore::MurmurHash &hash, size_t cost ) const;
+		static void cacheRemoved( const IECore::MurmurHash &hash, bool cleared );
+
 	private :
 
 		// Friendship allows monitors to register and deregister
@@ -120,6 +120,15 @@ class ScriptNode : public Node
 		ActionSignal &actionSignal();
 		/// A signal emitted when an item is added to the undo stack.
 		UndoAddedSignal &undoAddedSignal();
+		/// Returns the maximum amount of memory in bytes to use for the
+		/// undo list.
+		size_t getUndoMemoryLimit() const;
+		/// Sets the maximum amount of memory the undo list may use in bytes.
+		/// When the limit is exceeded, the oldest entries are discarded.
+		void setUndoMemoryLimit( size_t bytes );
+		/// Returns an estimate of the memory currently used by the undo
+		/// list, in bytes.
+		size_t undoMemoryUsage() const;
 		//@}
 
 		//! @name Editing
@@ -261,6 +270,9 @@ class ScriptNode : public Node
 		void pushUndoState( UndoContext::State state, const std::string &mergeGroup );
 		void addAction( ActionPtr action );
 		void popUndoState();
+		// Discards old entries from the undo list to keep
+		// it within the memory limit.
+		void limitUndoMemory();
 
 		typedef std::stack<UndoContext::State> UndoStateStack;
 		typedef std::list<CompoundActionPtr> UndoList;
@@ -272,6 +284,8 @@ class ScriptNode : public Node
 		CompoundActionPtr m_actionAccumulator; // Actions are accumulated here until the state stack hits 0 size
 		UndoList m_undoList; // then the accumulated actions are transferred to this list for storage
 		UndoIterator m_undoIterator; // points to the next thing to redo
+		size_t m_undoMemoryLimit;
+		size_t m_undoMemoryUsage; // sum of memoryUsage() for everything in m_undoList
 		Action::Stage m_currentActionStage;
 
 		ScriptExecutedSignal m_scriptExecutedSignal;
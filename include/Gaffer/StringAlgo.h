@@ -39,6 +39,7 @@
 #define GAFFER_STRINGALGO_H
 
 #include <string>
+#include <vector>
 
 namespace Gaffer
 {
@@ -61,6 +62,48 @@ inline bool match( const char *s, const char *pattern );
 inline bool matchMultiple( const std::string &s, const MatchPattern &patterns );
 inline bool matchMultiple( const char *s, const char *patterns );
 
+/// A precompiled form of a MatchPattern, for use when the same pattern
+/// is to be matched against many strings. The pattern is analysed once
+/// on construction, so that the common cases of literal patterns and of
+/// patterns with a single leading or trailing "*" are matched without
+/// interpreting the pattern character by character.
+class CompiledMatchPattern
+{
+
+	public :
+
+		/// If multiple is true, the pattern is treated as a list of
+		/// patterns separated by spaces, as for matchMultiple().
+		CompiledMatchPattern( const MatchPattern &pattern, bool multiple = false );
+
+		/// Returns true if the string matches the pattern and false otherwise.
+		inline bool match( const std::string &s ) const;
+		inline bool match( const char *s ) const;
+
+	private :
+
+		struct Term
+		{
+			enum Type
+			{
+				Literal,
+				Prefix,
+				Suffix,
+				General
+			};
+
+			Term( Type type, const std::string &pattern );
+
+			Type type;
+			std::string pattern;
+		};
+
+		inline static bool matchTerm( const Term &term, const char *s, size_t size );
+
+		std::vector<Term> m_terms;
+
+};
+
 /// Returns true if the specified pattern contains characters which
 /// have special meaning to the match() function.
 inline bool hasWildcards( const MatchPattern &pattern );
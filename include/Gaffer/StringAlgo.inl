@@ -46,73 +46,43 @@ namespace Gaffer
 namespace Detail
 {
 
-inline bool matchInternal( const char * const ss, const char *pattern, bool multiple = false )
+// Matches a single pattern ending at patternEnd. Runs of "*" are handled
+// by remembering only the most recent one and resuming from there when a
+// subsequent literal fails to match, so this never backtracks further
+// than that and takes at most O( string length * pattern length ) time.
+inline bool matchSingle( const char *s, const char *pattern, const char *patternEnd )
 {
-	char c;
-	const char *s = ss;
-	while( true )
+	const char *star = NULL;
+	const char *starS = s;
+	while( *s != '\0' )
 	{
-		switch( c = *pattern++ )
+		if( pattern != patternEnd && *pattern == '*' )
+		{
+			star = ++pattern;
+			starS = s;
+		}
+		else if( pattern != patternEnd && *pattern == *s )
+		{
+			++pattern;
+			++s;
+		}
+		else if( star )
 		{
-			case '\0' :
-
-				return *s == c;
-
-			case '*' :
-
-				if( *pattern == '\0' || ( multiple && *pattern == ' ' ) )
-				{
-					// optimisation for when pattern
-					// ends with '*'.
-					return true;
-				}
-
-				// general case - recurse.
-				while( *s != '\0' )
-				{
-					if( matchInternal( s, pattern, multiple ) )
-					{
-						return true;
-					}
-					s++;
-				}
-				return false;
-
-			default :
-
-				if( c == *s )
-				{
-					s++;
-				}
-				else if( !multiple )
-				{
-					return false;
-				}
-				else
-				{
-					if( c == ' ' && *s == '\0' )
-					{
-						// space terminates sub-patterns, so we've
-						// found a match.
-						return true;
-					}
-					else
-					{
-						// no match in this pattern. reset to start
-						// of string, and advance to next pattern.
-						s = ss;
-						while( c != ' ' )
-						{
-							if( c == '\0' )
-							{
-								return false;
-							}
-							c = *pattern++;
-						}
-					}
-				}
+			pattern = star;
+			s = ++starS;
 		}
+		else
+		{
+			return false;
+		}
+	}
+
+	while( pattern != patternEnd && *pattern == '*' )
+	{
+		++pattern;
 	}
+
+	return pattern == patternEnd;
 }
 
 } // namespace Detail
@@ -124,7 +94,7 @@ inline bool match( const std::string &string, const std::string &pattern )
 
 inline bool match( const char *s, const char *pattern )
 {
-	return Detail::matchInternal( s, pattern );
+	return Detail::matchSingle( s, pattern, pattern + strlen( pattern ) );
 }
 
 inline bool matchMultiple( const std::string &s, const MatchPattern &patterns )
@@ -134,7 +104,60 @@ inline bool matchMultiple( const std::string &s, const MatchPattern &patterns )
 
 inline bool matchMultiple( const char *s, const char *patterns )
 {
-	return Detail::matchInternal( s, patterns, /* multiple = */ true );
+	while( true )
+	{
+		const char *patternEnd = strchr( patterns, ' ' );
+		if( !patternEnd )
+		{
+			return Detail::matchSingle( s, patterns, patterns + strlen( patterns ) );
+		}
+		if( Detail::matchSingle( s, patterns, patternEnd ) )
+		{
+			return true;
+		}
+		patterns = patternEnd + 1;
+	}
+}
+
+inline bool CompiledMatchPattern::match( const std::string &s ) const
+{
+	for( std::vector<Term>::const_iterator it = m_terms.begin(), eIt = m_terms.end(); it != eIt; ++it )
+	{
+		if( matchTerm( *it, s.c_str(), s.size() ) )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+inline bool CompiledMatchPattern::match( const char *s ) const
+{
+	const size_t size = strlen( s );
+	for( std::vector<Term>::const_iterator it = m_terms.begin(), eIt = m_terms.end(); it != eIt; ++it )
+	{
+		if( matchTerm( *it, s, size ) )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+inline bool CompiledMatchPattern::matchTerm( const Term &term, const char *s, size_t size )
+{
+	const size_t patternSize = term.pattern.size();
+	switch( term.type )
+	{
+		case Term::Literal :
+			return size == patternSize && memcmp( s, term.pattern.c_str(), size ) == 0;
+		case Term::Prefix :
+			return size >= patternSize && memcmp( s, term.pattern.c_str(), patternSize ) == 0;
+		case Term::Suffix :
+			return size >= patternSize && memcmp( s + size - patternSize, term.pattern.c_str(), patternSize ) == 0;
+		default :
+			return Detail::matchSingle( s, term.pattern.c_str(), term.pattern.c_str() + patternSize );
+	}
 }
 
 inline bool hasWildcards( const std::string &pattern )
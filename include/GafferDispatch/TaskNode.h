@@ -37,6 +37,9 @@
 #ifndef GAFFERDISPATCH_TASKNODE_H
 #define GAFFERDISPATCH_TASKNODE_H
 
+#include "boost/noncopyable.hpp"
+#include "boost/scoped_ptr.hpp"
+
 #include "IECore/MurmurHash.h"
 
 #include "Gaffer/Node.h"
@@ -172,6 +175,50 @@ class TaskNode : public Gaffer::Node
 
 		typedef Gaffer::FilteredChildIterator<Gaffer::PlugPredicate<Gaffer::Plug::Invalid, TaskPlug> > TaskPlugIterator;
 
+		IE_CORE_FORWARDDECLARE( TaskMemo )
+
+		/// Stores the results of `TaskPlug::hash()`, `preTasks()` and `postTasks()`,
+		/// keyed on the plug and the hash of the current context, so that tasks
+		/// shared by many downstream tasks need only be queried once. This is
+		/// primarily for use by the Dispatcher, which uses a TaskMemo for the
+		/// duration of graph construction. Results are only valid while the
+		/// node graph remains unedited.
+		class TaskMemo : public IECore::RefCounted
+		{
+
+			public :
+
+				TaskMemo();
+				virtual ~TaskMemo();
+
+				/// Makes the memo current for the calling thread for the
+				/// lifetime of the Scope. A single memo may be made current
+				/// on several threads concurrently.
+				class Scope : boost::noncopyable
+				{
+
+					public :
+
+						Scope( TaskMemo *memo );
+						~Scope();
+
+					private :
+
+						TaskMemo *m_previous;
+
+				};
+
+			private :
+
+				friend class TaskPlug;
+
+				static TaskMemo *current();
+
+				struct Data;
+				boost::scoped_ptr<Data> m_data;
+
+		};
+
 		/// Input plugs to which upstream tasks may be connected to cause them
 		/// to be executed before this node.
 		Gaffer::ArrayPlug *preTasksPlug();
@@ -41,6 +41,7 @@
 #include "boost/tuple/tuple.hpp"
 
 #include "Gaffer/Context.h"
+#include "Gaffer/ParallelAlgo.h"
 #include "GafferImage/ImagePlug.h"
 #include "GafferImage/BufferAlgo.h"
 
@@ -508,7 +509,7 @@ void parallelProcessTiles( const ImagePlug *imagePlug, ThreadableFunctor &functo
 	const Imath::V2i tilesOrigin = ImagePlug::tileOrigin( processWindow.min );
 	const Imath::V2i numTiles = ( ImagePlug::tileOrigin( processWindow.max - Imath::V2i( 1 ) ) - tilesOrigin ) / ImagePlug::tileSize();
 
-	parallel_for( tbb::blocked_range2d<size_t>( 0, numTiles.x, 1, 0, numTiles.y, 1 ),
+	Gaffer::isolatedParallelFor( tbb::blocked_range2d<size_t>( 0, numTiles.x, 1, 0, numTiles.y, 1 ),
 			  GafferImage::Detail::ProcessTiles<ThreadableFunctor>( functor, imagePlug, tilesOrigin, Gaffer::Context::current() ) );
 }
 
@@ -528,7 +529,7 @@ void parallelProcessTiles( const ImagePlug *imagePlug, const std::vector<std::st
 	const Imath::V2i tilesOrigin = ImagePlug::tileOrigin( processWindow.min );
 	Imath::V2i numTiles = ( ( ImagePlug::tileOrigin( processWindow.max - Imath::V2i( 1 ) ) - tilesOrigin ) / ImagePlug::tileSize() ) + Imath::V2i( 1 );
 
-	parallel_for( tbb::blocked_range3d<size_t>( 0, channelNames.size(), 1, 0, numTiles.x, 1, 0, numTiles.y, 1 ),
+	Gaffer::isolatedParallelFor( tbb::blocked_range3d<size_t>( 0, channelNames.size(), 1, 0, numTiles.x, 1, 0, numTiles.y, 1 ),
 			  GafferImage::Detail::ProcessTiles<ThreadableFunctor>( functor, imagePlug, channelNames, tilesOrigin, Gaffer::Context::current() ) );
 }
 
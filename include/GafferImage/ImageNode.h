@@ -68,6 +68,9 @@ class ImageNode : public Gaffer::ComputeNode
 		virtual const Gaffer::BoolPlug *enabledPlug() const;
 
 		virtual void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const;
+		/// Implemented to declare that only the channel data depends on the
+		/// "image:channelName" and "image:tileOrigin" context variables.
+		virtual const std::vector<IECore::InternedString> *ignoredContextVariables( const Gaffer::ValuePlug *output ) const;
 
 	protected :
 
@@ -132,6 +132,14 @@ class ImagePlug : public Gaffer::ValuePlug
 		/// the origin is in the bottom left of the display window with the Y axis
 		/// ascending towards the top of the display window.
 		IECore::ImagePrimitivePtr image() const;
+		/// As above, but rather than allocating an ImagePrimitive, fills the
+		/// caller-provided buffers with the data for the named channels. There
+		/// must be one buffer per channel, each with space for
+		/// `dataWindow.size().x * dataWindow.size().y` floats, where `dataWindow`
+		/// is the value of dataWindowPlug(). Pixels are written top to bottom,
+		/// as for image(). Tiles are copied directly into the buffers in
+		/// parallel, with no intermediate allocations.
+		void image( const std::vector<std::string> &channelNames, const std::vector<float *> &channelData ) const;
 		IECore::MurmurHash imageHash() const;
 		//@}
 
@@ -139,6 +147,31 @@ class ImagePlug : public Gaffer::ValuePlug
 		static const IECore::FloatVectorData *blackTile();
 		static const IECore::FloatVectorData *whiteTile();
 
+		/// Returns a writable tile-sized buffer for use in
+		/// ImageNode::computeChannelData() implementations. Buffers
+		/// are drawn from a small per-thread pool, and are handed out
+		/// again once the pool holds the only remaining reference
+		/// (typically once they have been evicted from the compute
+		/// cache). This avoids allocator churn when many tiles are
+		/// computed in succession, as happens during playback. The
+		/// contents of the returned buffer are undefined, so callers
+		/// must write every element, including any pixels which fall
+		/// outside the data window or receive no contribution.
+		static IECore::FloatVectorDataPtr tileBuffer();
+
+		struct TileBufferStatistics
+		{
+			TileBufferStatistics();
+			/// Number of buffers created by tileBuffer().
+			size_t allocationCount;
+			/// Number of buffers recycled by tileBuffer().
+			size_t reuseCount;
+		};
+
+		/// Returns the combined statistics for the buffer
+		/// pools of all threads.
+		static TileBufferStatistics tileBufferStatistics();
+
 		/// Returns the origin of the tile that contains the point.
 		inline static Imath::V2i tileOrigin( const Imath::V2i &point )
 		{
@@ -42,6 +42,7 @@
 #include "Gaffer/Context.h"
 
 #include "GafferImage/ImagePrimitiveSource.h"
+#include "GafferImage/BufferAlgo.h"
 
 namespace GafferImage
 {
@@ -227,10 +228,6 @@ IECore::ConstFloatVectorDataPtr ImagePrimitiveSource<BaseType>::computeChannelDa
 	}
 	const std::vector<float> &channel = channelData->readable();
 
-	IECore::FloatVectorDataPtr resultData = new IECore::FloatVectorData;
-	std::vector<float> &result = resultData->writable();
-	result.resize( ImagePlug::tileSize() * ImagePlug::tileSize(), 0.0f );
-
 	const Format format( image->getDisplayWindow(), 1.0f, /* fromEXRSpace = */ true );
 	const Imath::Box2i exrDataWindow = image->getDataWindow();
 	const Imath::Box2i dataWindow = format.fromEXRSpace( exrDataWindow );
@@ -238,15 +235,30 @@ IECore::ConstFloatVectorDataPtr ImagePrimitiveSource<BaseType>::computeChannelDa
 	Imath::Box2i tileBound( tileOrigin, tileOrigin + Imath::V2i( GafferImage::ImagePlug::tileSize() ) );
 	Imath::Box2i bound = IECore::boxIntersection( tileBound, dataWindow );
 
+	if( empty( bound ) )
+	{
+		return ImagePlug::blackTile();
+	}
+
+	// We can't simply reference the channel storage, even for images
+	// which happen to be a single aligned tile, because our rows are
+	// ordered bottom to top, and the ImagePrimitive's top to bottom.
+	// But since our outputs aren't cached, a pooled buffer will be
+	// recycled as soon as the caller is done with it, so we avoid
+	// allocating a new tile every time.
+	IECore::FloatVectorDataPtr resultData = ImagePlug::tileBuffer();
+	std::vector<float> &result = resultData->writable();
+	if( bound != tileBound )
+	{
+		std::fill( result.begin(), result.end(), 0.0f );
+	}
+
+	const size_t width = bound.size().x;
 	for( int y = bound.min.y; y<bound.max.y; y++ )
 	{
-		size_t srcIndex = ( format.toEXRSpace( y ) - exrDataWindow.min.y ) * dataWindow.size().x + bound.min.x - exrDataWindow.min.x;
-		size_t dstIndex = ( y - tileBound.min.y ) * GafferImage::ImagePlug::tileSize() + bound.min.x - tileBound.min.x;
-		const size_t srcEndIndex = srcIndex + bound.size().x;
-		while( srcIndex < srcEndIndex )
-		{
-			result[dstIndex++] = channel[srcIndex++];
-		}
+		const size_t srcIndex = ( format.toEXRSpace( y ) - exrDataWindow.min.y ) * dataWindow.size().x + bound.min.x - exrDataWindow.min.x;
+		const size_t dstIndex = ( y - tileBound.min.y ) * GafferImage::ImagePlug::tileSize() + bound.min.x - tileBound.min.x;
+		std::copy( channel.begin() + srcIndex, channel.begin() + srcIndex + width, result.begin() + dstIndex );
 	}
 
 	return resultData;
@@ -95,6 +95,14 @@ class Sampler
 		/// 0.5, 0.5.
 		inline float sample( float x, float y );
 
+		/// Fills `buffer` with the channel values for the pixels
+		/// from `xBegin` (inclusive) to `xEnd` (exclusive) in row `y`.
+		/// This is equivalent to calling sample( x, y ) for each pixel,
+		/// but is considerably faster as spans are copied directly from
+		/// the underlying tiles. It is the caller's responsibility to
+		/// ensure that the row is contained within the sample window.
+		void sampleRow( int y, int xBegin, int xEnd, float *buffer );
+
 		/// Appends a hash that represent all the pixel
 		/// values within the requested sample area.
 		void hash( IECore::MurmurHash &h ) const;
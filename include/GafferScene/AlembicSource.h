@@ -73,6 +73,20 @@ class AlembicSource : public SceneNode
 		/// Implemented to specify that fileNamePlug() affects all the scene output.
 		virtual void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const;
 
+		/// @name Cache management
+		/// The AlembicInputs for individual locations are cached, and shared
+		/// between all AlembicSources reading the same file. These functions
+		/// allow for management of the cache.
+		////////////////////////////////////////////////////////////////////
+		//@{
+		/// Returns the maximum number of locations to hold in the cache.
+		static size_t getInputCacheLimit();
+		/// Sets the maximum number of locations to hold in the cache.
+		static void setInputCacheLimit( size_t numLocations );
+		/// Returns the number of locations currently held in the cache.
+		static size_t inputCacheUsage();
+		//@}
+
 	private :
 
 		void plugSet( Gaffer::Plug *plug );
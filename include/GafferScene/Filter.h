@@ -90,6 +90,21 @@ class Filter : public Gaffer::ComputeNode
 		/// The name of the variable used to specify the input scene.
 		static const IECore::InternedString inputSceneContextName;
 
+		/// @name Batched queries
+		/// These methods compute the match for every child of a location in a
+		/// single call. The results are identical to those obtained by evaluating
+		/// outPlug() once per child with the "scene:path" variable set accordingly,
+		/// but avoid the per-child overhead when a location has very many children.
+		/// The input scene must have been specified in the current context using
+		/// setInputScene().
+		////////////////////////////////////////////////////////////////////
+		//@{
+		/// Fills `results` with one Result per child.
+		void childMatches( const std::vector<IECore::InternedString> &parent, const std::vector<IECore::InternedString> &childNames, std::vector<unsigned> &results ) const;
+		/// Returns a hash uniquely identifying the results of childMatches().
+		IECore::MurmurHash childMatchesHash( const std::vector<IECore::InternedString> &parent, const std::vector<IECore::InternedString> &childNames ) const;
+		//@}
+
 	protected :
 
 		/// Implemented to call hashMatch() below when computing the hash for outPlug().
@@ -117,6 +132,12 @@ class Filter : public Gaffer::ComputeNode
 		/// an input connection must be made into outPlug(), so that the method is not called.
 		virtual unsigned computeMatch( const ScenePlug *scene, const Gaffer::Context *context ) const;
 
+		/// May be implemented by derived classes to accelerate childMatches(). Implementations
+		/// must be consistent with hashMatch() and computeMatch(). The default implementations
+		/// evaluate outPlug() in parallel for each child.
+		virtual void hashChildMatches( const ScenePlug *scene, const std::vector<IECore::InternedString> &parent, const std::vector<IECore::InternedString> &childNames, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		virtual void computeChildMatches( const ScenePlug *scene, const std::vector<IECore::InternedString> &parent, const std::vector<IECore::InternedString> &childNames, const Gaffer::Context *context, std::vector<unsigned> &results ) const;
+
 	private :
 
 		static size_t g_firstPlugIndex;
@@ -79,6 +79,12 @@ class FilteredSceneProcessor : public SceneProcessor
 		/// Note that if you need to make multiple queries, it is more efficient to call
 		/// filterContext() yourself once and then query the filter directly multiple times.
 		Filter::Result filterValue( const Gaffer::Context *context ) const;
+		/// Convenience methods for querying the filter for all the children of
+		/// `path` at once. When the filter is provided directly by a Filter node,
+		/// these use Filter::childMatches(), which is significantly faster than
+		/// querying each child in turn.
+		void childFilterHash( const ScenePath &path, const std::vector<IECore::InternedString> &childNames, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		void childFilterValues( const ScenePath &path, const std::vector<IECore::InternedString> &childNames, const Gaffer::Context *context, std::vector<unsigned> &results ) const;
 
 		static size_t g_firstPlugIndex;
 
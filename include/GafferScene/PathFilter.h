@@ -69,6 +69,10 @@ class PathFilter : public Filter
 		virtual void hashMatch( const ScenePlug *scene, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		virtual unsigned computeMatch( const ScenePlug *scene, const Gaffer::Context *context ) const;
 
+		/// Implemented to query the PathMatcher directly, avoiding per-child graph evaluations.
+		virtual void hashChildMatches( const ScenePlug *scene, const std::vector<IECore::InternedString> &parent, const std::vector<IECore::InternedString> &childNames, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		virtual void computeChildMatches( const ScenePlug *scene, const std::vector<IECore::InternedString> &parent, const std::vector<IECore::InternedString> &childNames, const Gaffer::Context *context, std::vector<unsigned> &results ) const;
+
 	private :
 
 		// Filter matches are computed using a PathMatcher data structure in one of two ways:
@@ -76,13 +76,23 @@ class RenderSets : boost::noncopyable
 		};
 
 		/// Returns a bitmask describing which sets
-		/// changed.
+		/// changed. Only sets whose hash has changed
+		/// are recomputed.
 		unsigned update( const ScenePlug *scene );
 		void clear();
 
 		const PathMatcher &camerasSet() const;
 		const PathMatcher &lightsSet() const;
 
+		/// Return the paths which entered or left the
+		/// respective sets during the last call to update().
+		const PathMatcher &camerasSetChanges() const;
+		const PathMatcher &lightsSetChanges() const;
+		/// Returns the union of the changes to all the
+		/// "render:" sets, including the paths of any sets
+		/// which were added or removed entirely.
+		const PathMatcher &renderSetsChanges() const;
+
 		IECore::ConstInternedStringVectorDataPtr setsAttribute( const std::vector<IECore::InternedString> &path ) const;
 
 	private :
@@ -92,6 +102,7 @@ class RenderSets : boost::noncopyable
 			IECore::InternedString unprefixedName; // With "render:" stripped off
 			IECore::MurmurHash hash;
 			PathMatcher set;
+			PathMatcher changes; // Paths which entered or left the set in the last update
 		};
 
 		typedef boost::container::flat_map<IECore::InternedString, Set> Sets;
@@ -102,6 +113,7 @@ class RenderSets : boost::noncopyable
 		Sets m_sets;
 		Set m_camerasSet;
 		Set m_lightsSet;
+		PathMatcher m_renderSetsChanges;
 
 };
 
@@ -0,0 +1,145 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERSCENE_PRIVATE_CHILDNAMESMAP_H
+#define GAFFERSCENE_PRIVATE_CHILDNAMESMAP_H
+
+#include "boost/unordered_map.hpp"
+
+#include "IECore/TypedData.h"
+#include "IECore/VectorTypedData.h"
+
+namespace GafferScene
+{
+
+namespace Private
+{
+
+/// Maps the child names of several input locations onto the
+/// uniquified child names of a single output location, as needed
+/// by nodes such as Group and BranchCreator. Clashing names are
+/// made unique by incrementing a numeric suffix.
+class ChildNamesMap
+{
+
+	public :
+
+		struct Input
+		{
+
+			Input( const IECore::InternedString &name = IECore::InternedString(), size_t index = 0 )
+				:	name( name ), index( index )
+			{
+			}
+
+			bool operator == ( const Input &rhs ) const
+			{
+				return name == rhs.name && index == rhs.index;
+			}
+
+			/// The child name in the input.
+			IECore::InternedString name;
+			/// The index of the input it came from.
+			size_t index;
+
+		};
+
+		/// Constructs an empty map.
+		ChildNamesMap();
+		/// Constructs a map by merging the child names of all the inputs,
+		/// in order.
+		ChildNamesMap( const std::vector<IECore::ConstInternedStringVectorDataPtr> &inputChildNames );
+
+		/// Returns the merged child names.
+		const IECore::InternedStringVectorData *outputChildNames() const;
+
+		/// Returns the input corresponding to the specified output name,
+		/// or 0 if no such output name exists.
+		const Input *input( const IECore::InternedString &outputName ) const;
+		/// Returns the output name corresponding to the specified input,
+		/// throwing if the input doesn't exist.
+		const IECore::InternedString &outputName( const Input &input ) const;
+
+		bool operator == ( const ChildNamesMap &rhs ) const;
+
+		void hash( IECore::MurmurHash &h ) const;
+
+	private :
+
+		struct InternedStringHash
+		{
+			size_t operator()( const IECore::InternedString &s ) const;
+		};
+
+		struct InputHash
+		{
+			size_t operator()( const Input &input ) const;
+		};
+
+		typedef boost::unordered_map<IECore::InternedString, Input, InternedStringHash> InputMap;
+		typedef boost::unordered_map<Input, IECore::InternedString, InputHash> OutputMap;
+
+		IECore::InternedStringVectorDataPtr m_outputChildNames;
+		InputMap m_inputs;
+		OutputMap m_renamedOutputs;
+
+};
+
+} // namespace Private
+
+} // namespace GafferScene
+
+namespace IECore
+{
+
+IECORE_DECLARE_TYPEDDATA( ChildNamesMapData, GafferScene::Private::ChildNamesMap, void, SharedDataHolder )
+
+} // namespace IECore
+
+namespace GafferScene
+{
+
+namespace Private
+{
+
+typedef IECore::ChildNamesMapData ChildNamesMapData;
+IE_CORE_DECLAREPTR( ChildNamesMapData );
+
+} // namespace Private
+
+} // namespace GafferScene
+
+#endif // GAFFERSCENE_PRIVATE_CHILDNAMESMAP_H
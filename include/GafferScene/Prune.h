@@ -68,6 +68,7 @@ class Prune : public FilteredSceneProcessor
 		virtual Imath::Box3f computeBound( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const;
 		virtual IECore::ConstInternedStringVectorDataPtr computeChildNames( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const;
 		virtual GafferScene::ConstPathMatcherDataPtr computeSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent ) const;
+		virtual unsigned computeSetMatch( const IECore::InternedString &setName, const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const;
 
 	private :
 
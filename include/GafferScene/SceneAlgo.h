@@ -102,6 +102,22 @@ Imath::V2f shutter( const IECore::CompoundObject *globals );
 /// location if motionBlur is true.
 IECore::TransformPtr transform( const ScenePlug *scene, const ScenePlug::ScenePath &path, const Imath::V2f &shutter, bool motionBlur );
 
+/// Motion sampling
+/// ===============
+///
+/// These functions evaluate a location at several times in a single call,
+/// reusing a single context for all the samples. Identical samples (as
+/// produced when nothing upstream is animated) are computed only once, and
+/// share the same value.
+
+/// Fills `samples` with the local transform at `path` for each of the specified times.
+void transformSamples( const ScenePlug *scene, const ScenePlug::ScenePath &path, const std::vector<float> &times, std::vector<Imath::M44f> &samples );
+/// As above, but returning the full (world) transform.
+void fullTransformSamples( const ScenePlug *scene, const ScenePlug::ScenePath &path, const std::vector<float> &times, std::vector<Imath::M44f> &samples );
+/// Fills `samples` with the object at `path` for each of the specified times. If
+/// `hashes` is passed, it is filled with the hash of each sample.
+void objectSamples( const ScenePlug *scene, const ScenePlug::ScenePath &path, const std::vector<float> &times, std::vector<IECore::ConstObjectPtr> &samples, std::vector<IECore::MurmurHash> *hashes = NULL );
+
 /// Returns the primary render camera, with all globals settings such as
 /// crop, resolution, overscan etc applied as they would be for rendering.
 /// The globals may be passed if they are available, if not they will be computed.
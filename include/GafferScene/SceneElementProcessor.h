@@ -104,6 +104,15 @@ class SceneElementProcessor : public FilteredSceneProcessor
 		virtual bool processesAttributes() const;
 		virtual void hashProcessedAttributes( const ScenePath &path, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		virtual IECore::ConstCompoundObjectPtr computeProcessedAttributes( const ScenePath &path, const Gaffer::Context *context, IECore::ConstCompoundObjectPtr inputAttributes ) const;
+		/// Utility for implementing computeProcessedAttributes(). Returns the result of
+		/// adding the members of newAttributes to inputAttributes, replacing any existing
+		/// members of the same name. Members are shared rather than copied, and where
+		/// possible no new map is made at all : if inputAttributes is empty then
+		/// newAttributes is returned directly, and if every new member is already present
+		/// in inputAttributes (the very same object, not merely an equal one) then
+		/// inputAttributes is returned. This allows long chains of attribute nodes
+		/// to share results rather than each storing a copy in the compute cache.
+		static IECore::ConstCompoundObjectPtr mergeAttributes( IECore::ConstCompoundObjectPtr inputAttributes, IECore::ConstCompoundObjectPtr newAttributes );
 
 		/// Note that if you implement processesObject() in such a way as to deform the object, you /must/ also
 		/// implement processesBound() appropriately.
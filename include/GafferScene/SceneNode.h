@@ -69,6 +69,9 @@ class SceneNode : public Gaffer::ComputeNode
 
 		/// Implemented so that enabledPlug() affects outPlug().
 		virtual void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const;
+		/// Implemented to declare that the globals, set names and sets
+		/// never depend on the "scene:path" context variable.
+		virtual const std::vector<IECore::InternedString> *ignoredContextVariables( const Gaffer::ValuePlug *output ) const;
 
 	protected :
 
@@ -119,6 +122,13 @@ class SceneNode : public Gaffer::ComputeNode
 		/// it, and that makes computation quicker, as we don't need to access setNamesPlug() at all in many common cases.
 		virtual GafferScene::ConstPathMatcherDataPtr computeSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent ) const;
 
+		/// Returns the Filter::Result for a single path within a set, as queried via
+		/// ScenePlug::setMatch(). The default implementation computes the whole set
+		/// and matches against it, but derived classes may override this to answer
+		/// hierarchically from their inputs when that is cheaper. Implementations must
+		/// be consistent with computeSet(), and are only called when the node is enabled.
+		virtual unsigned computeSetMatch( const IECore::InternedString &setName, const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const;
+
 		/// Convenience function to compute the correct bounding box for a path from the bounding box and transforms of its
 		/// children. Using this from computeBound() should be a last resort, as it implies peeking inside children to determine
 		/// information about the parent - the last thing we want to be doing when defining large scenes procedurally. If
@@ -130,6 +140,11 @@ class SceneNode : public Gaffer::ComputeNode
 
 	private :
 
+		friend class ScenePlug;
+
+		// Called by ScenePlug::setMatch() to dispatch to computeSetMatch().
+		unsigned setMatch( const IECore::InternedString &setName, const ScenePath &path, const ScenePlug *parent ) const;
+
 		static size_t g_firstPlugIndex;
 
 };
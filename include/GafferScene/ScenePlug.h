@@ -155,6 +155,13 @@ class ScenePlug : public Gaffer::ValuePlug
 		/// lead to poor cache performance.
 		IECore::ConstInternedStringVectorDataPtr setNames() const;
 		ConstPathMatcherDataPtr set( const IECore::InternedString &setName ) const;
+		/// Returns the Filter::Result for `scenePath` within the named set,
+		/// equivalent to `set( setName )->readable().match( scenePath )`.
+		/// Nodes which are able to answer this query hierarchically will do
+		/// so without computing the whole set, so this should be preferred
+		/// when only a few locations are of interest. The result is covered
+		/// by `setHash( setName )`.
+		unsigned setMatch( const IECore::InternedString &setName, const ScenePath &scenePath ) const;
 
 		IECore::MurmurHash boundHash( const ScenePath &scenePath ) const;
 		IECore::MurmurHash transformHash( const ScenePath &scenePath ) const;
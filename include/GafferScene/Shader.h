@@ -44,8 +44,9 @@
 #include "IECore/Shader.h"
 #include "IECore/CompoundObject.h"
 
-#include "Gaffer/DependencyNode.h"
+#include "Gaffer/ComputeNode.h"
 #include "Gaffer/TypedPlug.h"
+#include "Gaffer/TypedObjectPlug.h"
 #include "Gaffer/CompoundNumericPlug.h"
 
 #include "GafferScene/TypeIds.h"
@@ -60,7 +61,7 @@ IE_CORE_FORWARDDECLARE( StringPlug )
 namespace GafferScene
 {
 
-class Shader : public Gaffer::DependencyNode
+class Shader : public Gaffer::ComputeNode
 {
 
 	public :
@@ -68,7 +69,7 @@ class Shader : public Gaffer::DependencyNode
 		Shader( const std::string &name=defaultName<Shader>() );
 		virtual ~Shader();
 
-		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( GafferScene::Shader, ShaderTypeId, Gaffer::DependencyNode );
+		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( GafferScene::Shader, ShaderTypeId, Gaffer::ComputeNode );
 
 		/// A plug defining the name of the shader.
 		Gaffer::StringPlug *namePlug();
@@ -122,6 +123,13 @@ class Shader : public Gaffer::DependencyNode
 
 	protected :
 
+		/// The shader network is built in compute() and stored on private
+		/// output plugs, so that it is only built once per unique network
+		/// hash, regardless of how many ShaderAssignments and locations
+		/// use it. All other outputs retain their default values.
+		virtual void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		virtual void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const;
+
 		class NetworkBuilder
 		{
 
@@ -196,6 +204,13 @@ class Shader : public Gaffer::DependencyNode
 		Gaffer::Color3fPlug *nodeColorPlug();
 		const Gaffer::Color3fPlug *nodeColorPlug() const;
 
+		// Cached results of NetworkBuilder::state(), and of wrapping
+		// that state up as attributes.
+		Gaffer::ObjectVectorPlug *outStatePlug();
+		const Gaffer::ObjectVectorPlug *outStatePlug() const;
+		Gaffer::CompoundObjectPlug *outAttributesPlug();
+		const Gaffer::CompoundObjectPlug *outAttributesPlug() const;
+
 		static size_t g_firstPlugIndex;
 
 };
@@ -44,6 +44,10 @@
 namespace GafferScene
 {
 
+/// Assigns a shader network to the filtered locations. Unless the network
+/// is driven by nodes that might read the "scene:path" context variable, it
+/// is evaluated without that variable, so a single network is shared by all
+/// locations, and is hashed and built only once.
 class ShaderAssignment : public SceneElementProcessor
 {
 
@@ -67,6 +71,10 @@ class ShaderAssignment : public SceneElementProcessor
 
 	private :
 
+		void plugDirtied( const Gaffer::Plug *plug );
+
+		bool m_shaderVariesWithContext;
+
 		static size_t g_firstPlugIndex;
 
 };
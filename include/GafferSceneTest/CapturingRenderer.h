@@ -0,0 +1,94 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERSCENETEST_CAPTURINGRENDERER_H
+#define GAFFERSCENETEST_CAPTURINGRENDERER_H
+
+#include "GafferScene/Private/IECoreScenePreview/Renderer.h"
+
+namespace GafferSceneTest
+{
+
+/// A renderer which doesn't render anything, but instead counts the
+/// calls made to it. It is registered with the type name "Capturing",
+/// and is useful for testing the efficiency of interactive updates.
+class CapturingRenderer : public IECoreScenePreview::Renderer
+{
+
+	public :
+
+		CapturingRenderer( RenderType renderType = Interactive, const std::string &fileName = "" );
+		virtual ~CapturingRenderer();
+
+		struct Statistics
+		{
+			Statistics();
+			/// Number of calls to `attributes()`.
+			size_t attributesCreated;
+			/// Number of calls to `camera()`, `light()` and `object()`.
+			size_t objectsCreated;
+			/// Number of calls to `ObjectInterface::attributes()`.
+			size_t attributeEdits;
+			/// Number of calls to `ObjectInterface::transform()`.
+			size_t transformEdits;
+		};
+
+		/// Returns the statistics accumulated by all instances
+		/// since the last call to `resetStatistics()`.
+		static Statistics statistics();
+		static void resetStatistics();
+
+		virtual void option( const IECore::InternedString &name, const IECore::Data *value );
+		virtual void output( const IECore::InternedString &name, const Output *output );
+		virtual AttributesInterfacePtr attributes( const IECore::CompoundObject *attributes );
+		virtual ObjectInterfacePtr camera( const std::string &name, const IECore::Camera *camera, const AttributesInterface *attributes );
+		virtual ObjectInterfacePtr light( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes );
+		virtual ObjectInterfacePtr object( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes );
+		virtual ObjectInterfacePtr object( const std::string &name, const std::vector<const IECore::Object *> &samples, const std::vector<float> &times, const AttributesInterface *attributes );
+		virtual void render();
+		virtual void pause();
+
+	private :
+
+		static TypeDescription<CapturingRenderer> g_typeDescription;
+
+};
+
+IE_CORE_DECLAREPTR( CapturingRenderer )
+
+} // namespace GafferSceneTest
+
+#endif // GAFFERSCENETEST_CAPTURINGRENDERER_H
@@ -0,0 +1,88 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERSCENEUI_FRUSTUMCULLER_H
+#define GAFFERSCENEUI_FRUSTUMCULLER_H
+
+#include "OpenEXR/ImathBox.h"
+#include "OpenEXR/ImathMatrix.h"
+
+namespace GafferSceneUI
+{
+
+/// Classifies bounding boxes against a view frustum, so that the
+/// SceneGadget can avoid drawing things which are off screen, and
+/// draw a simple stand-in for things which are too small to see. The
+/// culler has no OpenGL dependencies, so it can be used and tested
+/// without a GL context.
+class FrustumCuller
+{
+
+	public :
+
+		enum Visibility
+		{
+			/// Entirely outside the frustum.
+			Culled,
+			/// Inside the frustum, but smaller than the minimum screen size.
+			StandIn,
+			/// Partially inside the frustum.
+			Intersecting,
+			/// Entirely inside the frustum.
+			Contained
+		};
+
+		/// The viewport size is measured in pixels, as is the minimum
+		/// screen size for anything which isn't to be drawn as a stand-in.
+		/// A minimum size of 0 disables stand-ins.
+		FrustumCuller( const Imath::V2i &viewportSize, float minimumScreenSize );
+
+		/// Returns the visibility of the bound, which is specified in a space
+		/// defined by the objectToClip matrix. If the bound is known to be
+		/// inside a parent bound which was Contained, then parentContained
+		/// may be passed to skip the frustum tests.
+		Visibility visibility( const Imath::Box3f &bound, const Imath::M44f &objectToClip, bool parentContained = false ) const;
+
+	private :
+
+		Imath::V2f m_viewportSize;
+		float m_minimumScreenSize;
+
+};
+
+} // namespace GafferSceneUI
+
+#endif // GAFFERSCENEUI_FRUSTUMCULLER_H
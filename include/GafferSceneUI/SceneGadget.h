@@ -37,6 +37,8 @@
 #ifndef GAFFERSCENEUI_SCENEGADGET_H
 #define GAFFERSCENEUI_SCENEGADGET_H
 
+#include "OpenEXR/ImathPlane.h"
+
 #include "IECoreGL/State.h"
 
 #include "Gaffer/Context.h"
@@ -84,6 +86,13 @@ class SceneGadget : public GafferUI::Gadget
 		void setMinimumExpansionDepth( size_t depth );
 		size_t getMinimumExpansionDepth() const;
 
+		/// Locations which are smaller than this size on screen (measured
+		/// in pixels) are drawn as a simple bounding box. Locations outside
+		/// the view are not drawn at all. A size of 0 disables the bounding
+		/// box stand-ins.
+		void setMinimumScreenSize( float pixels );
+		float getMinimumScreenSize() const;
+
 		/// Returns the IECoreGL::State object used as the base display
 		/// style for the Renderable. This may be modified freely to
 		/// change the display style.
@@ -91,7 +100,9 @@ class SceneGadget : public GafferUI::Gadget
 
 		/// Finds the path of the frontmost object intersecting the specified line
 		/// through gadget space. Returns true on success and false if there is no
-		/// such object.
+		/// such object. Queries are answered on the CPU using a bounding volume
+		/// hierarchy where possible, falling back to OpenGL selection for objects
+		/// which can't be intersected exactly.
 		bool objectAt( const IECore::LineSegment3f &lineInGadgetSpace, GafferScene::ScenePlug::ScenePath &path ) const;
 		/// Fills paths with all objects intersected by a rectangle in screen space,
 		/// defined by two corners in gadget space (as required for drag selection).
@@ -131,12 +142,21 @@ class SceneGadget : public GafferUI::Gadget
 		mutable unsigned m_dirtyFlags;
 		GafferScene::ConstPathMatcherDataPtr m_expandedPaths;
 		size_t m_minimumExpansionDepth;
+		float m_minimumScreenSize;
 
 		class SceneGraph;
 		class UpdateTask;
+		class PickIndex;
+
+		const PickIndex *pickIndex() const;
+		// Computes the frustum, with inward facing planes, which projects
+		// onto the screen rectangle between the two corners. Returns false
+		// if it can't be computed.
+		bool selectionFrustum( const Imath::V3f &corner0InGadgetSpace, const Imath::V3f &corner1InGadgetSpace, std::vector<Imath::Plane3f> &frustum ) const;
 
 		IECoreGL::StatePtr m_baseState;
 		boost::shared_ptr<SceneGraph> m_sceneGraph;
+		mutable boost::shared_ptr<PickIndex> m_pickIndex;
 
 		GafferScene::ConstPathMatcherDataPtr m_selection;
 
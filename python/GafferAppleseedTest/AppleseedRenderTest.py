@@ -110,6 +110,43 @@ class AppleseedRenderTest( GafferTest.TestCase ) :
 
 		self.failUnless( os.path.exists( self.temporaryDirectory() + "/test.exr" ) )
 
+	def testDuplicatedGeometry( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["plane"] = GafferScene.Plane()
+
+		s["duplicate"] = GafferScene.Duplicate()
+		s["duplicate"]["in"].setInput( s["plane"]["out"] )
+		s["duplicate"]["target"].setValue( "/plane" )
+		s["duplicate"]["copies"].setValue( 10 )
+		s["duplicate"]["transform"]["translate"]["x"].setValue( 1 )
+
+		s["outputs"] = GafferScene.Outputs()
+		s["outputs"].addOutput(
+			"beauty",
+			IECore.Display(
+				self.temporaryDirectory() + "/test.exr",
+				"exr",
+				"rgba",
+				{}
+			)
+		)
+		s["outputs"]["in"].setInput( s["duplicate"]["out"] )
+
+		s["render"] = GafferAppleseed.AppleseedRender()
+		s["render"]["in"].setInput( s["outputs"]["out"] )
+		s["render"]["fileName"].setValue( self.temporaryDirectory() + "/test.appleseed" )
+
+		s["fileName"].setValue( self.__scriptFileName )
+		s.save()
+
+		# The copies share a single appleseed object, with
+		# an object instance per location.
+		s["render"]["task"].execute()
+
+		self.failUnless( os.path.exists( self.temporaryDirectory() + "/test.exr" ) )
+
 	def testExecuteWithStringSubstitutions( self ) :
 
 		s = Gaffer.ScriptNode()
@@ -1381,5 +1381,92 @@ class DispatcherTest( GafferTest.TestCase ) :
 		d.dispatch( [ lastTask ] )
 		self.assertLess( time.clock() - t, 4 )
 
+	def testSharedTasksAreQueriedOnce( self ) :
+
+		class CountingTaskNode( GafferDispatchTest.LoggingTaskNode ) :
+
+			def __init__( self, name = "CountingTaskNode" ) :
+
+				GafferDispatchTest.LoggingTaskNode.__init__( self, name )
+
+				self.hashCount = 0
+				self.preTasksCount = 0
+
+			def hash( self, context ) :
+
+				self.hashCount += 1
+				return GafferDispatchTest.LoggingTaskNode.hash( self, context )
+
+			def preTasks( self, context ) :
+
+				self.preTasksCount += 1
+				return GafferDispatchTest.LoggingTaskNode.preTasks( self, context )
+
+		IECore.registerRunTimeTyped( CountingTaskNode )
+
+		# A lattice of diamonds like this :
+		#
+		#     a0
+		#    /  \
+		#   a1  b1
+		#   | \/ |
+		#   | /\ |
+		#   a2  b2
+		#   ...
+		#
+		# Has 2^n paths from the bottom to the top,
+		# but each task should only be queried once.
+
+		s = Gaffer.ScriptNode()
+		s["a0"] = CountingTaskNode()
+
+		for i in range( 1, 12 ) :
+			for n in ( "a", "b" ) :
+				node = CountingTaskNode()
+				node["preTasks"][0].setInput( s["a%d" % ( i - 1 )]["task"] )
+				if i > 1 :
+					node["preTasks"][1].setInput( s["b%d" % ( i - 1 )]["task"] )
+				s["%s%d" % ( n, i )] = node
+
+		dispatcher = GafferDispatch.Dispatcher.create( "testDispatcher" )
+		dispatcher.dispatch( [ s["a11"], s["b11"] ] )
+
+		for node in s.children( CountingTaskNode ) :
+			self.assertEqual( len( node.log ), 1 )
+			self.assertEqual( node.hashCount, 1 )
+			self.assertEqual( node.preTasksCount, 1 )
+
+	def testWedgePerformance( self ) :
+
+		# A chain of tasks wedged over many values
+		# and frames, as a benchmark for the construction
+		# of large task graphs. Uncomment the timer to get
+		# useful information printed out.
+
+		s = Gaffer.ScriptNode()
+
+		lastTask = None
+		for i in range( 0, 10 ) :
+			node = GafferDispatchTest.LoggingTaskNode()
+			node["v"] = Gaffer.StringPlug( defaultValue = "${wedge:value}.####" )
+			if lastTask is not None :
+				node["preTasks"][0].setInput( lastTask["task"] )
+			s["task%d" % i] = node
+			lastTask = node
+
+		s["wedge"] = GafferDispatch.Wedge()
+		s["wedge"]["mode"].setValue( int( s["wedge"].Mode.IntRange ) )
+		s["wedge"]["intMin"].setValue( 1 )
+		s["wedge"]["intMax"].setValue( 20 )
+		s["wedge"]["preTasks"][0].setInput( lastTask["task"] )
+
+		d = self.NullDispatcher()
+		d["framesMode"].setValue( d.FramesMode.CustomRange )
+		d["frameRange"].setValue( "1-20" )
+
+		t = IECore.Timer()
+		d.dispatch( [ s["wedge"] ] )
+		# print t.stop()
+
 if __name__ == "__main__":
 	unittest.main()
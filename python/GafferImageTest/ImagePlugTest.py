@@ -149,5 +149,35 @@ class ImagePlugTest( GafferImageTest.ImageTestCase ) :
 			GafferImage.FormatPlug.setDefaultFormat( c, GafferImage.Format( 200, 300 ) )
 			self.assertEqual( constant["out"].image().displayWindow, IECore.Box2i( IECore.V2i( 0 ), IECore.V2i( 199, 299 ) ) )
 
+	def testTileBufferReuse( self ) :
+
+		constant = GafferImage.Constant()
+
+		def computeTiles( offset ) :
+
+			for i in range( 0, 10 ) :
+				constant["color"]["r"].setValue( offset + i )
+				constant["out"].channelData( "R", IECore.V2i( 0 ), _copy = False )
+
+		def clearCache() :
+
+			limit = Gaffer.ValuePlug.getCacheMemoryLimit()
+			Gaffer.ValuePlug.setCacheMemoryLimit( 0 )
+			Gaffer.ValuePlug.setCacheMemoryLimit( limit )
+
+		clearCache()
+		computeTiles( 0 )
+
+		# Once the tiles have been evicted from the cache, their
+		# buffers should be recycled rather than new ones allocated.
+
+		clearCache()
+		before = GafferImage.ImagePlug.tileBufferStatistics()
+		computeTiles( 10 )
+		after = GafferImage.ImagePlug.tileBufferStatistics()
+
+		self.assertEqual( after.allocationCount, before.allocationCount )
+		self.assertEqual( after.reuseCount, before.reuseCount + 10 )
+
 if __name__ == "__main__":
 	unittest.main()
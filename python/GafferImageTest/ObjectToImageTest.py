@@ -81,5 +81,24 @@ class ObjectToImageTest( GafferImageTest.ImageTestCase ) :
 			n["out"].channelDataHash( "R", IECore.V2i( GafferImage.ImagePlug.tileSize() ) )
 		)
 
+	def testTileBuffersAreReused( self ) :
+
+		n = GafferImage.ObjectToImage()
+		n["object"].setValue( IECore.Reader.create( self.fileName ).read() )
+
+		tileOrigin = GafferImage.ImagePlug.tileOrigin( n["out"]["dataWindow"].getValue().min )
+		n["out"].channelData( "R", tileOrigin )
+
+		# Our tiles aren't cached, so once one has been released its
+		# buffer should be recycled for the next.
+
+		before = GafferImage.ImagePlug.tileBufferStatistics()
+		for i in range( 0, 10 ) :
+			n["out"].channelData( "R", tileOrigin )
+		after = GafferImage.ImagePlug.tileBufferStatistics()
+
+		self.assertEqual( after.allocationCount, before.allocationCount )
+		self.assertEqual( after.reuseCount, before.reuseCount + 10 )
+
 if __name__ == "__main__":
 	unittest.main()
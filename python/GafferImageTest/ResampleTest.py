@@ -177,5 +177,28 @@ class ResampleTest( GafferImageTest.ImageTestCase ) :
 		r["filterWidth"].setValue( IECore.V2f( 10 ) )
 		self.assertEqual( r["out"]["dataWindow"].getValue(), IECore.Box2i( d.min - IECore.V2i( 5 ), d.max + IECore.V2i( 5 ) ) )
 
+	def testIntegerDownsizeMatchesSinglePass( self ) :
+
+		reader = GafferImage.ImageReader()
+		reader["fileName"].setValue( os.path.dirname( __file__ ) + "/images/resamplePatterns.exr" )
+		dataWindow = reader["out"]["dataWindow"].getValue()
+
+		twoPass = GafferImage.Resample()
+		twoPass["in"].setInput( reader["out"] )
+
+		singlePass = GafferImage.Resample()
+		singlePass["in"].setInput( reader["out"] )
+		singlePass["debug"].setValue( GafferImage.Resample.Debug.SinglePass )
+
+		for divisor in ( 2, 3 ) :
+			for filter in ( "box", "gaussian", "lanczos3" ) :
+				for boundingMode in ( GafferImage.Sampler.BoundingMode.Black, GafferImage.Sampler.BoundingMode.Clamp ) :
+					for r in ( twoPass, singlePass ) :
+						r["dataWindow"].setValue( IECore.Box2f( IECore.V2f( 0 ), IECore.V2f( dataWindow.size() / divisor ) ) )
+						r["filter"].setValue( filter )
+						r["boundingMode"].setValue( boundingMode )
+
+					self.assertImagesEqual( twoPass["out"], singlePass["out"], maxDifference = 0.0005 )
+
 if __name__ == "__main__":
 	unittest.main()
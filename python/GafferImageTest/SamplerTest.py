@@ -202,5 +202,24 @@ class SamplerTest( GafferImageTest.ImageTestCase ) :
 		sampler = GafferImage.Sampler( empty["out"], "R", empty["out"]["format"].getValue().getDisplayWindow(), boundingMode = GafferImage.Sampler.BoundingMode.Clamp )
 		self.assertEqual( sampler.sample( 0, 0 ), 0.0 )
 
+	def testSampleRow( self ) :
+
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.fileName )
+		dw = r["out"]["dataWindow"].getValue()
+
+		sampleWindow = IECore.Box2i( dw.min - IECore.V2i( 70 ), dw.max + IECore.V2i( 70 ) )
+		for boundingMode in ( GafferImage.Sampler.BoundingMode.Black, GafferImage.Sampler.BoundingMode.Clamp ) :
+			s = GafferImage.Sampler( r["out"], "R", sampleWindow, boundingMode )
+			for y in ( sampleWindow.min.y, dw.min.y, dw.min.y + 10, dw.max.y - 1, dw.max.y + 5 ) :
+				for xBegin, xEnd in (
+					( sampleWindow.min.x, sampleWindow.max.x ),
+					( dw.min.x + 3, dw.max.x - 100 ),
+					( sampleWindow.min.x, dw.min.x ),
+					( dw.max.x + 1, sampleWindow.max.x ),
+				) :
+					row = s.sampleRow( y, xBegin, xEnd )
+					self.assertEqual( row, IECore.FloatVectorData( [ s.sample( x, y ) for x in range( xBegin, xEnd ) ] ) )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -151,5 +151,63 @@ class AlembicSourceTest( GafferSceneTest.SceneTestCase ) :
 
 		self.assertRaises( RuntimeError, a["out"].childNames, "/" )
 
+	def testDeepLocationsResolvedBeforeParents( self ) :
+
+		fileName = os.path.dirname( __file__ ) + "/alembicFiles/cube.abc"
+
+		a = GafferScene.AlembicSource()
+		a["fileName"].setValue( fileName )
+		a["refreshCount"].setValue( self.uniqueInt( fileName ) )
+
+		# Access the leaf first, so that its ancestors must be
+		# resolved on demand rather than already being indexed.
+		self.assertTrue( isinstance( a["out"].object( "/group1/pCube1/pCubeShape1" ), IECore.MeshPrimitive ) )
+		self.assertEqual( a["out"].transform( "/group1/pCube1" ), IECore.M44f.createTranslated( IECore.V3f( -1, 0, 0 ) ) )
+		self.assertEqual( a["out"].childNames( "/group1" ), IECore.InternedStringVectorData( [ "pCube1"] ) )
+
+		# A second node reading the same file shares the index.
+		b = GafferScene.AlembicSource()
+		b["fileName"].setValue( fileName )
+		self.assertScenesEqual( a["out"], b["out"] )
+
+	def testInputCache( self ) :
+
+		fileName = os.path.dirname( __file__ ) + "/alembicFiles/cube.abc"
+
+		limit = GafferScene.AlembicSource.getInputCacheLimit()
+		self.addCleanup( GafferScene.AlembicSource.setInputCacheLimit, limit )
+
+		# Setting refreshCount empties the cache, so we do it up front
+		# for all our nodes. Unique values also ensure that the inputs are
+		# needed, rather than results being reused from the compute cache.
+
+		sources = []
+		for i in range( 0, 3 ) :
+			a = GafferScene.AlembicSource()
+			a["fileName"].setValue( fileName )
+			a["refreshCount"].setValue( self.uniqueInt( fileName ) )
+			sources.append( a )
+
+		self.assertEqual( GafferScene.AlembicSource.inputCacheUsage(), 0 )
+
+		# Resolving a leaf caches it along with its ancestors.
+		self.assertTrue( isinstance( sources[0]["out"].object( "/group1/pCube1/pCubeShape1" ), IECore.MeshPrimitive ) )
+		self.assertEqual( GafferScene.AlembicSource.inputCacheUsage(), 3 )
+
+		# A second node reading the same file shares the cached inputs.
+		self.assertTrue( isinstance( sources[1]["out"].object( "/group1/pCube1/pCubeShape1" ), IECore.MeshPrimitive ) )
+		self.assertEqual( GafferScene.AlembicSource.inputCacheUsage(), 3 )
+
+		# The cache respects its limit, and we still get correct
+		# results when locations have been evicted.
+
+		GafferScene.AlembicSource.setInputCacheLimit( 1 )
+		self.assertLessEqual( GafferScene.AlembicSource.inputCacheUsage(), 1 )
+
+		self.assertEqual( sources[2]["out"].transform( "/group1/pCube1" ), IECore.M44f.createTranslated( IECore.V3f( -1, 0, 0 ) ) )
+		self.assertEqual( sources[2]["out"].childNames( "/group1/pCube1" ), IECore.InternedStringVectorData( [ "pCubeShape1" ] ) )
+		self.assertTrue( isinstance( sources[2]["out"].object( "/group1/pCube1/pCubeShape1" ), IECore.MeshPrimitive ) )
+		self.assertLessEqual( GafferScene.AlembicSource.inputCacheUsage(), 1 )
+
 if __name__ == "__main__":
 	unittest.main()
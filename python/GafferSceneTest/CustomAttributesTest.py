@@ -327,5 +327,40 @@ class CustomAttributesTest( GafferSceneTest.SceneTestCase ) :
 
 		self.assertEqual( set( s["a"].affects( p["value"] ) ), set( [ s["a"]["out"]["attributes"], s["a"]["out"]["globals"] ] ) )
 
+	def testChainsShareAttributes( self ) :
+
+		p = GafferScene.Plane()
+
+		f = GafferScene.PathFilter()
+		f["paths"].setValue( IECore.StringVectorData( [ "/plane" ] ) )
+
+		a1 = GafferScene.CustomAttributes()
+		a1["in"].setInput( p["out"] )
+		a1["filter"].setInput( f["out"] )
+		a1["attributes"].addMember( "user:a", IECore.IntData( 1 ) )
+
+		# Adding a new attribute must make a new map, but should
+		# share the existing members with the input.
+
+		a2 = GafferScene.CustomAttributes()
+		a2["in"].setInput( a1["out"] )
+		a2["filter"].setInput( f["out"] )
+		a2["attributes"].addMember( "user:b", IECore.IntData( 2 ) )
+
+		attributes1 = a1["out"].attributes( "/plane", _copy = False )
+		attributes2 = a2["out"].attributes( "/plane", _copy = False )
+		self.assertEqual( attributes2, IECore.CompoundObject( { "user:a" : IECore.IntData( 1 ), "user:b" : IECore.IntData( 2 ) } ) )
+		self.assertFalse( attributes2.isSame( attributes1 ) )
+		self.assertTrue( attributes2["user:a"].isSame( attributes1["user:a"] ) )
+
+		# Deleting nothing should pass the input straight through.
+
+		d = GafferScene.DeleteAttributes()
+		d["in"].setInput( a2["out"] )
+		d["filter"].setInput( f["out"] )
+		d["names"].setValue( "user:c" )
+
+		self.assertTrue( d["out"].attributes( "/plane", _copy = False ).isSame( attributes2 ) )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -204,5 +204,53 @@ class DuplicateTest( GafferSceneTest.SceneTestCase ) :
 		self.assertEqual( m.plugStatistics( d["out"]["setNames"] ).hashCount, 0 )
 		self.assertEqual( m.plugStatistics( d["out"]["setNames"] ).computeCount, 0 )
 
+	def testTransformWithExplicitName( self ) :
+
+		s = GafferScene.Sphere()
+		d = GafferScene.Duplicate()
+		d["in"].setInput( s["out"] )
+		d["target"].setValue( "/sphere" )
+		d["name"].setValue( "copy10" )
+		d["copies"].setValue( 5 )
+		d["transform"]["translate"].setValue( IECore.V3f( 1, 0, 0 ) )
+
+		for i in range( 0, 5 ) :
+			self.assertEqual( d["out"].transform( "/copy%d" % ( 10 + i ) ), IECore.M44f.createTranslated( IECore.V3f( 1, 0, 0 ) * ( i + 1 ) ) )
+
+	def testTransformWithRotation( self ) :
+
+		s = GafferScene.Sphere()
+		d = GafferScene.Duplicate()
+		d["in"].setInput( s["out"] )
+		d["target"].setValue( "/sphere" )
+		d["copies"].setValue( 20 )
+		d["transform"]["translate"].setValue( IECore.V3f( 1, 0, 0 ) )
+		d["transform"]["rotate"].setValue( IECore.V3f( 0, 10, 0 ) )
+
+		matrix = d["transform"].matrix()
+		expected = IECore.M44f()
+		for i in range( 1, 21 ) :
+			expected = expected * matrix
+			self.assertTrue( d["out"].transform( "/sphere%d" % i ).equalWithAbsError( expected, 0.00001 ) )
+
+	def testManyCopiesPerformance( self ) :
+
+		s = GafferScene.Sphere()
+		d = GafferScene.Duplicate()
+		d["in"].setInput( s["out"] )
+		d["target"].setValue( "/sphere" )
+		d["copies"].setValue( 10000 )
+		d["transform"]["translate"].setValue( IECore.V3f( 1, 0, 0 ) )
+
+		# Transforms used to be computed by a linear search for the copy
+		# and one matrix multiplication per preceding copy, making this
+		# quadratic in the number of copies. Increase the number of
+		# copies and uncomment the print for a more useful benchmark.
+		t = IECore.Timer()
+		GafferSceneTest.traverseScene( d["out"] )
+		# print t.stop()
+
+		self.assertEqual( d["out"].transform( "/sphere10000" ), IECore.M44f.createTranslated( IECore.V3f( 10000, 0, 0 ) ) )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -768,6 +768,33 @@ class GroupTest( GafferSceneTest.SceneTestCase ) :
 
 		self.assertEqual( s["g"]["out"].childNames( "/group" ), IECore.InternedStringVectorData( [ "plane", "sphere" ] ) )
 
+	def testManyInputsWithClashingNames( self ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["sets"].setValue( "A" )
+
+		group = GafferScene.Group()
+		for i in range( 0, 100 ) :
+			group["in"][i].setInput( sphere["out"] )
+
+		expectedNames = [ "sphere" ] + [ "sphere%d" % i for i in range( 1, 100 ) ]
+		self.assertEqual( group["out"].childNames( "/group" ), IECore.InternedStringVectorData( expectedNames ) )
+		self.assertEqual( set( group["out"].set( "A" ).value.paths() ), set( [ "/group/" + n for n in expectedNames ] ) )
+
+		for n in expectedNames :
+			self.assertEqual( group["out"].object( "/group/" + n ), sphere["out"].object( "/sphere" ) )
+
+		self.assertSceneValid( group["out"] )
+
+		# Renaming an input child must update everything downstream.
+
+		sphere["name"].setValue( "ball" )
+		expectedNames = [ "ball" ] + [ "ball%d" % i for i in range( 1, 100 ) ]
+		self.assertEqual( group["out"].childNames( "/group" ), IECore.InternedStringVectorData( expectedNames ) )
+		self.assertEqual( set( group["out"].set( "A" ).value.paths() ), set( [ "/group/" + n for n in expectedNames ] ) )
+
+		self.assertRaises( RuntimeError, group["out"].object, "/group/sphere" )
+
 	def setUp( self ) :
 
 		GafferSceneTest.SceneTestCase.setUp( self )
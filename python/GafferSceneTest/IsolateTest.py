@@ -235,6 +235,30 @@ class IsolateTest( GafferSceneTest.SceneTestCase ) :
 		lightSet = isolate["out"].set( "__lights" )
 		self.assertEqual( set( lightSet.value.paths() ), set( [ "/group/light", "/group/light1" ] ) )
 
+	def testSetMatch( self ) :
+
+		setPaths = [ "/a", "/a/b/c/d/e", "/a/b/c", "/b/c", "/f/g/h/i" ]
+		filterPaths = [ [], [ "/" ], [ "/*" ], [ "/a" ], [ "/a/b" ], [ "/a/b/c/d" ], [ "/f/g/h/..." ] ]
+		fromPaths = [ "/", "/a", "/a/b", "/f" ]
+		queryPaths = [ "/", "/a", "/a/b", "/a/b/c", "/a/b/c/d", "/a/b/c/d/e", "/a/x", "/b", "/b/c", "/f/g", "/f/g/h/i", "/z" ]
+
+		setNode = GafferScene.Set()
+		setNode["paths"].setValue( IECore.StringVectorData( setPaths ) )
+
+		pathFilter = GafferScene.PathFilter()
+
+		isolate = GafferScene.Isolate()
+		isolate["in"].setInput( setNode["out"] )
+		isolate["filter"].setInput( pathFilter["out"] )
+
+		for p in filterPaths :
+			pathFilter["paths"].setValue( IECore.StringVectorData( p ) )
+			for f in fromPaths :
+				isolate["from"].setValue( f )
+				outputSet = isolate["out"].set( "set" ).value
+				for q in queryPaths :
+					self.assertEqual( isolate["out"].setMatch( "set", q ), outputSet.match( q ) )
+
 	def testGlobalsDoNotDependOnScenePath( self ) :
 
 		pathFilter = GafferScene.PathFilter()
@@ -35,6 +35,7 @@
 ##########################################################################
 
 import os
+import math
 import unittest
 
 import IECore
@@ -124,5 +125,81 @@ class MapProjectionTest( GafferSceneTest.SceneTestCase ) :
 		h2 = map["out"].objectHash( "/group/cube" )
 		self.assertNotEqual( h, h2 )
 
+	def testProjectedValues( self ) :
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( IECore.V2i( 100 ) )
+
+		camera = GafferScene.Camera()
+		camera["transform"]["translate"].setValue( IECore.V3f( 0.1, 0.2, 2 ) )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( plane["out"] )
+		group["in"][1].setInput( camera["out"] )
+
+		map = GafferScene.MapProjection()
+		map["in"].setInput( group["out"] )
+		map["camera"].setValue( "/group/camera" )
+
+		for projection in ( "perspective", "orthographic" ) :
+
+			camera["projection"].setValue( projection )
+
+			c = group["out"].object( "/group/camera" ).copy()
+			c.addStandardParameters()
+			screenWindow = c.parameters()["screenWindow"].value
+			tanFOV = math.tan( math.radians( c.parameters()["projection:fov"].value / 2.0 ) )
+
+			objectToCamera = group["out"].fullTransform( "/group/plane" ) * group["out"].fullTransform( "/group/camera" ).inverse()
+
+			p = group["out"].object( "/group/plane" )["P"].data
+			o = map["out"].object( "/group/plane" )
+			self.assertEqual( len( o["s"].data ), len( p ) )
+			self.assertEqual( len( o["t"].data ), len( p ) )
+
+			for i in range( 0, len( p ) ) :
+				pCamera = p[i] * objectToCamera
+				x, y = pCamera.x, pCamera.y
+				if projection == "perspective" :
+					x /= pCamera.z * tanFOV
+					y /= pCamera.z * tanFOV
+				self.assertAlmostEqual( o["s"].data[i], ( x - screenWindow.min.x ) / screenWindow.size().x, 4 )
+				self.assertAlmostEqual( o["t"].data[i], ( y - screenWindow.min.y ) / screenWindow.size().y, 4 )
+
+			# Input data should be passed through untouched.
+			self.assertEqual( o["P"], group["out"].object( "/group/plane" )["P"] )
+
+	def testDegenerateScreenWindow( self ) :
+
+		plane = GafferScene.Plane()
+
+		camera = GafferScene.ObjectToScene()
+		camera["name"].setValue( "camera" )
+		camera["object"].setValue(
+			IECore.Camera(
+				parameters = {
+					"projection" : "orthographic",
+					"projection:fov" : 50.0,
+					"screenWindow" : IECore.Box2f( IECore.V2f( -1, 0 ), IECore.V2f( 1, 0 ) ),
+				}
+			)
+		)
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( plane["out"] )
+		group["in"][1].setInput( camera["out"] )
+
+		map = GafferScene.MapProjection()
+		map["in"].setInput( group["out"] )
+		map["camera"].setValue( "/group/camera" )
+
+		# A zero sized screen window maps to 0 on that axis,
+		# rather than producing infinities.
+		o = map["out"].object( "/group/plane" )
+		for t in o["t"].data :
+			self.assertEqual( t, 0 )
+		for s in o["s"].data :
+			self.assertTrue( s == s and abs( s ) < 10 )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -283,6 +283,31 @@ class ParentTest( GafferSceneTest.SceneTestCase ) :
 		self.assertEqual( p["out"]["setNames"].getValue(), IECore.InternedStringVectorData( [ "__lights" ] ) )
 		self.assertEqual( set(  p["out"].set( "__lights" ).value.paths() ), set( [ "/light", "/light1" ] ) )
 
+	def testNameUniqueificationWithNumericSuffixes( self ) :
+
+		g = GafferScene.Group()
+		g["name"].setValue( "sphere1" )
+
+		s = GafferScene.Sphere()
+		s["sets"].setValue( "A" )
+
+		p = GafferScene.Parent()
+		p["in"].setInput( g["out"] )
+		p["child"].setInput( s["out"] )
+		p["parent"].setValue( "/" )
+
+		# The existing child keeps its name and passes straight through,
+		# and the new child doesn't clash with it.
+		self.assertEqual( p["out"].childNames( "/" ), IECore.InternedStringVectorData( [ "sphere1", "sphere" ] ) )
+
+		s["name"].setValue( "sphere1" )
+		self.assertEqual( p["out"].childNames( "/" ), IECore.InternedStringVectorData( [ "sphere1", "sphere2" ] ) )
+		self.assertEqual( p["out"].object( "/sphere1" ), IECore.NullObject() )
+		self.assertEqual( p["out"].object( "/sphere2" ), s["out"].object( "/sphere1" ) )
+		self.assertEqual( p["out"].set( "A" ).value.paths(), [ "/sphere2" ] )
+
+		self.assertSceneValid( p["out"] )
+
 	def testGlobalsPassThrough( self ) :
 
 		g = GafferScene.Group()
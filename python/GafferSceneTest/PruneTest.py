@@ -358,5 +358,106 @@ class PruneTest( GafferSceneTest.SceneTestCase ) :
 					else :
 						self.assertTrue( inputSetPath in outputSet )
 
+	def testSetMatch( self ) :
+
+		setPaths = [ "/a", "/a/b/c/d/e", "/a/b/c", "/b/c", "/f/g/h/i" ]
+		filterPaths = [ [], [ "/" ], [ "/*" ], [ "/a" ], [ "/a/b" ], [ "/a/b/c/d" ], [ "/f/g/h/..." ] ]
+		queryPaths = [ "/", "/a", "/a/b", "/a/b/c", "/a/b/c/d", "/a/b/c/d/e", "/a/x", "/b", "/b/c", "/f/g", "/f/g/h/i", "/z" ]
+
+		setNode = GafferScene.Set()
+		setNode["paths"].setValue( IECore.StringVectorData( setPaths ) )
+
+		pathFilter = GafferScene.PathFilter()
+
+		prune = GafferScene.Prune()
+		prune["in"].setInput( setNode["out"] )
+		prune["filter"].setInput( pathFilter["out"] )
+
+		for p in filterPaths :
+			pathFilter["paths"].setValue( IECore.StringVectorData( p ) )
+			for enabled in ( True, False ) :
+				prune["enabled"].setValue( enabled )
+				outputSet = prune["out"].set( "set" ).value
+				for q in queryPaths :
+					self.assertEqual( prune["out"].setMatch( "set", q ), outputSet.match( q ) )
+
+		self.assertEqual( prune["out"].setMatch( "nonExistent", "/a" ), GafferScene.Filter.Result.NoMatch )
+
+	def testManyChildren( self ) :
+
+		sphere = GafferScene.Sphere()
+
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( sphere["out"] )
+		duplicate["target"].setValue( "/sphere" )
+		duplicate["copies"].setValue( 999 )
+
+		paths = [ "/sphere%d" % i for i in range( 3, 1000, 3 ) ]
+		expectedChildNames = IECore.InternedStringVectorData(
+			[ "sphere" ] + [ "sphere%d" % i for i in range( 1, 1000 ) if i % 3 ]
+		)
+
+		# PathFilters are queried directly for all the children at once.
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( paths ) )
+
+		prune = GafferScene.Prune()
+		prune["in"].setInput( duplicate["out"] )
+		prune["filter"].setInput( pathFilter["out"] )
+
+		self.assertEqual( prune["out"].childNames( "/" ), expectedChildNames )
+
+		# Other filters are evaluated for each child in parallel,
+		# and must give the same results.
+
+		set = GafferScene.Set()
+		set["in"].setInput( duplicate["out"] )
+		set["paths"].setValue( IECore.StringVectorData( paths ) )
+
+		setFilter = GafferScene.SetFilter()
+		setFilter["set"].setValue( "set" )
+
+		prune2 = GafferScene.Prune()
+		prune2["in"].setInput( set["out"] )
+		prune2["filter"].setInput( setFilter["out"] )
+
+		self.assertEqual( prune2["out"].childNames( "/" ), expectedChildNames )
+
+		# Changing the filter must change the hash.
+
+		h = prune["out"].childNamesHash( "/" )
+		pathFilter["paths"].setValue( IECore.StringVectorData( paths[1:] ) )
+		self.assertNotEqual( prune["out"].childNamesHash( "/" ), h )
+		self.assertEqual( len( prune["out"].childNames( "/" ) ), len( expectedChildNames ) + 1 )
+
+	def testPathDependentFilterEnabled( self ) :
+
+		sphere = GafferScene.Sphere()
+
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( sphere["out"] )
+		duplicate["target"].setValue( "/sphere" )
+		duplicate["copies"].setValue( 2 )
+
+		script = Gaffer.ScriptNode()
+		script["filter"] = GafferScene.PathFilter()
+		script["filter"]["paths"].setValue( IECore.StringVectorData( [ "/*" ] ) )
+
+		# Disable the filter for just one of the children. The batched
+		# child queries must respect this, just as per-location queries do.
+
+		script["expression"] = Gaffer.Expression()
+		script["expression"].setExpression(
+			'path = context.get( "scene:path", None )\n'
+			'parent["filter"]["enabled"] = not path or str( path[len( path ) - 1] ) != "sphere1"'
+		)
+
+		prune = GafferScene.Prune()
+		prune["in"].setInput( duplicate["out"] )
+		prune["filter"].setInput( script["filter"]["out"] )
+
+		self.assertEqual( prune["out"].childNames( "/" ), IECore.InternedStringVectorData( [ "sphere1" ] ) )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -0,0 +1,167 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferScene
+import GafferSceneTest
+
+class RenderSetsTest( GafferSceneTest.SceneTestCase ) :
+
+	def __renderScript( self, numPlanes ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["plane"] = GafferScene.Plane()
+
+		s["duplicate"] = GafferScene.Duplicate()
+		s["duplicate"]["in"].setInput( s["plane"]["out"] )
+		s["duplicate"]["target"].setValue( "/plane" )
+		s["duplicate"]["copies"].setValue( numPlanes - 1 )
+
+		s["set"] = GafferScene.Set()
+		s["set"]["in"].setInput( s["duplicate"]["out"] )
+		s["set"]["name"].setValue( "render:test" )
+		s["set"]["paths"].setValue( IECore.StringVectorData( [ "/plane" ] ) )
+
+		s["render"] = GafferScene.Preview.InteractiveRender()
+		s["render"]["renderer"].setValue( "Capturing" )
+		s["render"]["in"].setInput( s["set"]["out"] )
+
+		return s
+
+	def testRenderSetEditsOnlyChangedLocations( self ) :
+
+		s = self.__renderScript( 100 )
+
+		GafferSceneTest.CapturingRenderer.resetStatistics()
+		s["render"]["state"].setValue( s["render"].State.Running )
+
+		statistics = GafferSceneTest.CapturingRenderer.statistics()
+		# One object per plane, plus the default camera.
+		self.assertEqual( statistics.objectsCreated, 101 )
+
+		# Adding a location to the set should only edit
+		# the attributes of that location.
+
+		GafferSceneTest.CapturingRenderer.resetStatistics()
+		s["set"]["paths"].setValue( IECore.StringVectorData( [ "/plane", "/plane1" ] ) )
+
+		statistics = GafferSceneTest.CapturingRenderer.statistics()
+		self.assertEqual( statistics.attributeEdits, 1 )
+		self.assertEqual( statistics.objectsCreated, 0 )
+		self.assertEqual( statistics.transformEdits, 0 )
+
+		# As should removing one.
+
+		GafferSceneTest.CapturingRenderer.resetStatistics()
+		s["set"]["paths"].setValue( IECore.StringVectorData( [ "/plane1" ] ) )
+
+		statistics = GafferSceneTest.CapturingRenderer.statistics()
+		self.assertEqual( statistics.attributeEdits, 1 )
+		self.assertEqual( statistics.objectsCreated, 0 )
+
+		# Changing the set without changing its
+		# membership shouldn't edit anything.
+
+		GafferSceneTest.CapturingRenderer.resetStatistics()
+		s["set"]["paths"].setValue( IECore.StringVectorData( [ "/plane1", "/plane1" ] ) )
+
+		statistics = GafferSceneTest.CapturingRenderer.statistics()
+		self.assertEqual( statistics.attributeEdits, 0 )
+		self.assertEqual( statistics.objectsCreated, 0 )
+
+		# Renaming the set removes it entirely, and
+		# adds a new one with the same members.
+
+		GafferSceneTest.CapturingRenderer.resetStatistics()
+		s["set"]["name"].setValue( "render:test2" )
+
+		statistics = GafferSceneTest.CapturingRenderer.statistics()
+		self.assertEqual( statistics.attributeEdits, 1 )
+		self.assertEqual( statistics.objectsCreated, 0 )
+
+		s["render"]["state"].setValue( s["render"].State.Stopped )
+
+	def testRenderSetChangesApplyToDescendants( self ) :
+
+		s = self.__renderScript( 10 )
+
+		s["group"] = GafferScene.Group()
+		s["group"]["in"][0].setInput( s["duplicate"]["out"] )
+		s["set"]["in"].setInput( s["group"]["out"] )
+		s["set"]["paths"].setValue( IECore.StringVectorData() )
+
+		s["render"]["state"].setValue( s["render"].State.Running )
+
+		# Adding the group to the set changes the
+		# inherited sets attribute for all the planes.
+
+		GafferSceneTest.CapturingRenderer.resetStatistics()
+		s["set"]["paths"].setValue( IECore.StringVectorData( [ "/group" ] ) )
+
+		statistics = GafferSceneTest.CapturingRenderer.statistics()
+		self.assertEqual( statistics.attributeEdits, 10 )
+		self.assertEqual( statistics.objectsCreated, 0 )
+
+		s["render"]["state"].setValue( s["render"].State.Stopped )
+
+	def testLightSetChanges( self ) :
+
+		s = self.__renderScript( 10 )
+		s["set"]["name"].setValue( "__lights" )
+		s["set"]["paths"].setValue( IECore.StringVectorData() )
+
+		s["render"]["state"].setValue( s["render"].State.Running )
+
+		# Moving a location into the lights set should
+		# replace it, but leave everything else alone.
+
+		GafferSceneTest.CapturingRenderer.resetStatistics()
+		s["set"]["paths"].setValue( IECore.StringVectorData( [ "/plane3" ] ) )
+
+		statistics = GafferSceneTest.CapturingRenderer.statistics()
+		self.assertEqual( statistics.objectsCreated, 1 )
+		self.assertEqual( statistics.attributeEdits, 0 )
+
+		s["render"]["state"].setValue( s["render"].State.Stopped )
+
+if __name__ == "__main__":
+	unittest.main()
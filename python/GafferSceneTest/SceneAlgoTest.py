@@ -211,5 +211,134 @@ class SceneAlgoTest( GafferSceneTest.SceneTestCase ) :
 				context["lightName"] = "light%d" % i
 				GafferScene.sets( script["light"]["out"] )
 
+	def testTransformSamples( self ) :
+
+		script = Gaffer.ScriptNode()
+		script["sphere"] = GafferScene.Sphere()
+		script["group"] = GafferScene.Group()
+		script["group"]["in"][0].setInput( script["sphere"]["out"] )
+		script["group"]["transform"]["translate"]["y"].setValue( 2 )
+
+		script["expression"] = Gaffer.Expression()
+		script["expression"].setExpression( 'parent["sphere"]["transform"]["translate"]["x"] = context.getFrame()' )
+
+		times = [ 0.75, 1.0, 1.25 ]
+		samples = GafferScene.transformSamples( script["group"]["out"], "/group/sphere", times )
+		fullSamples = GafferScene.fullTransformSamples( script["group"]["out"], "/group/sphere", times )
+		self.assertEqual( len( samples ), len( times ) )
+		self.assertEqual( len( fullSamples ), len( times ) )
+
+		for time, sample, fullSample in zip( times, samples, fullSamples ) :
+			with Gaffer.Context() as c :
+				c.setFrame( time )
+				self.assertEqual( sample, script["group"]["out"].transform( "/group/sphere" ) )
+				self.assertEqual( fullSample, script["group"]["out"].fullTransform( "/group/sphere" ) )
+				self.assertEqual( fullSample.translation(), IECore.V3f( time, 2, 0 ) )
+
+		# Static ancestors produce identical samples.
+		self.assertEqual( GafferScene.transformSamples( script["group"]["out"], "/group", times ), [ script["group"]["out"].transform( "/group" ) ] * 3 )
+
+	def testObjectSamples( self ) :
+
+		script = Gaffer.ScriptNode()
+		script["sphere"] = GafferScene.Sphere()
+
+		script["expression"] = Gaffer.Expression()
+		script["expression"].setExpression( 'parent["sphere"]["radius"] = context.getFrame()' )
+
+		times = [ 1.0, 1.5, 2.0 ]
+		samples = GafferScene.objectSamples( script["sphere"]["out"], "/sphere", times )
+		self.assertEqual( len( samples ), len( times ) )
+		for time, sample in zip( times, samples ) :
+			with Gaffer.Context() as c :
+				c.setFrame( time )
+				self.assertEqual( sample, script["sphere"]["out"].object( "/sphere" ) )
+
+		# When nothing is animated, all samples share a single compute.
+
+		script["expression"].setExpression( 'parent["sphere"]["radius"] = 2' )
+		samples = GafferScene.objectSamples( script["sphere"]["out"], "/sphere", times, _copy = False )
+		self.assertTrue( samples[0].isSame( samples[1] ) )
+		self.assertTrue( samples[0].isSame( samples[2] ) )
+
+	def testObjectSamplesComputeEachDistinctSampleOnce( self ) :
+
+		script = Gaffer.ScriptNode()
+		script["sphere"] = GafferScene.Sphere()
+		# Unique value so that we can't get a result from
+		# the cache populated by another test.
+		script["sphere"]["divisions"].setValue( IECore.V2i( 37, 41 ) )
+
+		script["expression"] = Gaffer.Expression()
+		script["expression"].setExpression( 'parent["sphere"]["radius"] = 1 + context.getFrame() * 0.1' )
+
+		script["group"] = GafferScene.Group()
+		script["group"]["in"][0].setInput( script["sphere"]["out"] )
+
+		times = [ 0.75 + 0.1 * i for i in range( 0, 6 ) ]
+
+		with Gaffer.PerformanceMonitor() as m :
+			samples = GafferScene.objectSamples( script["group"]["out"], "/group/sphere", times )
+
+		self.assertEqual( m.plugStatistics( script["sphere"]["out"]["object"] ).computeCount, len( times ) )
+
+		for time, sample in zip( times, samples ) :
+			with Gaffer.Context() as c :
+				c.setFrame( time )
+				self.assertEqual( sample, script["group"]["out"].object( "/group/sphere" ) )
+
+		# When the sphere isn't animated, every sample
+		# has the same hash, so only one compute is needed.
+
+		script["expression"].setExpression( 'parent["sphere"]["radius"] = 1.25' )
+		with Gaffer.PerformanceMonitor() as m :
+			GafferScene.objectSamples( script["group"]["out"], "/group/sphere", times )
+
+		self.assertEqual( m.plugStatistics( script["sphere"]["out"]["object"] ).computeCount, 1 )
+
+	def testMotionSamplingPerformance( self ) :
+
+		# A benchmark comparing objectSamples() against evaluating
+		# each sample in turn. Uncomment the prints for timings.
+
+		script = Gaffer.ScriptNode()
+		script["sphere"] = GafferScene.Sphere()
+		script["sphere"]["divisions"].setValue( IECore.V2i( 100, 200 ) )
+
+		script["expression"] = Gaffer.Expression()
+		script["expression"].setExpression( 'parent["sphere"]["radius"] = 1 + context.getFrame() * 0.01' )
+
+		script["group"] = GafferScene.Group()
+		script["group"]["in"][0].setInput( script["sphere"]["out"] )
+
+		times = [ 0.75 + 0.1 * i for i in range( 0, 6 ) ]
+
+		originalCacheMemoryLimit = Gaffer.ValuePlug.getCacheMemoryLimit()
+		try :
+
+			Gaffer.ValuePlug.setCacheMemoryLimit( 0 )
+			Gaffer.ValuePlug.setCacheMemoryLimit( originalCacheMemoryLimit )
+
+			t = IECore.Timer()
+			perSampleSamples = []
+			for time in times :
+				with Gaffer.Context() as c :
+					c.setFrame( time )
+					perSampleSamples.append( script["group"]["out"].object( "/group/sphere" ) )
+			# print "Per sample : ", t.stop()
+
+			Gaffer.ValuePlug.setCacheMemoryLimit( 0 )
+			Gaffer.ValuePlug.setCacheMemoryLimit( originalCacheMemoryLimit )
+
+			t = IECore.Timer()
+			samples = GafferScene.objectSamples( script["group"]["out"], "/group/sphere", times )
+			# print "objectSamples() : ", t.stop()
+
+		finally :
+
+			Gaffer.ValuePlug.setCacheMemoryLimit( originalCacheMemoryLimit )
+
+		self.assertEqual( samples, perSampleSamples )
+
 if __name__ == "__main__":
 	unittest.main()
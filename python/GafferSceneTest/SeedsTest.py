@@ -193,5 +193,90 @@ class SeedsTest( GafferSceneTest.SceneTestCase ) :
 		self.assertEqual( s["in"]["globals"].hash(), s["out"]["globals"].hash() )
 		self.assertEqual( s["in"]["globals"].getValue(), s["out"]["globals"].getValue() )
 
+	def testDensityPrimitiveVariable( self ) :
+
+		m = IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -1 ), IECore.V2f( 1 ) ), IECore.V2i( 10 ) )
+		m["density"] = IECore.PrimitiveVariable(
+			IECore.PrimitiveVariable.Interpolation.Vertex,
+			IECore.FloatVectorData( [ 1 if p.x < 0 else 0 for p in m["P"].data ] )
+		)
+
+		o = GafferScene.ObjectToScene()
+		o["object"].setValue( m )
+
+		s = GafferScene.Seeds()
+		s["in"].setInput( o["out"] )
+		s["parent"].setValue( "/object" )
+		s["density"].setValue( 100 )
+
+		uniform = s["out"].object( "/object/seeds" )
+		h = s["out"].objectHash( "/object/seeds" )
+
+		s["densityPrimitiveVariable"].setValue( "density" )
+		self.assertNotEqual( s["out"].objectHash( "/object/seeds" ), h )
+
+		varying = s["out"].object( "/object/seeds" )
+		self.assertLess( varying.numPoints, uniform.numPoints )
+		self.assertGreater( varying.numPoints, 0 )
+		for p in varying["P"].data :
+			self.assertLess( p.x, 0.1 )
+
+		self.assertSceneValid( s["out"] )
+
+	def testDeterminism( self ) :
+
+		p = GafferScene.Plane()
+		p["divisions"].setValue( IECore.V2i( 100 ) )
+
+		s = GafferScene.Seeds()
+		s["in"].setInput( p["out"] )
+		s["parent"].setValue( "/plane" )
+		s["density"].setValue( 1000 )
+
+		points = s["out"].object( "/plane/seeds" )
+		limit = Gaffer.ValuePlug.getCacheMemoryLimit()
+		for i in range( 0, 5 ) :
+			Gaffer.ValuePlug.setCacheMemoryLimit( 0 )
+			Gaffer.ValuePlug.setCacheMemoryLimit( limit )
+			self.assertEqual( s["out"].object( "/plane/seeds" ), points )
+
+	def testContinuityAcrossFaces( self ) :
+
+		p1 = GafferScene.Plane()
+		p2 = GafferScene.Plane()
+		p2["divisions"].setValue( IECore.V2i( 20 ) )
+
+		s1 = GafferScene.Seeds()
+		s1["in"].setInput( p1["out"] )
+		s1["parent"].setValue( "/plane" )
+		s1["density"].setValue( 1000 )
+
+		s2 = GafferScene.Seeds()
+		s2["in"].setInput( p2["out"] )
+		s2["parent"].setValue( "/plane" )
+		s2["density"].setValue( 1000 )
+
+		# The distribution is defined in UV space, so subdividing
+		# the mesh shouldn't significantly change the number of points.
+		n1 = s1["out"].object( "/plane/seeds" ).numPoints
+		n2 = s2["out"].object( "/plane/seeds" ).numPoints
+		self.assertAlmostEqual( n1, n2, delta = n1 * 0.02 )
+
+	def testPerformance( self ) :
+
+		p = GafferScene.Plane()
+		p["divisions"].setValue( IECore.V2i( 1000 ) )
+
+		s = GafferScene.Seeds()
+		s["in"].setInput( p["out"] )
+		s["parent"].setValue( "/plane" )
+		s["density"].setValue( 100000 )
+
+		p["out"].object( "/plane" )
+
+		t = IECore.Timer()
+		s["out"].object( "/plane/seeds" )
+		# print t.stop()
+
 if __name__ == "__main__":
 	unittest.main()
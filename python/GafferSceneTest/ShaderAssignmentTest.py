@@ -328,5 +328,68 @@ class ShaderAssignmentTest( GafferSceneTest.SceneTestCase ) :
 		s["enabled"].setValue( False )
 		self.assertEqual( set( x[0] for x in cs ), set( ( s["enabled"], s["out"]["attributes"], s["out"] ) ) )
 
+	def testOutputSharesShaderAttributes( self ) :
+
+		s = GafferSceneTest.TestShader()
+		s["type"].setValue( "test:surface" )
+
+		p = GafferScene.Plane()
+
+		f = GafferScene.PathFilter()
+		f["paths"].setValue( IECore.StringVectorData( [ "/plane" ] ) )
+
+		a = GafferScene.ShaderAssignment()
+		a["in"].setInput( p["out"] )
+		a["filter"].setInput( f["out"] )
+		a["shader"].setInput( s["out"] )
+
+		# The plane has no attributes of its own, so there's
+		# no need for a new map - the shader's attributes can
+		# be used directly.
+		self.assertTrue( a["out"].attributes( "/plane", _copy = False ).isSame( s.attributes( _copy = False ) ) )
+
+		# Assigning the same shader again shouldn't make a new
+		# map either, because the values are already shared.
+
+		a2 = GafferScene.ShaderAssignment()
+		a2["in"].setInput( a["out"] )
+		a2["filter"].setInput( f["out"] )
+		a2["shader"].setInput( s["out"] )
+
+		self.assertTrue( a2["out"].attributes( "/plane", _copy = False ).isSame( a["out"].attributes( "/plane", _copy = False ) ) )
+
+	def testPathDependentShader( self ) :
+
+		plane = GafferScene.Plane()
+		sphere = GafferScene.Sphere()
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( plane["out"] )
+		group["in"][1].setInput( sphere["out"] )
+
+		script = Gaffer.ScriptNode()
+		script["shader"] = GafferSceneTest.TestShader()
+		script["shader"]["type"].setValue( "test:surface" )
+
+		# Vary the shader per location. Shared networks are an
+		# optimisation, and must not take this away.
+
+		script["expression"] = Gaffer.Expression()
+		script["expression"].setExpression(
+			'path = context.get( "scene:path", None )\n'
+			'parent["shader"]["parameters"]["i"] = 1 if path and str( path[len( path ) - 1] ) == "plane" else 2'
+		)
+
+		f = GafferScene.PathFilter()
+		f["paths"].setValue( IECore.StringVectorData( [ "/group/*" ] ) )
+
+		a = GafferScene.ShaderAssignment()
+		a["in"].setInput( group["out"] )
+		a["filter"].setInput( f["out"] )
+		a["shader"].setInput( script["shader"]["out"] )
+
+		self.assertEqual( a["out"].attributes( "/group/plane" )["test:surface"][0].parameters["i"], IECore.IntData( 1 ) )
+		self.assertEqual( a["out"].attributes( "/group/sphere" )["test:surface"][0].parameters["i"], IECore.IntData( 2 ) )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -180,5 +180,45 @@ class ShaderTest( GafferSceneTest.SceneTestCase ) :
 			self.assertRaisesRegexp( RuntimeError, "cycle", node.attributesHash )
 			self.assertRaisesRegexp( RuntimeError, "cycle", node.attributes )
 
+	def testNetworkBuiltOncePerHash( self ) :
+
+		s = GafferSceneTest.TestShader()
+		s["type"].setValue( "test:surface" )
+		# Unique value so that we can't get a result from
+		# the cache populated by another test.
+		s["parameters"]["i"].setValue( 1729 )
+
+		p = GafferScene.Plane()
+
+		d = GafferScene.Duplicate()
+		d["in"].setInput( p["out"] )
+		d["target"].setValue( "/plane" )
+		d["copies"].setValue( 10 )
+
+		f = GafferScene.PathFilter()
+		f["paths"].setValue( IECore.StringVectorData( [ "/*" ] ) )
+
+		a = GafferScene.ShaderAssignment()
+		a["in"].setInput( d["out"] )
+		a["filter"].setInput( f["out"] )
+		a["shader"].setInput( s["out"] )
+
+		with Gaffer.PerformanceMonitor() as m :
+			for name in a["out"].childNames( "/" ) :
+				self.assertEqual( a["out"].attributes( "/" + str( name ) ), s.attributes() )
+
+		# The network must be hashed once, not once per location,
+		# and built once too.
+		self.assertEqual( m.plugStatistics( s["__outState"] ).hashCount, 1 )
+		self.assertEqual( m.plugStatistics( s["__outState"] ).computeCount, 1 )
+		self.assertEqual( m.plugStatistics( s["__outAttributes"] ).hashCount, 1 )
+		self.assertEqual( m.plugStatistics( s["__outAttributes"] ).computeCount, 1 )
+
+		# Changing a parameter must give us a new network.
+
+		s["parameters"]["i"].setValue( 1730 )
+		self.assertEqual( a["out"].attributes( "/plane" ), s.attributes() )
+		self.assertEqual( s.attributes()["test:surface"][0].parameters["i"], IECore.IntData( 1730 ) )
+
 if __name__ == "__main__":
 	unittest.main()
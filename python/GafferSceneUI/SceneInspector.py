@@ -1723,9 +1723,7 @@ class __SetMembershipSection( Section ) :
 			if target.path is None :
 				return None
 
-			set = target.set( self.__setName )
-
-			m = set.value.match( target.path )
+			m = target.scene.setMatch( self.__setName, target.path )
 			if m & GafferScene.Filter.Result.ExactMatch :
 				return True
 
@@ -102,7 +102,19 @@ Gaffer.Metadata.registerNode(
 
 			"plugValueWidget:type", "GafferUI.PresetsPlugValueWidget",
 
-		]
+		],
+
+		"densityPrimitiveVariable" : [
+
+			"description",
+			"""
+			The name of a float primitive variable on the
+			mesh, used to modulate the density of the points
+			over the surface. Values are expected to be in the
+			range 0-1. If left empty, the density is uniform.
+			""",
+
+		],
 
 	}
 
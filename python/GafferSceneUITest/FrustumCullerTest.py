@@ -0,0 +1,129 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+
+import unittest
+
+import IECore
+
+import GafferSceneUI
+import GafferTest
+
+class FrustumCullerTest( GafferTest.TestCase ) :
+
+	def testFrustumTests( self ) :
+
+		# With an identity matrix, clip space and object space are
+		# the same, so the frustum is the box from -1 to 1.
+
+		c = GafferSceneUI.FrustumCuller( IECore.V2i( 100 ), 1 )
+		m = IECore.M44f()
+
+		self.assertEqual(
+			c.visibility( IECore.Box3f( IECore.V3f( -0.5 ), IECore.V3f( 0.5 ) ), m ),
+			GafferSceneUI.FrustumCuller.Visibility.Contained
+		)
+
+		self.assertEqual(
+			c.visibility( IECore.Box3f( IECore.V3f( 0.5 ), IECore.V3f( 1.5 ) ), m ),
+			GafferSceneUI.FrustumCuller.Visibility.Intersecting
+		)
+
+		self.assertEqual(
+			c.visibility( IECore.Box3f( IECore.V3f( 1.5 ), IECore.V3f( 2.5 ) ), m ),
+			GafferSceneUI.FrustumCuller.Visibility.Culled
+		)
+
+		self.assertEqual(
+			c.visibility( IECore.Box3f( IECore.V3f( -1.5, 1.5, 0 ), IECore.V3f( 1.5, 2.5, 0 ) ), m ),
+			GafferSceneUI.FrustumCuller.Visibility.Culled
+		)
+
+		self.assertEqual(
+			c.visibility( IECore.Box3f(), m ),
+			GafferSceneUI.FrustumCuller.Visibility.Culled
+		)
+
+	def testObjectToClip( self ) :
+
+		c = GafferSceneUI.FrustumCuller( IECore.V2i( 100 ), 1 )
+		b = IECore.Box3f( IECore.V3f( -0.5 ), IECore.V3f( 0.5 ) )
+
+		self.assertEqual(
+			c.visibility( b, IECore.M44f.createTranslated( IECore.V3f( 10, 0, 0 ) ) ),
+			GafferSceneUI.FrustumCuller.Visibility.Culled
+		)
+
+		self.assertEqual(
+			c.visibility( b, IECore.M44f.createScaled( IECore.V3f( 4 ) ) ),
+			GafferSceneUI.FrustumCuller.Visibility.Intersecting
+		)
+
+	def testStandIns( self ) :
+
+		b = IECore.Box3f( IECore.V3f( -0.005 ), IECore.V3f( 0.005 ) )
+		m = IECore.M44f()
+
+		# The bound is 0.5 pixels wide on a 100 pixel viewport.
+
+		c = GafferSceneUI.FrustumCuller( IECore.V2i( 100 ), 1 )
+		self.assertEqual( c.visibility( b, m ), GafferSceneUI.FrustumCuller.Visibility.StandIn )
+
+		c = GafferSceneUI.FrustumCuller( IECore.V2i( 1000 ), 1 )
+		self.assertEqual( c.visibility( b, m ), GafferSceneUI.FrustumCuller.Visibility.Contained )
+
+		c = GafferSceneUI.FrustumCuller( IECore.V2i( 100 ), 0 )
+		self.assertEqual( c.visibility( b, m ), GafferSceneUI.FrustumCuller.Visibility.Contained )
+
+		# Stand-ins take precedence over culling only for things which
+		# are actually on screen.
+
+		c = GafferSceneUI.FrustumCuller( IECore.V2i( 100 ), 1 )
+		self.assertEqual(
+			c.visibility( b, IECore.M44f.createTranslated( IECore.V3f( 10, 0, 0 ) ) ),
+			GafferSceneUI.FrustumCuller.Visibility.Culled
+		)
+
+	def testParentContained( self ) :
+
+		c = GafferSceneUI.FrustumCuller( IECore.V2i( 100 ), 1 )
+		b = IECore.Box3f( IECore.V3f( 0.5 ), IECore.V3f( 1.5 ) )
+
+		self.assertEqual( c.visibility( b, IECore.M44f() ), GafferSceneUI.FrustumCuller.Visibility.Intersecting )
+		self.assertEqual( c.visibility( b, IECore.M44f(), parentContained = True ), GafferSceneUI.FrustumCuller.Visibility.Contained )
+
+if __name__ == "__main__":
+	unittest.main()
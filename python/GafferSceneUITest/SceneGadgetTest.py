@@ -153,6 +153,92 @@ class SceneGadgetTest( GafferUITest.TestCase ) :
 		self.assertObjectAt( sg, IECore.V2f( 0.5 ), None )
 		self.assertObjectsAt( sg, IECore.Box2f( IECore.V2f( 0 ), IECore.V2f( 1 ) ), [ "/group" ] )
 
+	def testPicking( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["left"] = GafferScene.Sphere()
+		s["left"]["name"].setValue( "left" )
+		s["left"]["transform"]["translate"]["x"].setValue( -2 )
+
+		s["right"] = GafferScene.Sphere()
+		s["right"]["name"].setValue( "right" )
+		s["right"]["transform"]["translate"]["x"].setValue( 2 )
+
+		s["back"] = GafferScene.Sphere()
+		s["back"]["name"].setValue( "back" )
+		s["back"]["transform"]["translate"]["x"].setValue( 2 )
+		s["back"]["transform"]["translate"]["z"].setValue( -4 )
+
+		s["g"] = GafferScene.Group()
+		s["g"]["in"][0].setInput( s["left"]["out"] )
+		s["g"]["in"][1].setInput( s["right"]["out"] )
+		s["g"]["in"][2].setInput( s["back"]["out"] )
+
+		sg = GafferSceneUI.SceneGadget()
+		sg.setMinimumExpansionDepth( 2 )
+		sg.setScene( s["g"]["out"] )
+
+		with GafferUI.Window() as w :
+			gw = GafferUI.GadgetWidget( sg )
+
+		w.setVisible( True )
+		self.waitForIdle( 1000 )
+
+		gw.getViewportGadget().frame( sg.bound() )
+
+		# The gap between the spheres should be empty, and where
+		# spheres overlap, the frontmost should be chosen.
+
+		self.assertObjectAt( sg, IECore.V2f( 0.5 ), None )
+		self.assertObjectAt( sg, IECore.V2f( 0.25, 0.5 ), IECore.InternedStringVectorData( [ "group", "left" ] ) )
+		self.assertObjectAt( sg, IECore.V2f( 0.75, 0.5 ), IECore.InternedStringVectorData( [ "group", "right" ] ) )
+
+		self.assertObjectsAt( sg, IECore.Box2f( IECore.V2f( 0 ), IECore.V2f( 0.45, 1 ) ), [ "/group/left" ] )
+		self.assertObjectsAt( sg, IECore.Box2f( IECore.V2f( 0.55, 0 ), IECore.V2f( 1 ) ), [ "/group/right", "/group/back" ] )
+		self.assertObjectsAt( sg, IECore.Box2f( IECore.V2f( 0 ), IECore.V2f( 1 ) ), [ "/group/left", "/group/right", "/group/back" ] )
+
+		# Moving an object should be reflected in the results.
+
+		s["left"]["transform"]["translate"]["y"].setValue( 100 )
+		self.assertObjectAt( sg, IECore.V2f( 0.25, 0.5 ), None )
+
+	def testPickingRespectsDrawStyle( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["p"] = GafferScene.Plane()
+
+		s["a"] = GafferScene.OpenGLAttributes()
+		s["a"]["in"].setInput( s["p"]["out"] )
+
+		sg = GafferSceneUI.SceneGadget()
+		sg.setMinimumExpansionDepth( 1 )
+		sg.setScene( s["a"]["out"] )
+
+		with GafferUI.Window() as w :
+			gw = GafferUI.GadgetWidget( sg )
+
+		w.setVisible( True )
+		self.waitForIdle( 1000 )
+
+		gw.getViewportGadget().frame( sg.bound() )
+
+		# A point inside the plane, but away from the edges
+		# of its triangles.
+		position = IECore.V2f( 0.45, 0.6 )
+		self.assertObjectAt( sg, position, IECore.InternedStringVectorData( [ "plane" ] ) )
+
+		# When drawn as a wireframe, only the edges can be picked.
+
+		s["a"]["attributes"]["primitiveSolid"]["enabled"].setValue( True )
+		s["a"]["attributes"]["primitiveSolid"]["value"].setValue( False )
+		s["a"]["attributes"]["primitiveWireframe"]["enabled"].setValue( True )
+		self.assertObjectAt( sg, position, None )
+
+		s["a"]["attributes"]["primitiveSolid"]["value"].setValue( True )
+		self.assertObjectAt( sg, position, IECore.InternedStringVectorData( [ "plane" ] ) )
+
 	def testExpressions( self ) :
 
 		s = Gaffer.ScriptNode()
@@ -169,6 +255,17 @@ class SceneGadgetTest( GafferUITest.TestCase ) :
 		g.setScene( s["g"]["out"] )
 		g.bound()
 
+	def testMinimumScreenSize( self ) :
+
+		g = GafferSceneUI.SceneGadget()
+		self.assertEqual( g.getMinimumScreenSize(), 1 )
+
+		g.setMinimumScreenSize( 4 )
+		self.assertEqual( g.getMinimumScreenSize(), 4 )
+
+		g.setMinimumScreenSize( 0 )
+		self.assertEqual( g.getMinimumScreenSize(), 0 )
+
 	def testGLResourceDestruction( self ) :
 
 		s = Gaffer.ScriptNode()
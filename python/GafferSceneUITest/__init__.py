@@ -42,6 +42,7 @@ from SceneInspectorTest import SceneInspectorTest
 from SceneHierarchyTest import SceneHierarchyTest
 from DocumentationTest import DocumentationTest
 from ShaderViewTest import ShaderViewTest
+from FrustumCullerTest import FrustumCullerTest
 
 if __name__ == "__main__":
 	unittest.main()
@@ -484,5 +484,9 @@ class ComputeNodeTest( GafferTest.TestCase ) :
 
 		GafferTest.testComputeNodeThreading()
 
+	def testIgnoredContextVariables( self ) :
+
+		GafferTest.testComputeNodeIgnoredContextVariables()
+
 if __name__ == "__main__":
 	unittest.main()
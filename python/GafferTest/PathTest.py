@@ -305,5 +305,21 @@ class PathTest( GafferTest.TestCase ) :
 
 		# we should not crash
 
+	def testChildrenTaskOrdering( self ) :
+
+		GafferTest.testPathChildrenTaskOrdering()
+
+	def testChildrenTaskCancellation( self ) :
+
+		GafferTest.testPathChildrenTaskCancellation()
+
+	def testChildrenTaskErrors( self ) :
+
+		GafferTest.testPathChildrenTaskErrors()
+
+	def testChildrenTaskForeground( self ) :
+
+		GafferTest.testPathChildrenTaskForeground()
+
 if __name__ == "__main__":
 	unittest.main()
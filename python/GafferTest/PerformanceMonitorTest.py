@@ -113,13 +113,23 @@ class PerformanceMonitorTest( GafferTest.TestCase ) :
 			hashCount = 10,
 			computeCount = 20,
 			hashDuration = 100,
-			computeDuration = 200
+			computeDuration = 200,
+			cacheCount = 1,
+			cacheMemory = 2,
+			evictionCount = 3,
+			recomputeCount = 4,
+			clearCount = 5,
 		)
 
 		self.assertEqual( s.hashCount, 10 )
 		self.assertEqual( s.computeCount, 20 )
 		self.assertEqual( s.hashDuration, 100 )
 		self.assertEqual( s.computeDuration, 200 )
+		self.assertEqual( s.cacheCount, 1 )
+		self.assertEqual( s.cacheMemory, 2 )
+		self.assertEqual( s.evictionCount, 3 )
+		self.assertEqual( s.recomputeCount, 4 )
+		self.assertEqual( s.clearCount, 5 )
 
 		s.hashCount = 20
 		s.computeCount = 30
@@ -131,6 +141,82 @@ class PerformanceMonitorTest( GafferTest.TestCase ) :
 		self.assertEqual( s.hashDuration, 200 )
 		self.assertEqual( s.computeDuration, 300 )
 
+	def testCacheStatistics( self ) :
+
+		a = GafferTest.AddNode()
+		a["op1"].setValue( -3001 )
+		a["op2"].setValue( -3002 )
+
+		originalLimit = Gaffer.ValuePlug.getCacheMemoryLimit()
+		try :
+
+			with Gaffer.PerformanceMonitor() as m :
+
+				# Computing should store a single result in the cache.
+
+				self.assertEqual( a["sum"].getValue(), -6003 )
+				s = m.plugStatistics( a["sum"] )
+				self.assertEqual( s.cacheCount, 1 )
+				self.assertGreater( s.cacheMemory, 0 )
+				self.assertEqual( s.evictionCount, 0 )
+				self.assertEqual( s.recomputeCount, 0 )
+
+				# Clearing the cache should be attributed back to
+				# the plug, but not counted as an eviction.
+
+				cost = s.cacheMemory
+				Gaffer.ValuePlug.setCacheMemoryLimit( 0 )
+				Gaffer.ValuePlug.setCacheMemoryLimit( originalLimit )
+
+				s = m.plugStatistics( a["sum"] )
+				self.assertEqual( s.cacheCount, 0 )
+				self.assertEqual( s.cacheMemory, 0 )
+				self.assertEqual( s.evictionCount, 0 )
+				self.assertEqual( s.clearCount, 1 )
+				self.assertEqual( s.recomputeCount, 0 )
+
+				# And computing again after a clear isn't a recompute.
+
+				self.assertEqual( a["sum"].getValue(), -6003 )
+				s = m.plugStatistics( a["sum"] )
+				self.assertEqual( s.computeCount, 2 )
+				self.assertEqual( s.cacheCount, 1 )
+				self.assertEqual( s.recomputeCount, 0 )
+
+				# Limit the cache to a single result, so that storing
+				# a second one must evict one of them.
+
+				Gaffer.ValuePlug.setCacheMemoryLimit( 0 )
+				Gaffer.ValuePlug.setCacheMemoryLimit( cost )
+
+				self.assertEqual( a["sum"].getValue(), -6003 )
+				a["op1"].setValue( -4001 )
+				self.assertEqual( a["sum"].getValue(), -7003 )
+
+				s = m.plugStatistics( a["sum"] )
+				self.assertEqual( s.cacheCount, 1 )
+				self.assertEqual( s.cacheMemory, cost )
+				self.assertEqual( s.evictionCount, 1 )
+				self.assertEqual( s.clearCount, 2 )
+
+				# Computing the evicted result again should count as
+				# a recompute.
+
+				for op1, sum in ( ( -3001, -6003 ), ( -4001, -7003 ) ) :
+					a["op1"].setValue( op1 )
+					self.assertEqual( a["sum"].getValue(), sum )
+
+				s = m.plugStatistics( a["sum"] )
+				self.assertGreaterEqual( s.recomputeCount, 1 )
+				self.assertEqual( s.cacheCount, 1 )
+
+		finally :
+
+			Gaffer.ValuePlug.setCacheMemoryLimit( originalLimit )
+
+		self.assertTrue( "bytes held in the compute cache" in Gaffer.formatStatistics( m ) )
+		self.assertTrue( "recomputed after eviction" in Gaffer.formatStatistics( m, Gaffer.PerformanceMetric.RecomputeCount ) )
+
 	def testEnterReturnValue( self ) :
 
 		m = Gaffer.PerformanceMonitor()
@@ -1003,6 +1003,70 @@ a = A()"""
 		self.assertEqual( len( cs ), 2 )
 		self.assertTrue( cs[1][0].isSame( s ) )
 
+	def testUndoMemoryLimit( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["user"]["p"] = Gaffer.StringPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		self.assertEqual( s.undoMemoryUsage(), 0 )
+
+		megabyte = 1024 * 1024
+		for i in range( 0, 10 ) :
+			with Gaffer.UndoContext( s ) :
+				s["n"]["user"]["p"].setValue( str( i ) * megabyte )
+
+		self.assertGreater( s.undoMemoryUsage(), 10 * megabyte )
+
+		s.setUndoMemoryLimit( 5 * megabyte )
+		self.assertEqual( s.getUndoMemoryLimit(), 5 * megabyte )
+		self.assertLessEqual( s.undoMemoryUsage(), 5 * megabyte )
+
+		# The most recent entries are retained.
+		s.undo()
+		self.assertEqual( s["n"]["user"]["p"].getValue(), "8" * megabyte )
+		s.undo()
+		self.assertEqual( s["n"]["user"]["p"].getValue(), "7" * megabyte )
+		self.assertFalse( s.undoAvailable() )
+
+		# But the most recent one is always kept, even if
+		# it exceeds the limit on its own.
+		s.setUndoMemoryLimit( 0 )
+		while s.redoAvailable() :
+			s.redo()
+		with Gaffer.UndoContext( s ) :
+			s["n"]["user"]["p"].setValue( "a" * megabyte )
+
+		self.assertTrue( s.undoAvailable() )
+		s.undo()
+		self.assertEqual( s["n"]["user"]["p"].getValue(), "9" * megabyte )
+		self.assertFalse( s.undoAvailable() )
+
+	def testConsecutiveSetValuesCoalesced( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["user"]["p"] = Gaffer.StringPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		actions = []
+		c = s.actionSignal().connect( lambda script, action, stage : actions.append( action.memoryUsage() ) )
+
+		megabyte = 1024 * 1024
+		with Gaffer.UndoContext( s ) :
+			for i in range( 0, 10 ) :
+				s["n"]["user"]["p"].setValue( str( i ) * megabyte )
+
+		self.assertEqual( len( actions ), 10 )
+		self.assertGreater( actions[0], megabyte )
+
+		# Only the original and final values are held in the undo list.
+		self.assertLess( s.undoMemoryUsage(), 2 * megabyte )
+
+		s.undo()
+		self.assertEqual( s["n"]["user"]["p"].getValue(), "" )
+		s.redo()
+		self.assertEqual( s["n"]["user"]["p"].getValue(), "9" * megabyte )
+
 	def testCustomVariables( self ) :
 
 		s = Gaffer.ScriptNode()
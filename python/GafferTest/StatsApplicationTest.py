@@ -35,6 +35,7 @@
 ##########################################################################
 
 import re
+import json
 import unittest
 import subprocess32 as subprocess
 
@@ -69,5 +70,59 @@ class StatsApplicationTest( GafferTest.TestCase ) :
 		self.assertTrue( re.search( r"Box\s*1", o ) )
 		self.assertTrue( re.search( r"Total\s*3", o ) )
 
+	def testBenchmark( self ) :
+
+		import GafferScene
+
+		script = Gaffer.ScriptNode()
+		script["sphere"] = GafferScene.Sphere()
+		script["fileName"].setValue( self.temporaryDirectory() + "/script.gfr" )
+		script.save()
+
+		resultsFileName = self.temporaryDirectory() + "/results.json"
+		command = [
+			"gaffer", "stats", script["fileName"].getValue(),
+			"-scene", "sphere", "-benchmark", "-repeat", "2", "-threadCounts", "1", "2",
+		]
+
+		o = subprocess.check_output( command + [ "-json", resultsFileName ] )
+		self.assertTrue( "Benchmark :" in o )
+
+		with open( resultsFileName ) as f :
+			results = json.load( f )
+
+		self.assertEqual( set( results["threads"].keys() ), { "1", "2" } )
+		for threadResults in results["threads"].values() :
+			self.assertGreater( threadResults["maxRSS"], 0 )
+			for mode in ( "cold", "warm" ) :
+				self.assertEqual( len( threadResults[mode] ), 2 )
+				for run in threadResults[mode] :
+					self.assertGreater( run["wallTime"], 0 )
+			# Warm runs should reuse the hashes and values computed
+			# by the cold runs.
+			self.assertGreater( threadResults["cold"][0]["computeCount"], threadResults["warm"][0]["computeCount"] )
+
+		# Comparing against ourselves should pass, given a generous
+		# tolerance for timing noise.
+
+		o = subprocess.check_output( command + [ "-baseline", resultsFileName, "-tolerance", "100" ] )
+		self.assertTrue( "REGRESSION" not in o )
+
+		# But a baseline which did no work should flag a regression.
+
+		for threadResults in results["threads"].values() :
+			for mode in ( "cold", "warm" ) :
+				for run in threadResults[mode] :
+					run["computeCount"] = 0
+
+		baselineFileName = self.temporaryDirectory() + "/baseline.json"
+		with open( baselineFileName, "w" ) as f :
+			json.dump( results, f )
+
+		with self.assertRaises( subprocess.CalledProcessError ) as e :
+			subprocess.check_output( command + [ "-baseline", baselineFileName ] )
+
+		self.assertTrue( "REGRESSION" in e.exception.output )
+
 if __name__ == "__main__":
 	unittest.main()
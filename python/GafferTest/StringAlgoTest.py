@@ -34,6 +34,9 @@
 #
 ##########################################################################
 
+import time
+import unittest
+
 import Gaffer
 import GafferTest
 
@@ -53,11 +56,32 @@ class StringAlgoTest( GafferTest.TestCase ) :
 			( "dog collar", "dog co*", True ),
 			( "dog collar", "dog *", True ),
 			( "dog collar", "dog*", True ),
+			( "dogfish", "d*f*h", True ),
+			( "dogfish", "d**h", True ),
+			( "dogfish", "*o*i*", True ),
+			( "dogfish", "*o*x*", False ),
+			( "abab", "*ab", True ),
+			( "abac", "*ab", False ),
 		] :
 
 			self.assertEqual( Gaffer.match( s, p ), r )
+			self.assertEqual( Gaffer.CompiledMatchPattern( p ).match( s ), r )
 			if " " not in s :
 				self.assertEqual( Gaffer.matchMultiple( s, p ), r )
+				self.assertEqual( Gaffer.CompiledMatchPattern( p, multiple = True ).match( s ), r )
+
+	def testMatchIsNotExponential( self ) :
+
+		# A naive recursive matcher takes exponential time
+		# for patterns like this.
+		s = "a" * 100
+		p = "*a" * 20 + "b"
+
+		t = time.time()
+		self.assertFalse( Gaffer.match( s, p ) )
+		self.assertFalse( Gaffer.CompiledMatchPattern( p ).match( s ) )
+		self.assertFalse( Gaffer.matchMultiple( s, "x " + p ) )
+		self.assertLess( time.time() - t, 1 )
 
 	def testMatchMultiple( self ) :
 
@@ -75,9 +99,12 @@ class StringAlgoTest( GafferTest.TestCase ) :
 			( "dogcollar", "dog *fish", False ),
 			( "dogcollar", "dog collar", False ),
 			( "a1", "*1 b2", True ),
+			( "a", "a*b a", True ),
+			( "ab", "a*c ab", True ),
 		] :
 
 			self.assertEqual( Gaffer.matchMultiple( s, p ), r )
+			self.assertEqual( Gaffer.CompiledMatchPattern( p, multiple = True ).match( s ), r )
 
 	def testHasWildcards( self ) :
 
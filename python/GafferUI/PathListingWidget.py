@@ -108,7 +108,7 @@ class PathListingWidget( GafferUI.Widget ) :
 
 		# install an empty model, so we an construct our selection model
 		# around it. we'll update the model contents shortly in setPath().
-		_GafferUI._pathListingWidgetUpdateModel( GafferUI._qtAddress( self._qtWidget() ), None )
+		_GafferUI._pathListingWidgetUpdateModel( GafferUI._qtAddress( self._qtWidget() ), None, True )
 		_GafferUI._pathListingWidgetSetColumns( GafferUI._qtAddress( self._qtWidget() ), columns )
 
 		self.__selectionModel = QtGui.QItemSelectionModel( self._qtWidget().model() )
@@ -370,7 +370,11 @@ class PathListingWidget( GafferUI.Widget ) :
 				if self.getDisplayMode() == self.DisplayMode.Tree :
 					expandedPaths = self.getExpandedPaths()
 
-			_GafferUI._pathListingWidgetUpdateModel( GafferUI._qtAddress( self._qtWidget() ), dirPath.copy() )
+			_GafferUI._pathListingWidgetUpdateModel(
+				GafferUI._qtAddress( self._qtWidget() ),
+				dirPath.copy(),
+				_canEvaluateInBackground( dirPath ),
+			)
 
 			if expandedPaths is not None :
 				self.setExpandedPaths( expandedPaths )
@@ -550,6 +554,34 @@ class PathListingWidget( GafferUI.Widget ) :
 
 # Private implementation - a QTreeView with some specific size behaviour, and shift
 # clicking for recursive expand/collapse.
+# The model may only evaluate children in the background if that can't
+# conflict with anything happening on the UI thread. Paths and PathFilters
+# implemented in Python can only be evaluated while holding the GIL, and
+# those which evaluate the node graph (such as GafferScene.ScenePath) may
+# not run while the graph is being edited. We therefore only use the
+# background for the C++ classes in the core Gaffer module, which don't
+# depend on the node graph, and evaluate everything else on the UI thread.
+def _canEvaluateInBackground( path ) :
+
+	def isCore( o ) :
+
+		return type( o ).__module__.rpartition( "." )[2] == "_Gaffer"
+
+	if not isCore( path ) :
+		return False
+
+	filters = [ path.getFilter() ]
+	while filters :
+		f = filters.pop()
+		if f is None :
+			continue
+		if not isCore( f ) :
+			return False
+		if isinstance( f, Gaffer.CompoundPathFilter ) :
+			filters.extend( f.getFilters() )
+
+	return True
+
 class _TreeView( QtGui.QTreeView ) :
 
 	# This signal is called when some items are either collapsed or
@@ -583,6 +615,11 @@ class _TreeView( QtGui.QTreeView ) :
 		QtGui.QTreeView.setModel( self, model )
 
 		model.modelReset.connect( self.__recalculateColumnSizes )
+		# Children are evaluated in the background and
+		# added progressively. The model signals that the
+		# headers have changed once they have all arrived,
+		# at which point we resize to fit them.
+		model.headerDataChanged.connect( self.__headerDataChanged )
 
 		self.__recalculateColumnSizes()
 
@@ -670,6 +707,10 @@ class _TreeView( QtGui.QTreeView ) :
 
 		self.__recalculatingColumnWidths = False
 
+	def __headerDataChanged( self, orientation, first, last ) :
+
+		self.__recalculateColumnSizes()
+
 	def __sectionResized( self, index, oldWidth, newWidth ) :
 
 		if self.__recalculatingColumnWidths :
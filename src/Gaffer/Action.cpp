@@ -95,6 +95,11 @@ void Action::undoAction()
 	m_done = false;
 }
 
+size_t Action::memoryUsage() const
+{
+	return sizeof( *this );
+}
+
 bool Action::canMerge( const Action *other ) const
 {
 	return true;
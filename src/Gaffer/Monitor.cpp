@@ -60,6 +60,14 @@ void Monitor::setActive( bool active )
 	}
 }
 
+void Monitor::cacheStored( const Process *process, const IECore::MurmurHash &hash, size_t cost )
+{
+}
+
+void Monitor::cacheRemoved( const IECore::MurmurHash &hash, bool cleared )
+{
+}
+
 bool Monitor::getActive() const
 {
 	return Process::monitorRegistered( this );
@@ -203,6 +203,74 @@ struct HashesPerComputeMetric
 
 };
 
+struct CacheCountMetric
+{
+
+	typedef size_t ResultType;
+
+	ResultType operator() ( const PerformanceMonitor::Statistics &s ) const
+	{
+		return s.cacheCount;
+	}
+
+	const char *description() const
+	{
+		return "number of results held in the compute cache";
+	}
+
+};
+
+struct CacheMemoryMetric
+{
+
+	typedef size_t ResultType;
+
+	ResultType operator() ( const PerformanceMonitor::Statistics &s ) const
+	{
+		return s.cacheMemory;
+	}
+
+	const char *description() const
+	{
+		return "bytes held in the compute cache";
+	}
+
+};
+
+struct EvictionCountMetric
+{
+
+	typedef size_t ResultType;
+
+	ResultType operator() ( const PerformanceMonitor::Statistics &s ) const
+	{
+		return s.evictionCount;
+	}
+
+	const char *description() const
+	{
+		return "number of results evicted from the compute cache";
+	}
+
+};
+
+struct RecomputeCountMetric
+{
+
+	typedef size_t ResultType;
+
+	ResultType operator() ( const PerformanceMonitor::Statistics &s ) const
+	{
+		return s.recomputeCount;
+	}
+
+	const char *description() const
+	{
+		return "number of results recomputed after eviction";
+	}
+
+};
+
 // Utility for invoking a templated functor with a particular metric.
 template<typename F>
 typename F::ResultType dispatchMetric( const F &f, PerformanceMetric performanceMetric )
@@ -225,6 +293,14 @@ typename F::ResultType dispatchMetric( const F &f, PerformanceMetric performance
 			return f( PerComputeDurationMetric() );
 		case HashesPerCompute :
 			return f( HashesPerComputeMetric() );
+		case CacheCount :
+			return f( CacheCountMetric() );
+		case CacheMemory :
+			return f( CacheMemoryMetric() );
+		case EvictionCount :
+			return f( EvictionCountMetric() );
+		case RecomputeCount :
+			return f( RecomputeCountMetric() );
 		default :
 			return f( InvalidMetric() );
 	}
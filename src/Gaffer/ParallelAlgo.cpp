@@ -0,0 +1,100 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include <vector>
+
+#include "tbb/enumerable_thread_specific.h"
+
+#include "Gaffer/ParallelAlgo.h"
+
+#if TBB_INTERFACE_VERSION < 10000
+
+using namespace Gaffer::Detail;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+struct IsolationArenas
+{
+
+	IsolationArenas()
+		:	depth( 0 )
+	{
+	}
+
+	// Indexed by nesting depth. We deliberately never delete
+	// these, because the TBB scheduler may already have been
+	// shut down by the time static destructors are run.
+	std::vector<tbb::task_arena *> arenas;
+	size_t depth;
+
+};
+
+typedef tbb::enumerable_thread_specific<IsolationArenas> ThreadIsolationArenas;
+
+ThreadIsolationArenas &threadIsolationArenas()
+{
+	static ThreadIsolationArenas *a = new ThreadIsolationArenas;
+	return *a;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// IsolationArenaScope
+//////////////////////////////////////////////////////////////////////////
+
+IsolationArenaScope::IsolationArenaScope()
+{
+	IsolationArenas &a = threadIsolationArenas().local();
+	if( a.depth == a.arenas.size() )
+	{
+		a.arenas.push_back( new tbb::task_arena );
+	}
+	m_arena = a.arenas[a.depth++];
+}
+
+IsolationArenaScope::~IsolationArenaScope()
+{
+	threadIsolationArenas().local().depth--;
+}
+
+#endif // TBB_INTERFACE_VERSION < 10000
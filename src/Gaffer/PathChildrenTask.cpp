@@ -0,0 +1,308 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "boost/bind.hpp"
+#include "boost/function.hpp"
+#include "boost/thread.hpp"
+
+#include "tbb/atomic.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task.h"
+
+#include "Gaffer/PathChildrenTask.h"
+
+using namespace std;
+using namespace IECore;
+using namespace Gaffer;
+
+//////////////////////////////////////////////////////////////////////////
+// State
+//////////////////////////////////////////////////////////////////////////
+
+struct PathChildrenTask::State
+{
+
+	State( PathPtr path, const PropertyNames &propertyNames, size_t chunkSize )
+		:	path( path ), propertyNames( propertyNames ), chunkSize( std::max( chunkSize, (size_t)1 ) ), status( Running )
+	{
+		cancelled = false;
+	}
+
+	// Sets the final status, unless one has been set already
+	// by a call to cancel().
+	void finish( Status finalStatus, const std::string &finalError = "" )
+	{
+		boost::lock_guard<boost::mutex> lock( mutex );
+		if( status == Running )
+		{
+			status = finalStatus;
+			error = finalError;
+		}
+		statusChanged.notify_all();
+	}
+
+	// Immutable, so may be accessed from the
+	// background task without locking.
+	const PathPtr path;
+	const PropertyNames propertyNames;
+	const size_t chunkSize;
+
+	// Checked by the background task as frequently
+	// as possible, without the overhead of locking.
+	tbb::atomic<bool> cancelled;
+
+	// Protected by the mutex.
+	boost::mutex mutex;
+	boost::condition_variable statusChanged;
+	Status status;
+	Children available;
+	std::string error;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Property evaluation
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+struct PropertyEvaluator
+{
+
+	PropertyEvaluator( const PathChildrenTask::PropertyNames &propertyNames, PathChildrenTask::Children &children, const tbb::atomic<bool> &cancelled )
+		:	m_propertyNames( propertyNames ), m_children( children ), m_cancelled( cancelled )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &range ) const
+	{
+		for( size_t i = range.begin(); i != range.end(); ++i )
+		{
+			if( m_cancelled )
+			{
+				return;
+			}
+			PathChildrenTask::Child &child = m_children[i];
+			for( size_t j = 0, e = m_propertyNames.size(); j < e; ++j )
+			{
+				child.properties[j] = child.path->property( m_propertyNames[j] );
+			}
+		}
+	}
+
+	private :
+
+		const PathChildrenTask::PropertyNames &m_propertyNames;
+		PathChildrenTask::Children &m_children;
+		const tbb::atomic<bool> &m_cancelled;
+
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Background execution
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Runs a function as a TBB task. We enqueue these rather than
+// launching a thread per PathChildrenTask, so that expanding many
+// items in a UI shares the TBB thread pool rather than creating
+// an unbounded number of threads.
+class FunctionTask : public tbb::task
+{
+
+	public :
+
+		FunctionTask( const boost::function<void ()> &function )
+			:	m_function( function )
+		{
+		}
+
+		virtual tbb::task *execute()
+		{
+			m_function();
+			return NULL;
+		}
+
+	private :
+
+		boost::function<void ()> m_function;
+
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// PathChildrenTask
+//////////////////////////////////////////////////////////////////////////
+
+PathChildrenTask::PathChildrenTask( const Path *path, const PropertyNames &propertyNames, size_t chunkSize, bool background )
+	:	m_state( new State( path->copy(), propertyNames, chunkSize ) )
+{
+	// The copy above is made on the calling thread, so the background
+	// task never touches a Path that the caller might be modifying.
+	if( background )
+	{
+		FunctionTask *task = new( tbb::task::allocate_root() ) FunctionTask( boost::bind( &PathChildrenTask::run, m_state, true ) );
+		tbb::task::enqueue( *task );
+	}
+	else
+	{
+		run( m_state, false );
+	}
+}
+
+PathChildrenTask::~PathChildrenTask()
+{
+	cancel();
+}
+
+const PathChildrenTask::PropertyNames &PathChildrenTask::propertyNames() const
+{
+	return m_state->propertyNames;
+}
+
+PathChildrenTask::Status PathChildrenTask::takeChildren( Children &children )
+{
+	boost::lock_guard<boost::mutex> lock( m_state->mutex );
+	if( children.empty() )
+	{
+		children.swap( m_state->available );
+	}
+	else
+	{
+		children.insert( children.end(), m_state->available.begin(), m_state->available.end() );
+		m_state->available.clear();
+	}
+	return m_state->status;
+}
+
+void PathChildrenTask::cancel()
+{
+	m_state->cancelled = true;
+
+	boost::lock_guard<boost::mutex> lock( m_state->mutex );
+	if( m_state->status == Running )
+	{
+		m_state->status = Cancelled;
+		m_state->available.clear();
+		m_state->statusChanged.notify_all();
+	}
+}
+
+PathChildrenTask::Status PathChildrenTask::status() const
+{
+	boost::lock_guard<boost::mutex> lock( m_state->mutex );
+	return m_state->status;
+}
+
+PathChildrenTask::Status PathChildrenTask::wait()
+{
+	boost::unique_lock<boost::mutex> lock( m_state->mutex );
+	while( m_state->status == Running )
+	{
+		m_state->statusChanged.wait( lock );
+	}
+	return m_state->status;
+}
+
+std::string PathChildrenTask::error() const
+{
+	boost::lock_guard<boost::mutex> lock( m_state->mutex );
+	return m_state->error;
+}
+
+void PathChildrenTask::run( StatePtr state, bool parallel )
+{
+	try
+	{
+		std::vector<PathPtr> paths;
+		state->path->children( paths );
+
+		for( size_t begin = 0, size = paths.size(); begin < size; begin += state->chunkSize )
+		{
+			if( state->cancelled )
+			{
+				break;
+			}
+
+			const size_t end = std::min( begin + state->chunkSize, size );
+			Children chunk( end - begin );
+			for( size_t i = begin; i < end; ++i )
+			{
+				Child &child = chunk[i-begin];
+				child.path = paths[i];
+				child.properties.resize( state->propertyNames.size() );
+			}
+
+			if( !state->propertyNames.empty() )
+			{
+				const PropertyEvaluator propertyEvaluator( state->propertyNames, chunk, state->cancelled );
+				const tbb::blocked_range<size_t> range( 0, chunk.size() );
+				if( parallel )
+				{
+					tbb::parallel_for( range, propertyEvaluator );
+				}
+				else
+				{
+					propertyEvaluator( range );
+				}
+			}
+
+			boost::lock_guard<boost::mutex> lock( state->mutex );
+			if( state->status != Running )
+			{
+				break;
+			}
+			state->available.insert( state->available.end(), chunk.begin(), chunk.end() );
+		}
+		state->finish( Completed );
+	}
+	catch( const std::exception &e )
+	{
+		state->finish( Errored, e.what() );
+	}
+	catch( ... )
+	{
+		state->finish( Errored, "Unknown error" );
+	}
+}
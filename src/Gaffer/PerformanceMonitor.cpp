@@ -45,13 +45,16 @@ using namespace Gaffer;
 static IECore::InternedString g_hashType( "computeNode:hash" );
 static IECore::InternedString g_computeType( "computeNode:compute" );
 static PerformanceMonitor::Statistics g_emptyStatistics;
+static const size_t g_maxRemovedCacheEntries = 100000;
 
 //////////////////////////////////////////////////////////////////////////
 // PerformanceMonitor::Statistics
 //////////////////////////////////////////////////////////////////////////
 
-PerformanceMonitor::Statistics::Statistics( size_t hashCount, size_t computeCount, boost::chrono::nanoseconds hashDuration, boost::chrono::nanoseconds computeDuration )
-	:	hashCount( hashCount ), computeCount( computeCount ), hashDuration( hashDuration ), computeDuration( computeDuration )
+PerformanceMonitor::Statistics::Statistics( size_t hashCount, size_t computeCount, boost::chrono::nanoseconds hashDuration, boost::chrono::nanoseconds computeDuration, size_t cacheCount, size_t cacheMemory, size_t evictionCount, size_t recomputeCount, size_t clearCount )
+	:	hashCount( hashCount ), computeCount( computeCount ), hashDuration( hashDuration ), computeDuration( computeDuration ),
+		cacheCount( cacheCount ), cacheMemory( cacheMemory ), evictionCount( evictionCount ), recomputeCount( recomputeCount ),
+		clearCount( clearCount )
 {
 }
 
@@ -61,6 +64,11 @@ PerformanceMonitor::Statistics & PerformanceMonitor::Statistics::operator += ( c
 	computeCount += rhs.computeCount;
 	hashDuration += rhs.hashDuration;
 	computeDuration += rhs.computeDuration;
+	cacheCount += rhs.cacheCount;
+	cacheMemory += rhs.cacheMemory;
+	evictionCount += rhs.evictionCount;
+	recomputeCount += rhs.recomputeCount;
+	clearCount += rhs.clearCount;
 	return *this;
 }
 
@@ -70,7 +78,12 @@ bool PerformanceMonitor::Statistics::operator == ( const Statistics &rhs )
 		hashCount == rhs.hashCount &&
 		computeCount == rhs.computeCount &&
 		hashDuration == rhs.hashDuration &&
-		computeDuration == rhs.computeDuration
+		computeDuration == rhs.computeDuration &&
+		cacheCount == rhs.cacheCount &&
+		cacheMemory == rhs.cacheMemory &&
+		evictionCount == rhs.evictionCount &&
+		recomputeCount == rhs.recomputeCount &&
+		clearCount == rhs.clearCount
 	;
 }
 
@@ -85,6 +98,7 @@ bool PerformanceMonitor::Statistics::operator != ( const Statistics &rhs )
 
 PerformanceMonitor::PerformanceMonitor()
 {
+	m_removedCacheEntries = 0;
 }
 
 PerformanceMonitor::~PerformanceMonitor()
@@ -153,6 +167,79 @@ void PerformanceMonitor::processFinished( const Process *process )
 	threadData.then = now;
 }
 
+void PerformanceMonitor::cacheStored( const Process *process, const IECore::MurmurHash &hash, size_t cost )
+{
+	ThreadData &threadData = m_threadData.local();
+	Statistics &s = threadData.statistics[process->plug()];
+
+	CacheEntries::accessor a;
+	if( !m_cacheEntries.insert( a, hash ) )
+	{
+		if( a->second.removed )
+		{
+			// We saw this result evicted earlier, and it
+			// has just been computed again.
+			s.recomputeCount++;
+			m_removedCacheEntries--;
+		}
+		else
+		{
+			// Already stored and not removed - we don't
+			// expect this, but there's nothing to count.
+			return;
+		}
+	}
+
+	a->second.plug = process->plug();
+	a->second.cost = cost;
+	a->second.removed = false;
+
+	s.cacheCount++;
+	s.cacheMemory += cost;
+}
+
+void PerformanceMonitor::cacheRemoved( const IECore::MurmurHash &hash, bool cleared )
+{
+	CacheEntries::accessor a;
+	if( !m_cacheEntries.find( a, hash ) || a->second.removed )
+	{
+		// Stored before we were active, or already removed.
+		return;
+	}
+
+	// The counts for this thread may temporarily underflow, because
+	// the entry may have been stored on another thread. This is
+	// harmless, as the totals are correct after collate().
+	Statistics &s = m_threadData.local().statistics[a->second.plug];
+	s.cacheCount--;
+	s.cacheMemory -= a->second.cost;
+
+	if( cleared )
+	{
+		// Computing the result again after an explicit clear
+		// isn't a sign of thrashing, so we don't keep a record
+		// with which to detect it.
+		s.clearCount++;
+		m_cacheEntries.erase( a );
+		return;
+	}
+
+	s.evictionCount++;
+
+	// Keep a record of the removal so that we can detect the
+	// result being recomputed, but only up to a limit, so that
+	// a long-running monitor doesn't grow without bound.
+	if( m_removedCacheEntries.fetch_and_increment() < g_maxRemovedCacheEntries )
+	{
+		a->second.removed = true;
+	}
+	else
+	{
+		m_removedCacheEntries--;
+		m_cacheEntries.erase( a );
+	}
+}
+
 void PerformanceMonitor::collate() const
 {
 	tbb::enumerable_thread_specific<ThreadData, tbb::cache_aligned_allocator<ThreadData>, tbb::ets_key_per_instance>::iterator it, eIt;
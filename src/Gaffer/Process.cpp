@@ -126,6 +126,22 @@ void Process::handleException()
 	}
 }
 
+void Process::cacheStored( const IECore::MurmurHash &hash, size_t cost ) const
+{
+	for( Monitors::const_iterator it = g_activeMonitors.begin(), eIt = g_activeMonitors.end(); it != eIt; ++it )
+	{
+		(*it)->cacheStored( this, hash, cost );
+	}
+}
+
+void Process::cacheRemoved( const IECore::MurmurHash &hash, bool cleared )
+{
+	for( Monitors::const_iterator it = g_activeMonitors.begin(), eIt = g_activeMonitors.end(); it != eIt; ++it )
+	{
+		(*it)->cacheRemoved( hash, cleared );
+	}
+}
+
 void Process::emitError( const std::string &error ) const
 {
 	const Plug *plug = m_downstream;
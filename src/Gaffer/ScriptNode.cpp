@@ -86,7 +86,17 @@ class ScriptNode::CompoundAction : public Gaffer::Action
 
 		void addAction( ActionPtr action )
 		{
-			m_actions.push_back( action );
+			// Coalesce consecutive actions where possible, so that
+			// repeated edits to the same plug only hold the first
+			// and last values.
+			if( !m_actions.empty() && m_actions.back()->canMerge( action.get() ) )
+			{
+				m_actions.back()->merge( action.get() );
+			}
+			else
+			{
+				m_actions.push_back( action );
+			}
 		}
 
 		size_t numActions() const
@@ -94,6 +104,16 @@ class ScriptNode::CompoundAction : public Gaffer::Action
 			return m_actions.size();
 		}
 
+		virtual size_t memoryUsage() const
+		{
+			size_t result = Action::memoryUsage() + m_mergeGroup.capacity() + m_actions.capacity() * sizeof( ActionPtr );
+			for( std::vector<ActionPtr>::const_iterator it = m_actions.begin(), eIt = m_actions.end(); it != eIt; ++it )
+			{
+				result += (*it)->memoryUsage();
+			}
+			return result;
+		}
+
 	protected :
 
 		friend class ScriptNode;
@@ -173,7 +193,7 @@ class ScriptNode::CompoundAction : public Gaffer::Action
 			{
 				for( std::vector<ActionPtr>::const_iterator it = compoundAction->m_actions.begin(), eIt = compoundAction->m_actions.end(); it != eIt; ++it )
 				{
-					m_actions.push_back( *it );
+					addAction( *it );
 				}
 			}
 		}
@@ -204,6 +224,8 @@ ScriptNode::ScriptNode( const std::string &name )
 	m_selection( new StandardSet ),
 	m_selectionOrphanRemover( m_selection ),
 	m_undoIterator( m_undoList.end() ),
+	m_undoMemoryLimit( 1024 * 1024 * 1024 ),
+	m_undoMemoryUsage( 0 ),
 	m_currentActionStage( Action::Invalid ),
 	m_context( new Context )
 {
@@ -364,6 +386,10 @@ void ScriptNode::popUndoState()
 	{
 		if( m_actionAccumulator->numActions() )
 		{
+			for( UndoIterator it = m_undoIterator; it != m_undoList.end(); ++it )
+			{
+				m_undoMemoryUsage -= (*it)->memoryUsage();
+			}
 			m_undoList.erase( m_undoIterator, m_undoList.end() );
 
 			bool merged = false;
@@ -372,7 +398,9 @@ void ScriptNode::popUndoState()
 				CompoundAction *lastAction = m_undoList.rbegin()->get();
 				if( lastAction->canMerge( m_actionAccumulator.get() ) )
 				{
+					m_undoMemoryUsage -= lastAction->memoryUsage();
 					lastAction->merge( m_actionAccumulator.get() );
+					m_undoMemoryUsage += lastAction->memoryUsage();
 					merged = true;
 				}
 			}
@@ -380,9 +408,11 @@ void ScriptNode::popUndoState()
 			if( !merged )
 			{
 				m_undoList.insert( m_undoList.end(), m_actionAccumulator );
+				m_undoMemoryUsage += m_actionAccumulator->memoryUsage();
 			}
 
 			m_undoIterator = m_undoList.end();
+			limitUndoMemory();
 
 			if( !merged )
 			{
@@ -403,6 +433,39 @@ void ScriptNode::popUndoState()
 
 }
 
+size_t ScriptNode::getUndoMemoryLimit() const
+{
+	return m_undoMemoryLimit;
+}
+
+void ScriptNode::setUndoMemoryLimit( size_t bytes )
+{
+	m_undoMemoryLimit = bytes;
+	limitUndoMemory();
+}
+
+size_t ScriptNode::undoMemoryUsage() const
+{
+	return m_undoMemoryUsage;
+}
+
+void ScriptNode::limitUndoMemory()
+{
+	// Discard the oldest entries until we're within the limit,
+	// but always keep the most recent one, even if it is over
+	// the limit on its own. We never discard entries which have
+	// been undone, because they are still needed for redo.
+	while(
+		m_undoMemoryUsage > m_undoMemoryLimit &&
+		m_undoList.size() > 1 &&
+		m_undoIterator != m_undoList.begin()
+	)
+	{
+		m_undoMemoryUsage -= m_undoList.front()->memoryUsage();
+		m_undoList.pop_front();
+	}
+}
+
 bool ScriptNode::undoAvailable() const
 {
 	return m_currentActionStage == Action::Invalid && m_undoIterator != m_undoList.begin();
@@ -34,6 +34,8 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include "boost/regex.hpp"
 #include "boost/lexical_cast.hpp"
 
@@ -42,6 +44,59 @@
 namespace Gaffer
 {
 
+//////////////////////////////////////////////////////////////////////////
+// CompiledMatchPattern
+//////////////////////////////////////////////////////////////////////////
+
+CompiledMatchPattern::Term::Term( Type type, const std::string &pattern )
+	:	type( type ), pattern( pattern )
+{
+}
+
+CompiledMatchPattern::CompiledMatchPattern( const MatchPattern &pattern, bool multiple )
+{
+	std::vector<std::string> patterns;
+	if( multiple )
+	{
+		tokenize( pattern, ' ', patterns );
+	}
+	if( patterns.empty() )
+	{
+		patterns.push_back( pattern );
+	}
+
+	for( std::vector<std::string>::const_iterator it = patterns.begin(), eIt = patterns.end(); it != eIt; ++it )
+	{
+		const size_t firstStar = it->find( '*' );
+		if( firstStar == std::string::npos )
+		{
+			m_terms.push_back( Term( Term::Literal, *it ) );
+			continue;
+		}
+
+		// Count the stars. A single star at either end gives
+		// us a simple prefix or suffix match.
+		const size_t lastStar = it->rfind( '*' );
+		const size_t numStars = std::count( it->begin(), it->end(), '*' );
+		if( numStars == 1 && lastStar == it->size() - 1 )
+		{
+			m_terms.push_back( Term( Term::Prefix, it->substr( 0, lastStar ) ) );
+		}
+		else if( numStars == 1 && firstStar == 0 )
+		{
+			m_terms.push_back( Term( Term::Suffix, it->substr( 1 ) ) );
+		}
+		else
+		{
+			m_terms.push_back( Term( Term::General, *it ) );
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Numeric suffixes
+//////////////////////////////////////////////////////////////////////////
+
 int numericSuffix( const std::string &s, std::string *stem )
 {
 	static boost::regex g_regex( "^(.*[^0-9]+)([0-9]+)$" );
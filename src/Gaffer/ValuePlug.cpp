@@ -77,6 +77,37 @@ inline const ValuePlug *sourcePlug( const ValuePlug *p )
 	return p;
 }
 
+// Returns a copy of the current context with any variables which
+// the node has declared irrelevant to `plug` removed, or NULL if
+// the current context can be used unchanged.
+Gaffer::ContextPtr ignoredVariablesRemoved( const ComputeNode *node, const ValuePlug *plug )
+{
+	const std::vector<IECore::InternedString> *ignored = node->ignoredContextVariables( plug );
+	if( !ignored )
+	{
+		return NULL;
+	}
+
+	const Context *context = Context::current();
+	ContextPtr result;
+	for( std::vector<IECore::InternedString>::const_iterator it = ignored->begin(), eIt = ignored->end(); it != eIt; ++it )
+	{
+		if( !context->get<IECore::Data>( *it, NULL ) )
+		{
+			continue;
+		}
+		if( !result )
+		{
+			// Borrowed is OK, because we're only using the
+			// result while the current context remains alive.
+			result = new Context( *context, Context::Borrowed );
+		}
+		result->remove( *it );
+	}
+
+	return result;
+}
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -142,6 +173,16 @@ class ValuePlug::HashProcess : public Process
 				threadData.clearCache = 0;
 			}
 
+			// Strip any context variables the node has declared to be
+			// irrelevant, so that they neither feature in our cache key
+			// nor leak through to upstream hashes.
+			ContextPtr reducedContext;
+			if( const ComputeNode *node = p->ancestor<ComputeNode>() )
+			{
+				reducedContext = ignoredVariablesRemoved( node, p );
+			}
+			Context::Scope reducedScope( reducedContext.get() );
+
 			const CacheKey key( p, Context::current()->hash() );
 			Cache::iterator it = threadData.cache.find( key );
 			if( it != threadData.cache.end() )
@@ -257,7 +298,12 @@ class ValuePlug::ComputeProcess : public Process
 
 		static void setCacheMemoryLimit( size_t bytes )
 		{
-			return g_cache.setMaxCost( bytes );
+			// Any results removed while we apply the new limit
+			// are reported as cleared rather than evicted.
+			bool &clearing = g_clearing.local();
+			clearing = true;
+			g_cache.setMaxCost( bytes );
+			clearing = false;
 		}
 
 		static size_t cacheMemoryUsage()
@@ -309,7 +355,21 @@ class ValuePlug::ComputeProcess : public Process
 				/// overhead, and at some point we'll need to address that.
 				if( !g_cache.get( hash ) )
 				{
-					g_cache.set( hash, process.m_result, process.m_result->memoryUsage() );
+					const size_t cost = process.m_result->memoryUsage();
+					if( g_cache.set( hash, process.m_result, cost ) )
+					{
+						process.cacheStored( hash, cost );
+						if( !g_cache.cached( hash ) )
+						{
+							// The result was evicted before we reported storing
+							// it, either by set() itself or by another thread.
+							// Monitors ignore removals of results they don't know
+							// about, so we report the removal again to make sure
+							// it isn't counted as live. A monitor that has already
+							// seen the removal ignores the repeat.
+							Process::cacheRemoved( hash, false );
+						}
+					}
 				}
 				return process.m_result;
 			}
@@ -360,6 +420,11 @@ class ValuePlug::ComputeProcess : public Process
 					{
 						throw IECore::Exception( boost::str( boost::format( "Unable to compute value for Plug \"%s\" as it has no ComputeNode." ) % plug->fullName() ) );
 					}
+					// Compute in the same reduced context that
+					// HashProcess used, so that the result matches
+					// the hash.
+					ContextPtr reducedContext = ignoredVariablesRemoved( n, plug );
+					Context::Scope reducedScope( reducedContext.get() );
 					// Cast is ok - see comment above.
 					n->compute( const_cast<ValuePlug *>( plug ), Context::current() );
 				}
@@ -384,17 +449,30 @@ class ValuePlug::ComputeProcess : public Process
 			return NULL;
 		}
 
+		static void cacheRemovalCallback( const IECore::MurmurHash &h, const IECore::ConstObjectPtr &value )
+		{
+			// Null values are the placeholders created by
+			// nullGetter(), so we don't report them.
+			if( value )
+			{
+				Process::cacheRemoved( h, g_clearing.local() );
+			}
+		}
+
 		// A cache mapping from ValuePlug::hash() to the result of the previous computation
 		// for that hash. This allows us to cache results for faster repeat evaluation
 		typedef IECorePreview::LRUCache<IECore::MurmurHash, IECore::ConstObjectPtr> Cache;
 		static Cache g_cache;
+		// True for threads currently in setCacheMemoryLimit().
+		static tbb::enumerable_thread_specific<bool> g_clearing;
 
 		IECore::ConstObjectPtr m_result;
 
 };
 
 const IECore::InternedString ValuePlug::ComputeProcess::staticType( "computeNode:compute" );
-ValuePlug::ComputeProcess::Cache ValuePlug::ComputeProcess::g_cache( nullGetter, 1024 * 1024 * 500 );
+ValuePlug::ComputeProcess::Cache ValuePlug::ComputeProcess::g_cache( nullGetter, cacheRemovalCallback, 1024 * 1024 * 500 );
+tbb::enumerable_thread_specific<bool> ValuePlug::ComputeProcess::g_clearing( false );
 
 //////////////////////////////////////////////////////////////////////////
 // SetValueAction implementation
@@ -412,6 +490,20 @@ class ValuePlug::SetValueAction : public Gaffer::Action
 		{
 		}
 
+		virtual size_t memoryUsage() const
+		{
+			size_t result = Action::memoryUsage();
+			if( m_doValue )
+			{
+				result += m_doValue->memoryUsage();
+			}
+			if( m_undoValue )
+			{
+				result += m_undoValue->memoryUsage();
+			}
+			return result;
+		}
+
 	protected :
 
 		virtual GraphComponent *subject() const
@@ -35,6 +35,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "tbb/concurrent_unordered_map.h"
+#include "tbb/enumerable_thread_specific.h"
 
 #include "boost/algorithm/string.hpp"
 #include "boost/filesystem/convenience.hpp"
@@ -712,6 +713,20 @@ class AppleseedAttributes : public IECoreScenePreview::Renderer::AttributesInter
 			}
 		}
 
+		// Alpha maps are applied to the object itself rather
+		// than to the object instance, so prevent sharing.
+		bool canInstanceGeometry() const
+		{
+			return m_alphaMap.empty();
+		}
+
+		// Appends the attributes which affect object conversion.
+		void hashGeometry( MurmurHash &h ) const
+		{
+			h.append( m_meshSmoothNormals );
+			h.append( m_meshSmoothTangents );
+		}
+
 		int m_shadingSamples;
 		int m_mediumPriority;
 		string m_alphaMap;
@@ -750,6 +765,245 @@ class AppleseedAttributes : public IECoreScenePreview::Renderer::AttributesInter
 
 } // namespace
 
+//////////////////////////////////////////////////////////////////////////
+// InstanceCache
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+void computeSmoothNormalsAndTangents( asr::Object *object, bool normals, bool tangents )
+{
+	asr::MeshObject *meshObject = static_cast<asr::MeshObject*>( object );
+
+	if( normals && meshObject->get_vertex_normal_count() == 0 )
+	{
+		asr::compute_smooth_vertex_normals( *meshObject );
+	}
+
+	if( tangents && meshObject->get_vertex_tangent_count() == 0 )
+	{
+		asr::compute_smooth_vertex_tangents( *meshObject );
+	}
+}
+
+/// Used by batch renders to share a single appleseed object between
+/// all primitives with identical geometry, and to defer the insertion
+/// of entities into the main assembly until render() is called. Entities
+/// are accumulated per-thread, so that primitives may be output in
+/// parallel without contending on the project locks.
+class InstanceCache : public RefCounted
+{
+
+	public :
+
+		InstanceCache( asr::Assembly &mainAssembly )
+			:	m_mainAssembly( mainAssembly )
+		{
+		}
+
+		virtual ~InstanceCache()
+		{
+			// Release anything that was never flushed.
+			for( PendingEntities::iterator it = m_pending.begin(), eIt = m_pending.end(); it != eIt; ++it )
+			{
+				it->release();
+			}
+		}
+
+		// Returns the name of an object in the main assembly, suitable for
+		// referencing from an object instance, or an empty string if the
+		// object cannot be shared. Can be called concurrently with other
+		// get() and insert*() calls.
+		string get( const Object *object, const AppleseedAttributes *attributes )
+		{
+			if( !attributes->canInstanceGeometry() )
+			{
+				return "";
+			}
+
+			MurmurHash h = object->hash();
+			attributes->hashGeometry( h );
+
+			Cache::accessor a;
+			if( m_cache.insert( a, h ) )
+			{
+				asf::auto_release_ptr<asr::Object> appleseedObject( ObjectAlgo::convert( object ) );
+				a->second = insertSharedObject( appleseedObject, h, attributes );
+			}
+			return a->second;
+		}
+
+		string get( const vector<const Object *> &samples, const vector<float> &times, float shutterOpenTime, float shutterCloseTime, const AppleseedAttributes *attributes )
+		{
+			if( !attributes->canInstanceGeometry() )
+			{
+				return "";
+			}
+
+			MurmurHash h;
+			for( vector<const Object *>::const_iterator it = samples.begin(), eIt = samples.end(); it != eIt; ++it )
+			{
+				(*it)->hash( h );
+			}
+			for( vector<float>::const_iterator it = times.begin(), eIt = times.end(); it != eIt; ++it )
+			{
+				h.append( *it );
+			}
+			h.append( shutterOpenTime );
+			h.append( shutterCloseTime );
+			attributes->hashGeometry( h );
+
+			Cache::accessor a;
+			if( m_cache.insert( a, h ) )
+			{
+				asf::auto_release_ptr<asr::Object> appleseedObject( ObjectAlgo::convert( samples, times, shutterOpenTime, shutterCloseTime ) );
+				a->second = insertSharedObject( appleseedObject, h, attributes );
+			}
+			return a->second;
+		}
+
+		// The insert*() methods queue entities for insertion into
+		// the main assembly by the next call to flush(). They can
+		// be called concurrently with each other and with get().
+
+		void insertObject( asf::auto_release_ptr<asr::Object> object )
+		{
+			m_pending.local().objects.push_back( object.release() );
+		}
+
+		void insertObjectInstance( asf::auto_release_ptr<asr::ObjectInstance> objectInstance )
+		{
+			m_pending.local().objectInstances.push_back( objectInstance.release() );
+		}
+
+		void insertAssembly( asf::auto_release_ptr<asr::Assembly> assembly )
+		{
+			m_pending.local().assemblies.push_back( assembly.release() );
+		}
+
+		void insertAssemblyInstance( asf::auto_release_ptr<asr::AssemblyInstance> assemblyInstance )
+		{
+			m_pending.local().assemblyInstances.push_back( assemblyInstance.release() );
+		}
+
+		void insertSurfaceShader( asf::auto_release_ptr<asr::SurfaceShader> surfaceShader )
+		{
+			m_pending.local().surfaceShaders.push_back( surfaceShader.release() );
+		}
+
+		void insertMaterial( asf::auto_release_ptr<asr::Material> material )
+		{
+			m_pending.local().materials.push_back( material.release() );
+		}
+
+		// Inserts all queued entities into the main assembly.
+		// Must not be called concurrently with anything.
+		void flush()
+		{
+			bool inserted = false;
+			for( PendingEntities::iterator it = m_pending.begin(), eIt = m_pending.end(); it != eIt; ++it )
+			{
+				inserted |= it->flush( m_mainAssembly );
+			}
+
+			if( inserted )
+			{
+				m_mainAssembly.bump_version_id();
+			}
+		}
+
+	private :
+
+		string insertSharedObject( asf::auto_release_ptr<asr::Object> object, const MurmurHash &h, const AppleseedAttributes *attributes )
+		{
+			if( !object.get() )
+			{
+				return "";
+			}
+
+			const string name = "__instance:" + h.toString();
+			object->set_name( name.c_str() );
+			computeSmoothNormalsAndTangents( object.get(), attributes->m_meshSmoothNormals, attributes->m_meshSmoothTangents );
+			insertObject( object );
+			return name;
+		}
+
+		struct Pending
+		{
+
+			vector<asr::Object *> objects;
+			vector<asr::ObjectInstance *> objectInstances;
+			vector<asr::Assembly *> assemblies;
+			vector<asr::AssemblyInstance *> assemblyInstances;
+			vector<asr::SurfaceShader *> surfaceShaders;
+			vector<asr::Material *> materials;
+
+			bool flush( asr::Assembly &assembly )
+			{
+				const bool result =
+					!objects.empty() || !objectInstances.empty() || !assemblies.empty() ||
+					!assemblyInstances.empty() || !surfaceShaders.empty() || !materials.empty()
+				;
+
+				flush( objects, assembly.objects() );
+				flush( objectInstances, assembly.object_instances() );
+				flush( assemblies, assembly.assemblies() );
+				flush( assemblyInstances, assembly.assembly_instances() );
+				flush( surfaceShaders, assembly.surface_shaders() );
+				flush( materials, assembly.materials() );
+
+				return result;
+			}
+
+			void release()
+			{
+				release( objects );
+				release( objectInstances );
+				release( assemblies );
+				release( assemblyInstances );
+				release( surfaceShaders );
+				release( materials );
+			}
+
+			private :
+
+				template<typename EntityType, typename EntityContainer>
+				static void flush( vector<EntityType *> &entities, EntityContainer &container )
+				{
+					for( typename vector<EntityType *>::const_iterator it = entities.begin(), eIt = entities.end(); it != eIt; ++it )
+					{
+						container.insert( asf::auto_release_ptr<EntityType>( *it ) );
+					}
+					entities.clear();
+				}
+
+				template<typename EntityType>
+				static void release( vector<EntityType *> &entities )
+				{
+					for( typename vector<EntityType *>::const_iterator it = entities.begin(), eIt = entities.end(); it != eIt; ++it )
+					{
+						(*it)->release();
+					}
+					entities.clear();
+				}
+
+		};
+
+		typedef tbb::enumerable_thread_specific<Pending> PendingEntities;
+		PendingEntities m_pending;
+
+		typedef tbb::concurrent_hash_map<MurmurHash, string> Cache;
+		Cache m_cache;
+
+		asr::Assembly &m_mainAssembly;
+
+};
+
+IE_CORE_DECLAREPTR( InstanceCache )
+
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 // AppleseedCamera
 //////////////////////////////////////////////////////////////////////////
@@ -816,21 +1070,29 @@ class AppleseedPrimitive : public AppleseedEntity
 
 	public :
 
-		AppleseedPrimitive( asr::Project &project, const string &name, const Object *object, const IECoreScenePreview::Renderer::AttributesInterface *attributes, bool interactiveRender )
+		AppleseedPrimitive( asr::Project &project, const string &name, const Object *object, const IECoreScenePreview::Renderer::AttributesInterface *attributes, bool interactiveRender, InstanceCache *instanceCache )
 			:	AppleseedEntity( project, name, interactiveRender )
 		{
 			init();
+			m_instanceCache = instanceCache;
 
-			// Create the object.
-			m_object = ObjectAlgo::convert( object );
-			m_object->set_name( name.c_str() );
-
-			// Compute smooth normals and tangents if needed.
 			const AppleseedAttributes *appleseedAttributes = static_cast<const AppleseedAttributes*>( attributes );
-			computeSmoothNormalsAndTangents( appleseedAttributes->m_meshSmoothNormals, appleseedAttributes->m_meshSmoothTangents);
+
+			// Reuse an existing object if possible.
+			string objectName = m_instanceCache ? m_instanceCache->get( object, appleseedAttributes ) : "";
+			if( objectName.empty() )
+			{
+				// Create the object.
+				m_object = ObjectAlgo::convert( object );
+				m_object->set_name( name.c_str() );
+				objectName = name;
+
+				// Compute smooth normals and tangents if needed.
+				computeSmoothNormalsAndTangents( m_object, appleseedAttributes->m_meshSmoothNormals, appleseedAttributes->m_meshSmoothTangents );
+			}
 
 			// Create the object instance.
-			createObjectInstance( name );
+			createObjectInstance( objectName );
 
 			// When doing interactive rendering, we put objects into its own assembly
 			// to allow editing the object transform.
@@ -842,21 +1104,29 @@ class AppleseedPrimitive : public AppleseedEntity
 			AppleseedPrimitive::attributes( attributes );
 		}
 
-		AppleseedPrimitive( asr::Project &project, const string &name, const vector<const Object *> &samples, const vector<float> &times, float shutterOpenTime, float shutterCloseTime, const IECoreScenePreview::Renderer::AttributesInterface *attributes, bool interactiveRender )
+		AppleseedPrimitive( asr::Project &project, const string &name, const vector<const Object *> &samples, const vector<float> &times, float shutterOpenTime, float shutterCloseTime, const IECoreScenePreview::Renderer::AttributesInterface *attributes, bool interactiveRender, InstanceCache *instanceCache )
 			:	AppleseedEntity( project, name, interactiveRender )
 		{
 			init();
+			m_instanceCache = instanceCache;
 
-			// Create the object.
-			m_object = ObjectAlgo::convert( samples, times, shutterOpenTime, shutterCloseTime );
-			m_object->set_name( name.c_str() );
-
-			// Compute smooth normals and tangents if needed.
 			const AppleseedAttributes *appleseedAttributes = static_cast<const AppleseedAttributes*>( attributes );
-			computeSmoothNormalsAndTangents( appleseedAttributes->m_meshSmoothNormals, appleseedAttributes->m_meshSmoothTangents );
+
+			// Reuse an existing object if possible.
+			string objectName = m_instanceCache ? m_instanceCache->get( samples, times, shutterOpenTime, shutterCloseTime, appleseedAttributes ) : "";
+			if( objectName.empty() )
+			{
+				// Create the object.
+				m_object = ObjectAlgo::convert( samples, times, shutterOpenTime, shutterCloseTime );
+				m_object->set_name( name.c_str() );
+				objectName = name;
+
+				// Compute smooth normals and tangents if needed.
+				computeSmoothNormalsAndTangents( m_object, appleseedAttributes->m_meshSmoothNormals, appleseedAttributes->m_meshSmoothTangents );
+			}
 
 			// Create the object instance.
-			createObjectInstance( name );
+			createObjectInstance( objectName );
 
 			// When doing interactive rendering, we put objects into its own assembly
 			// to allow editing the object transform.
@@ -915,33 +1185,69 @@ class AppleseedPrimitive : public AppleseedEntity
 					string assemblyName = name() + "_assembly";
 					asf::auto_release_ptr<asr::Assembly> ass( asr::AssemblyFactory().create( assemblyName.c_str() ) );
 
-					// Add the object to the object assembly.
-					ass->objects().insert( asf::auto_release_ptr<asr::Object>( m_object ) );
+					// Add the object to the object assembly. Shared objects
+					// already live in the main assembly, where they will be
+					// found by the object instance.
+					if( m_object )
+					{
+						ass->objects().insert( asf::auto_release_ptr<asr::Object>( m_object ) );
+					}
 
 					// Add the object instance to the object assembly.
 					ass->object_instances().insert( asf::auto_release_ptr<asr::ObjectInstance>( m_objectInstance ) );
 
 					// Add the object assembly to the main assembly.
-					insertAssembly( ass );
+					if( m_instanceCache )
+					{
+						m_instanceCache->insertAssembly( ass );
+					}
+					else
+					{
+						insertAssembly( ass );
+					}
 
 					// Create an instance of the object assembly and add it to the main assembly.
 					string assemblyInstanceName = assemblyName + "_instance";
 					asf::auto_release_ptr<asr::AssemblyInstance> assInstance( asr::AssemblyInstanceFactory::create( assemblyInstanceName.c_str(), asr::ParamArray(), assemblyName.c_str() ) );
 					assInstance->transform_sequence() = m_transformSequence;
-					insertAssemblyInstance( assInstance );
+					if( m_instanceCache )
+					{
+						m_instanceCache->insertAssemblyInstance( assInstance );
+					}
+					else
+					{
+						insertAssemblyInstance( assInstance );
+					}
 				}
 				else
 				{
 					// The object does not have transformation motion blur.
 					// In this case, it's more efficient to put it in the main assembly.
-					insertObject( asf::auto_release_ptr<asr::Object>( m_object ) );
+					if( m_object )
+					{
+						if( m_instanceCache )
+						{
+							m_instanceCache->insertObject( asf::auto_release_ptr<asr::Object>( m_object ) );
+						}
+						else
+						{
+							insertObject( asf::auto_release_ptr<asr::Object>( m_object ) );
+						}
+					}
 
 					// To update the transform, we have to create a new object instance.
 					asf::auto_release_ptr<asr::ObjectInstance> newObjInstance;
 					newObjInstance = asr::ObjectInstanceFactory::create( m_objectInstance->get_name(), m_objectInstance->get_parameters(), m_objectInstance->get_object_name(), m_transformSequence.get_earliest_transform(), m_objectInstance->get_front_material_mappings(), m_objectInstance->get_back_material_mappings() );
 					m_objectInstance->release();
 					m_objectInstance = newObjInstance.get();
-					insertObjectInstance( newObjInstance );
+					if( m_instanceCache )
+					{
+						m_instanceCache->insertObjectInstance( newObjInstance );
+					}
+					else
+					{
+						insertObjectInstance( newObjInstance );
+					}
 				}
 			}
 		}
@@ -996,7 +1302,14 @@ class AppleseedPrimitive : public AppleseedEntity
 				asf::auto_release_ptr<asr::SurfaceShader> surfaceShader;
 				surfaceShader = asr::PhysicalSurfaceShaderFactory().create( surfaceShaderName.c_str(), params );
 				m_surfaceShader = surfaceShader.get();
-				insertSurfaceShader( surfaceShader );
+				if( m_instanceCache )
+				{
+					m_instanceCache->insertSurfaceShader( surfaceShader );
+				}
+				else
+				{
+					insertSurfaceShader( surfaceShader );
+				}
 
 				// Create a material.
 				string materialName = name() + "_material";
@@ -1007,7 +1320,14 @@ class AppleseedPrimitive : public AppleseedEntity
 				asf::auto_release_ptr<asr::Material> material;
 				material = asr::OSLMaterialFactory().create( materialName.c_str(), params );
 				m_material = material.get();
-				insertMaterial( material );
+				if( m_instanceCache )
+				{
+					m_instanceCache->insertMaterial( material );
+				}
+				else
+				{
+					insertMaterial( material );
+				}
 
 				// Assign the material to the object instance.
 				m_objectInstance->assign_material( "default", asr::ObjectInstance::FrontSide, materialName.c_str() );
@@ -1044,6 +1364,7 @@ class AppleseedPrimitive : public AppleseedEntity
 			m_objectInstance = NULL;
 			m_surfaceShader = NULL;
 			m_material = NULL;
+			m_instanceCache = NULL;
 		}
 
 		void clearMaterial()
@@ -1065,21 +1386,6 @@ class AppleseedPrimitive : public AppleseedEntity
 			}
 		}
 
-		void computeSmoothNormalsAndTangents( bool normals, bool tangents )
-		{
-			asr::MeshObject *meshObject = static_cast<asr::MeshObject*>( m_object );
-
-			if( normals && meshObject->get_vertex_normal_count() == 0 )
-			{
-				asr::compute_smooth_vertex_normals( *meshObject );
-			}
-
-			if( tangents && meshObject->get_vertex_tangent_count() == 0 )
-			{
-				asr::compute_smooth_vertex_tangents( *meshObject );
-			}
-		}
-
 		void createObjectInstance( const string &objectName )
 		{
 			string objectInstanceName = name() + "_instance";
@@ -1209,6 +1515,9 @@ class AppleseedPrimitive : public AppleseedEntity
 		AppleseedShaderPtr m_shaderGroup;
 		asr::SurfaceShader *m_surfaceShader;
 		asr::Material *m_material;
+
+		// Only used by batch renders.
+		InstanceCache *m_instanceCache;
 };
 
 boost::mutex AppleseedPrimitive::g_geomFilesMutex;
@@ -1553,6 +1862,13 @@ class AppleseedRenderer : public IECoreScenePreview::Renderer
 
 			// Create the shader cache.
 			m_shaderCache.reset( new ShaderCache( *m_project, isInteractiveRender() ) );
+
+			// Create the instance cache. Interactive renders need to
+			// edit and remove objects individually, so are excluded.
+			if( m_renderType == Batch )
+			{
+				m_instanceCache.reset( new InstanceCache( *m_project->get_scene()->assemblies().get_by_name( "assembly" ) ) );
+			}
 		}
 
 		virtual ~AppleseedRenderer()
@@ -1926,7 +2242,7 @@ class AppleseedRenderer : public IECoreScenePreview::Renderer
 			}
 			else
 			{
-				return new AppleseedPrimitive( *m_project, name, object, attributes, m_renderType == Interactive );
+				return new AppleseedPrimitive( *m_project, name, object, attributes, m_renderType == Interactive, m_instanceCache.get() );
 			}
 		}
 
@@ -1943,7 +2259,7 @@ class AppleseedRenderer : public IECoreScenePreview::Renderer
 			}
 			else
 			{
-				return new AppleseedPrimitive( *m_project, name, samples, times, m_shutterOpenTime, m_shutterCloseTime, attributes, m_renderType == Interactive );
+				return new AppleseedPrimitive( *m_project, name, samples, times, m_shutterOpenTime, m_shutterCloseTime, attributes, m_renderType == Interactive, m_instanceCache.get() );
 			}
 		}
 
@@ -1993,6 +2309,12 @@ class AppleseedRenderer : public IECoreScenePreview::Renderer
 			// Clear unused shaders.
 			m_shaderCache->clearUnused();
 
+			// Insert any entities queued by batch output.
+			if( m_instanceCache )
+			{
+				m_instanceCache->flush();
+			}
+
 			// Launch render.
 			if( m_renderType == SceneDescription )
 			{
@@ -2244,6 +2566,7 @@ class AppleseedRenderer : public IECoreScenePreview::Renderer
 		bool m_environmentEDFVisible;
 
 		ShaderCachePtr m_shaderCache;
+		InstanceCachePtr m_instanceCache;
 
 		// Members used by interactive and batch renders
 
@@ -50,7 +50,9 @@ namespace GafferBindings
 
 void bindAction()
 {
-	scope s = IECorePython::RefCountedClass<Action, IECore::RefCounted>( "Action" );
+	scope s = IECorePython::RefCountedClass<Action, IECore::RefCounted>( "Action" )
+		.def( "memoryUsage", &Action::memoryUsage )
+	;
 
 	enum_<Action::Stage>( "Stage" )
 		.value( "Invalid", Action::Invalid )
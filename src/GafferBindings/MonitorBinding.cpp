@@ -64,11 +64,16 @@ void exitScope( Monitor &m, object type, object value, object traceBack )
 std::string repr( PerformanceMonitor::Statistics &s )
 {
 	return boost::str(
-		boost::format( "Gaffer.PerformanceMonitor.Statistics( hashCount = %d, computeCount = %d, hashDuration = %d, computeDuration = %d )" )
+		boost::format( "Gaffer.PerformanceMonitor.Statistics( hashCount = %d, computeCount = %d, hashDuration = %d, computeDuration = %d, cacheCount = %d, cacheMemory = %d, evictionCount = %d, recomputeCount = %d, clearCount = %d )" )
 			% s.hashCount
 			% s.computeCount
 			% s.hashDuration.count()
 			% s.computeDuration.count()
+			% s.cacheCount
+			% s.cacheMemory
+			% s.evictionCount
+			% s.recomputeCount
+			% s.clearCount
 	);
 }
 
@@ -76,10 +81,18 @@ PerformanceMonitor::Statistics *statisticsConstructor(
 	size_t hashCount,
 	size_t computeCount,
 	boost::chrono::nanoseconds::rep hashDuration,
-	boost::chrono::nanoseconds::rep computeDuration
+	boost::chrono::nanoseconds::rep computeDuration,
+	size_t cacheCount,
+	size_t cacheMemory,
+	size_t evictionCount,
+	size_t recomputeCount,
+	size_t clearCount
 )
 {
-	return new PerformanceMonitor::Statistics( hashCount, computeCount, boost::chrono::nanoseconds( hashDuration ), boost::chrono::nanoseconds( computeDuration ) );
+	return new PerformanceMonitor::Statistics(
+		hashCount, computeCount, boost::chrono::nanoseconds( hashDuration ), boost::chrono::nanoseconds( computeDuration ),
+		cacheCount, cacheMemory, evictionCount, recomputeCount, clearCount
+	);
 }
 
 boost::chrono::nanoseconds::rep getHashDuration( PerformanceMonitor::Statistics &s )
@@ -128,6 +141,10 @@ void GafferBindings::bindMonitor()
 		.value( "PerHashDuration", PerHashDuration )
 		.value( "PerComputeDuration", PerComputeDuration )
 		.value( "HashesPerCompute", HashesPerCompute )
+		.value( "CacheCount", CacheCount )
+		.value( "CacheMemory", CacheMemory )
+		.value( "EvictionCount", EvictionCount )
+		.value( "RecomputeCount", RecomputeCount )
 	;
 
 	def(
@@ -167,7 +184,12 @@ void GafferBindings::bindMonitor()
 					arg( "hashCount" ) = 0,
 					arg( "computeCount" ) = 0,
 					arg( "hashDuration" ) = 0,
-					arg( "computeDuration" ) = 0
+					arg( "computeDuration" ) = 0,
+					arg( "cacheCount" ) = 0,
+					arg( "cacheMemory" ) = 0,
+					arg( "evictionCount" ) = 0,
+					arg( "recomputeCount" ) = 0,
+					arg( "clearCount" ) = 0
 				)
 			)
 		)
@@ -175,6 +197,11 @@ void GafferBindings::bindMonitor()
 		.def_readwrite( "computeCount", &PerformanceMonitor::Statistics::computeCount )
 		.add_property( "hashDuration", &getHashDuration, &setHashDuration )
 		.add_property( "computeDuration", &getComputeDuration, &setComputeDuration )
+		.def_readwrite( "cacheCount", &PerformanceMonitor::Statistics::cacheCount )
+		.def_readwrite( "cacheMemory", &PerformanceMonitor::Statistics::cacheMemory )
+		.def_readwrite( "evictionCount", &PerformanceMonitor::Statistics::evictionCount )
+		.def_readwrite( "recomputeCount", &PerformanceMonitor::Statistics::recomputeCount )
+		.def_readwrite( "clearCount", &PerformanceMonitor::Statistics::clearCount )
 		.def( self == self )
 		.def( self != self )
 		.def( "__repr__", &repr )
@@ -438,6 +438,9 @@ void GafferBindings::bindScriptNode()
 		.def( "currentActionStage", &ScriptNode::currentActionStage )
 		.def( "actionSignal", &ScriptNode::actionSignal, boost::python::return_internal_reference<1>() )
 		.def( "undoAddedSignal", &ScriptNode::undoAddedSignal, boost::python::return_internal_reference<1>() )
+		.def( "getUndoMemoryLimit", &ScriptNode::getUndoMemoryLimit )
+		.def( "setUndoMemoryLimit", &ScriptNode::setUndoMemoryLimit )
+		.def( "undoMemoryUsage", &ScriptNode::undoMemoryUsage )
 		.def( "copy", &ScriptNode::copy, ( boost::python::arg( "parent" ) = boost::python::object(), boost::python::arg( "filter" ) = boost::python::object() ) )
 		.def( "cut", &ScriptNode::cut, ( boost::python::arg( "parent" ) = boost::python::object(), boost::python::arg( "filter" ) = boost::python::object() ) )
 		.def( "paste", &ScriptNode::paste, ( boost::python::arg( "parent" ) = boost::python::object() ) )
@@ -41,6 +41,7 @@
 #include "GafferBindings/StringAlgoBinding.h"
 
 using namespace boost::python;
+using namespace Gaffer;
 
 namespace GafferBindings
 {
@@ -50,6 +51,10 @@ void bindStringAlgo()
 	def( "match", (bool (*)( const char *, const char * ))&Gaffer::match );
 	def( "matchMultiple", (bool (*)( const char *, const char * ))&Gaffer::matchMultiple );
 	def( "hasWildcards", (bool (*)( const char * ))&Gaffer::hasWildcards );
+
+	class_<CompiledMatchPattern>( "CompiledMatchPattern", init<const MatchPattern &, bool>( ( arg( "pattern" ), arg( "multiple" ) = false ) ) )
+		.def( "match", (bool (CompiledMatchPattern::*)( const char * ) const)&CompiledMatchPattern::match )
+	;
 }
 
 } // namespace GafferBindings
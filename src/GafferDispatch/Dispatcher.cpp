@@ -34,6 +34,8 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/concurrent_unordered_set.h"
+
 #include "boost/filesystem.hpp"
 
 #include "IECore/FrameRange.h"
@@ -43,6 +45,7 @@
 #include "Gaffer/ScriptNode.h"
 #include "Gaffer/StringPlug.h"
 #include "Gaffer/SubGraph.h"
+#include "Gaffer/ParallelAlgo.h"
 
 #include "GafferDispatch/Dispatcher.h"
 
@@ -537,6 +540,93 @@ class Dispatcher::Batcher
 
 };
 
+//////////////////////////////////////////////////////////////////////////
+// TaskGraphVisitor class. This visits the tasks for many frames in
+// parallel, with the sole purpose of filling a TaskNode::TaskMemo with
+// their hashes and preTasks. The Batcher must visit the tasks serially
+// to produce deterministic batches, but can then retrieve everything it
+// needs from the memo.
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+class TaskGraphVisitor
+{
+
+	public :
+
+		typedef tbb::concurrent_unordered_set<IECore::MurmurHash> VisitedSet;
+
+		TaskGraphVisitor( const std::vector<TaskNodePtr> &taskNodes, const std::vector<FrameList::Frame> &frames, const Context *context, TaskNode::TaskMemo *memo, VisitedSet &visited )
+			:	m_taskNodes( taskNodes ), m_frames( frames ), m_context( context ), m_memo( memo ), m_visited( visited )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &range ) const
+		{
+			TaskNode::TaskMemo::Scope memoScope( m_memo );
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				ContextPtr frameContext = new Context( *m_context, Context::Borrowed );
+				frameContext->setFrame( m_frames[i] );
+				try
+				{
+					for( std::vector<TaskNodePtr>::const_iterator nIt = m_taskNodes.begin(); nIt != m_taskNodes.end(); ++nIt )
+					{
+						visit( TaskNode::Task( (*nIt)->taskPlug(), frameContext.get() ) );
+					}
+				}
+				catch( ... )
+				{
+					// Failures aren't stored in the memo, so the Batcher
+					// will encounter the same error again, and report it
+					// properly.
+				}
+			}
+		}
+
+	private :
+
+		void visit( const TaskNode::Task &task ) const
+		{
+			// Unlike the Batcher, we only need to visit
+			// each task once.
+			MurmurHash visitedHash = task.context()->hash();
+			visitedHash.append( (uint64_t)task.plug() );
+			if( !m_visited.insert( visitedHash ).second )
+			{
+				return;
+			}
+
+			TaskNode::Tasks preTasks;
+			TaskNode::Tasks postTasks;
+			{
+				Context::Scope scopedTaskContext( task.context() );
+				task.plug()->preTasks( preTasks );
+				task.plug()->postTasks( postTasks );
+			}
+
+			for( TaskNode::Tasks::const_iterator it = postTasks.begin(); it != postTasks.end(); ++it )
+			{
+				visit( *it );
+			}
+			for( TaskNode::Tasks::const_iterator it = preTasks.begin(); it != preTasks.end(); ++it )
+			{
+				visit( *it );
+			}
+		}
+
+		const std::vector<TaskNodePtr> &m_taskNodes;
+		const std::vector<FrameList::Frame> &m_frames;
+		const Context *m_context;
+		TaskNode::TaskMemo *m_memo;
+		VisitedSet &m_visited;
+
+};
+
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 // Dispatcher::dispatch()
 //////////////////////////////////////////////////////////////////////////
@@ -652,12 +742,26 @@ void Dispatcher::dispatch( const std::vector<NodePtr> &nodes ) const
 	frameList->asList( frames );
 
 	Batcher batcher;
-	for( std::vector<FrameList::Frame>::const_iterator fIt = frames.begin(); fIt != frames.end(); ++fIt )
 	{
-		for( std::vector<TaskNodePtr>::const_iterator nIt = taskNodes.begin(); nIt != taskNodes.end(); ++nIt )
+		// Querying tasks can be expensive, and the same tasks are
+		// often reached via many routes through the graph, so we
+		// memoise the queries and visit all the frames in parallel
+		// before batching.
+		TaskNode::TaskMemoPtr memo = new TaskNode::TaskMemo;
+		TaskGraphVisitor::VisitedSet visited;
+		isolatedParallelFor(
+			tbb::blocked_range<size_t>( 0, frames.size(), 1 ),
+			TaskGraphVisitor( taskNodes, frames, context.get(), memo.get(), visited )
+		);
+
+		TaskNode::TaskMemo::Scope memoScope( memo.get() );
+		for( std::vector<FrameList::Frame>::const_iterator fIt = frames.begin(); fIt != frames.end(); ++fIt )
 		{
-			context->setFrame( *fIt );
-			batcher.addTask( TaskNode::Task( *nIt, context.get() ) );
+			for( std::vector<TaskNodePtr>::const_iterator nIt = taskNodes.begin(); nIt != taskNodes.end(); ++nIt )
+			{
+				context->setFrame( *fIt );
+				batcher.addTask( TaskNode::Task( *nIt, context.get() ) );
+			}
 		}
 	}
 
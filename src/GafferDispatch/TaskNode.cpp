@@ -34,6 +34,9 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/concurrent_hash_map.h"
+#include "tbb/enumerable_thread_specific.h"
+
 #include "Gaffer/SubGraph.h"
 #include "Gaffer/Dot.h"
 #include "Gaffer/Context.h"
@@ -98,6 +101,54 @@ bool TaskNode::Task::operator < ( const Task &rhs ) const
 	return ( m_hash < rhs.m_hash );
 }
 
+//////////////////////////////////////////////////////////////////////////
+// TaskMemo implementation
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+tbb::enumerable_thread_specific<TaskNode::TaskMemo *> g_currentMemo( (TaskNode::TaskMemo *)NULL );
+
+} // namespace
+
+struct TaskNode::TaskMemo::Data
+{
+
+	typedef tbb::concurrent_hash_map<MurmurHash, MurmurHash> HashMap;
+	typedef tbb::concurrent_hash_map<MurmurHash, Tasks> TasksMap;
+
+	HashMap hashes;
+	TasksMap preTasks;
+	TasksMap postTasks;
+
+};
+
+TaskNode::TaskMemo::TaskMemo()
+	:	m_data( new Data )
+{
+}
+
+TaskNode::TaskMemo::~TaskMemo()
+{
+}
+
+TaskNode::TaskMemo *TaskNode::TaskMemo::current()
+{
+	return g_currentMemo.local();
+}
+
+TaskNode::TaskMemo::Scope::Scope( TaskMemo *memo )
+	:	m_previous( g_currentMemo.local() )
+{
+	g_currentMemo.local() = memo;
+}
+
+TaskNode::TaskMemo::Scope::~Scope()
+{
+	g_currentMemo.local() = m_previous;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // TaskPlug implementation.
 //////////////////////////////////////////////////////////////////////////
@@ -141,6 +192,43 @@ InternedString TaskNodeProcess::requiresSequenceExecutionProcessType( "taskNode:
 InternedString TaskNodeProcess::preTasksProcessType( "taskNode:preTasks" );
 InternedString TaskNodeProcess::postTasksProcessType( "taskNode:postTasks" );
 
+MurmurHash memoKey( const TaskNode::TaskPlug *plug )
+{
+	MurmurHash result = Context::current()->hash();
+	result.append( (uint64_t)plug );
+	return result;
+}
+
+typedef void (TaskNode::*TasksFunction)( const Context *context, TaskNode::Tasks &tasks ) const;
+
+// Appends the result of `taskNode->*function` to tasks, retrieving it
+// from the memo if it has been computed previously. We don't hold a lock
+// on the memo during the computation, so several threads may compute the
+// same result concurrently - this is harmless, and avoids deadlock in the
+// case of nested computations.
+template<typename Map>
+void memoisedTasks( Map &memo, const TaskNode::TaskPlug *plug, const InternedString &processType, TasksFunction function, TaskNode::Tasks &tasks )
+{
+	const MurmurHash key = memoKey( plug );
+	{
+		typename Map::const_accessor accessor;
+		if( memo.find( accessor, key ) )
+		{
+			tasks.insert( tasks.end(), accessor->second.begin(), accessor->second.end() );
+			return;
+		}
+	}
+
+	TaskNode::Tasks result;
+	{
+		TaskNodeProcess p( processType, plug );
+		(p.taskNode()->*function)( Context::current(), result );
+	}
+
+	memo.insert( typename Map::value_type( key, result ) );
+	tasks.insert( tasks.end(), result.begin(), result.end() );
+}
+
 } // namespace
 
 IE_CORE_DEFINERUNTIMETYPED( TaskNode::TaskPlug );
@@ -199,8 +287,30 @@ PlugPtr TaskNode::TaskPlug::createCounterpart( const std::string &name, Directio
 
 IECore::MurmurHash TaskNode::TaskPlug::hash() const
 {
-	TaskNodeProcess p( TaskNodeProcess::hashProcessType, this );
-	return p.taskNode()->hash( Context::current() );
+	TaskMemo *memo = TaskMemo::current();
+	if( !memo )
+	{
+		TaskNodeProcess p( TaskNodeProcess::hashProcessType, this );
+		return p.taskNode()->hash( Context::current() );
+	}
+
+	const MurmurHash key = memoKey( this );
+	{
+		TaskMemo::Data::HashMap::const_accessor accessor;
+		if( memo->m_data->hashes.find( accessor, key ) )
+		{
+			return accessor->second;
+		}
+	}
+
+	MurmurHash result;
+	{
+		TaskNodeProcess p( TaskNodeProcess::hashProcessType, this );
+		result = p.taskNode()->hash( Context::current() );
+	}
+
+	memo->m_data->hashes.insert( TaskMemo::Data::HashMap::value_type( key, result ) );
+	return result;
 }
 
 void TaskNode::TaskPlug::execute() const
@@ -223,12 +333,24 @@ bool TaskNode::TaskPlug::requiresSequenceExecution() const
 
 void TaskNode::TaskPlug::preTasks( Tasks &tasks ) const
 {
+	if( TaskMemo *memo = TaskMemo::current() )
+	{
+		memoisedTasks( memo->m_data->preTasks, this, TaskNodeProcess::preTasksProcessType, &TaskNode::preTasks, tasks );
+		return;
+	}
+
 	TaskNodeProcess p( TaskNodeProcess::preTasksProcessType, this );
 	return p.taskNode()->preTasks( Context::current(), tasks );
 }
 
 void TaskNode::TaskPlug::postTasks( Tasks &tasks ) const
 {
+	if( TaskMemo *memo = TaskMemo::current() )
+	{
+		memoisedTasks( memo->m_data->postTasks, this, TaskNodeProcess::postTasksProcessType, &TaskNode::postTasks, tasks );
+		return;
+	}
+
 	TaskNodeProcess p( TaskNodeProcess::postTasksProcessType, this );
 	return p.taskNode()->postTasks( Context::current(), tasks );
 }
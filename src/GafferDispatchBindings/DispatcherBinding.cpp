@@ -241,6 +241,9 @@ void dispatch( Dispatcher &dispatcher, object pythonNodes )
 {
 	std::vector<NodePtr> nodes;
 	boost::python::container_utils::extend_container( nodes, pythonNodes );
+	// Release the GIL so that the Dispatcher can query
+	// tasks from multiple threads.
+	ScopedGILRelease gilRelease;
 	dispatcher.dispatch( nodes );
 }
 
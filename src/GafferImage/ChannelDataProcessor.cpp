@@ -108,7 +108,8 @@ bool ChannelDataProcessor::channelEnabled( const std::string &channel ) const
 
 IECore::ConstFloatVectorDataPtr ChannelDataProcessor::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
 {
-	IECore::FloatVectorDataPtr outData = inPlug()->channelData( channelName, tileOrigin )->copy();
+	IECore::FloatVectorDataPtr outData = ImagePlug::tileBuffer();
+	outData->writable() = inPlug()->channelData( channelName, tileOrigin )->readable();
 	processChannelData( context, parent, channelName, outData );
 	return outData;
 }
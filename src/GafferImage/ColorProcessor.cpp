@@ -126,11 +126,14 @@ void ColorProcessor::compute( Gaffer::ValuePlug *output, const Gaffer::Context *
 			ContextPtr tmpContext = new Context( *context, Context::Borrowed );
 			Context::Scope scopedContext( tmpContext.get() );
 			tmpContext->set( ImagePlug::channelNameContextName, string( "R" ) );
-			r = inPlug()->channelDataPlug()->getValue()->copy();
+			r = ImagePlug::tileBuffer();
+			r->writable() = inPlug()->channelDataPlug()->getValue()->readable();
 			tmpContext->set( ImagePlug::channelNameContextName, string( "G" ) );
-			g = inPlug()->channelDataPlug()->getValue()->copy();
+			g = ImagePlug::tileBuffer();
+			g->writable() = inPlug()->channelDataPlug()->getValue()->readable();
 			tmpContext->set( ImagePlug::channelNameContextName, string( "B" ) );
-			b = inPlug()->channelDataPlug()->getValue()->copy();
+			b = ImagePlug::tileBuffer();
+			b->writable() = inPlug()->channelDataPlug()->getValue()->readable();
 		}
 
 		processColorData( context, r.get(), g.get(), b.get() );
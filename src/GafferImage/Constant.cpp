@@ -168,8 +168,8 @@ IECore::ConstFloatVectorDataPtr Constant::computeChannelData( const std::string
 	const int channelIndex = colorIndex( context->get<std::string>( ImagePlug::channelNameContextName ) );
 	const float value = colorPlug()->getChild( channelIndex )->getValue();
 
-	FloatVectorDataPtr result = new FloatVectorData;
-	result->writable().resize( ImagePlug::tileSize() * ImagePlug::tileSize(), value );
+	FloatVectorDataPtr result = ImagePlug::tileBuffer();
+	std::fill( result->writable().begin(), result->writable().end(), value );
 
 	return result;
 }
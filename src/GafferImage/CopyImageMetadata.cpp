@@ -124,16 +124,12 @@ IECore::ConstCompoundObjectPtr CopyImageMetadata::computeProcessedMetadata( cons
 		return inputMetadata;
 	}
 
+	const CompiledMatchPattern pattern( names, /* multiple = */ true );
+
 	IECore::CompoundObjectPtr result = inputMetadata->copy();
 	for ( IECore::CompoundObject::ObjectMap::const_iterator it = copyFrom->members().begin(), eIt = copyFrom->members().end(); it != eIt; ++it )
 	{
-		bool copy = false;
-		if ( matchMultiple( it->first.c_str(), names.c_str() ) != invert )
-		{
-			copy = true;
-		}
-
-		if ( copy )
+		if ( pattern.match( it->first.value() ) != invert )
 		{
 			result->members()[it->first] = it->second;
 		}
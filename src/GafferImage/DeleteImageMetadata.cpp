@@ -111,11 +111,13 @@ IECore::ConstCompoundObjectPtr DeleteImageMetadata::computeProcessedMetadata( co
 		return inputMetadata;
 	}
 
+	const CompiledMatchPattern pattern( names, /* multiple = */ true );
+
 	IECore::CompoundObjectPtr result = new IECore::CompoundObject;
 	for ( IECore::CompoundObject::ObjectMap::const_iterator it = inputMetadata->members().begin(), eIt = inputMetadata->members().end(); it != eIt; ++it )
 	{
 		bool keep = true;
-		if ( matchMultiple( it->first.c_str(), names.c_str() ) != invert )
+		if ( pattern.match( it->first.string() ) != invert )
 		{
 			keep = false;
 		}
@@ -49,6 +49,19 @@ using namespace Gaffer;
 
 IE_CORE_DEFINERUNTIMETYPED( ImageNode );
 
+namespace
+{
+
+std::vector<IECore::InternedString> tileContextVariables()
+{
+	std::vector<IECore::InternedString> result;
+	result.push_back( ImagePlug::channelNameContextName );
+	result.push_back( ImagePlug::tileOriginContextName );
+	return result;
+}
+
+} // namespace
+
 size_t ImageNode::g_firstPlugIndex = 0;
 
 ImageNode::ImageNode( const std::string &name )
@@ -88,6 +101,18 @@ bool ImageNode::enabled() const
 	return enabledPlug()->getValue();
 };
 
+const std::vector<IECore::InternedString> *ImageNode::ignoredContextVariables( const Gaffer::ValuePlug *output ) const
+{
+	const ImagePlug *imagePlug = output->parent<ImagePlug>();
+	if( !imagePlug || output == imagePlug->channelDataPlug() )
+	{
+		return ComputeNode::ignoredContextVariables( output );
+	}
+
+	static const std::vector<IECore::InternedString> g_ignored = tileContextVariables();
+	return &g_ignored;
+}
+
 void ImageNode::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
 	const ImagePlug *imagePlug = output->parent<ImagePlug>();
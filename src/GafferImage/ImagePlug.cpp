@@ -35,6 +35,9 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/atomic.h"
+
 #include "Gaffer/Context.h"
 
 #include "GafferImage/ImagePlug.h"
@@ -225,6 +228,97 @@ const IECore::FloatVectorData *ImagePlug::blackTile()
 	return g_blackTile.get();
 };
 
+//////////////////////////////////////////////////////////////////////////
+// Tile buffer pool
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Bounds the memory held by each thread's pool while idle.
+// At 16k per tile this is 1M per thread.
+const size_t g_maxPooledTileBuffers = 64;
+
+struct TileBufferPool
+{
+
+	TileBufferPool()
+		:	next( 0 )
+	{
+		allocationCount = 0;
+		reuseCount = 0;
+	}
+
+	std::vector<FloatVectorDataPtr> buffers;
+	size_t next;
+	// Atomic only so that tileBufferStatistics() may
+	// read them from another thread - they are only
+	// ever written by the thread owning the pool.
+	tbb::atomic<size_t> allocationCount;
+	tbb::atomic<size_t> reuseCount;
+
+};
+
+typedef tbb::enumerable_thread_specific<TileBufferPool> TileBufferPools;
+
+TileBufferPools &tileBufferPools()
+{
+	static TileBufferPools g_pools;
+	return g_pools;
+}
+
+} // namespace
+
+IECore::FloatVectorDataPtr ImagePlug::tileBuffer()
+{
+	TileBufferPool &pool = tileBufferPools().local();
+	const size_t tileArea = tileSize() * tileSize();
+
+	const size_t numBuffers = pool.buffers.size();
+	for( size_t i = 0; i < numBuffers; ++i )
+	{
+		const size_t index = ( pool.next + i ) % numBuffers;
+		FloatVectorDataPtr &buffer = pool.buffers[index];
+		if( buffer->refCount() == 1 )
+		{
+			// The pool holds the only reference, so nothing else can
+			// be reading from the buffer and it is safe to reuse.
+			// Should the underlying vector still be shared with a
+			// lazy copy, writable() will unshare it for us.
+			pool.next = index + 1;
+			pool.reuseCount++;
+			buffer->writable().resize( tileArea );
+			return buffer;
+		}
+	}
+
+	pool.allocationCount++;
+	FloatVectorDataPtr result = new FloatVectorData;
+	result->writable().resize( tileArea );
+	if( numBuffers < g_maxPooledTileBuffers )
+	{
+		pool.buffers.push_back( result );
+	}
+	return result;
+}
+
+ImagePlug::TileBufferStatistics::TileBufferStatistics()
+	:	allocationCount( 0 ), reuseCount( 0 )
+{
+}
+
+ImagePlug::TileBufferStatistics ImagePlug::tileBufferStatistics()
+{
+	TileBufferStatistics result;
+	const TileBufferPools &pools = tileBufferPools();
+	for( TileBufferPools::const_iterator it = pools.begin(), eIt = pools.end(); it != eIt; ++it )
+	{
+		result.allocationCount += it->allocationCount;
+		result.reuseCount += it->reuseCount;
+	}
+	return result;
+}
+
 bool ImagePlug::acceptsChild( const GraphComponent *potentialChild ) const
 {
 	if( !ValuePlug::acceptsChild( potentialChild ) )
@@ -361,12 +455,28 @@ IECore::ImagePrimitivePtr ImagePlug::image() const
 		imageChannelData.push_back( &(c[0]) );
 	}
 
-	CopyTile copyTile( imageChannelData, channelNames, dataWindow );
-	parallelProcessTiles( this, channelNames, copyTile, dataWindow );
+	image( channelNames, imageChannelData );
 
 	return result;
 }
 
+void ImagePlug::image( const std::vector<std::string> &channelNames, const std::vector<float *> &channelData ) const
+{
+	if( channelNames.size() != channelData.size() )
+	{
+		throw IECore::Exception( "Number of channel buffers does not match number of channel names" );
+	}
+
+	const Box2i dataWindow = dataWindowPlug()->getValue();
+	if( empty( dataWindow ) )
+	{
+		return;
+	}
+
+	CopyTile copyTile( channelData, channelNames, dataWindow );
+	parallelProcessTiles( this, channelNames, copyTile, dataWindow );
+}
+
 IECore::MurmurHash ImagePlug::imageHash() const
 {
 	const Box2i dataWindow = dataWindowPlug()->getValue();
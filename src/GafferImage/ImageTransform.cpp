@@ -316,8 +316,7 @@ IECore::ConstFloatVectorDataPtr ImageTransform::computeChannelData( const std::s
 			samplerRegion
 		);
 
-		FloatVectorDataPtr resultData = new FloatVectorData;
-		resultData->writable().resize( ImagePlug::tileSize() * ImagePlug::tileSize() );
+		FloatVectorDataPtr resultData = ImagePlug::tileBuffer();
 		std::vector<float>::iterator pIt = resultData->writable().begin();
 
 		const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
@@ -316,8 +316,10 @@ IECore::ConstFloatVectorDataPtr Merge::merge( F f, const std::string &channelNam
 			/// the operation for in[1:], even if in[0] is disconnected. In other
 			/// words, shouldn't multiplying a white constant over an unconnected
 			/// in[0] produce black?
-			resultData = channelData->copy();
-			resultAlphaData = alphaData->copy();
+			resultData = ImagePlug::tileBuffer();
+			resultData->writable() = channelData->readable();
+			resultAlphaData = ImagePlug::tileBuffer();
+			resultAlphaData->writable() = alphaData->readable();
 			float *B = &resultData->writable().front();
 			float *b = &resultAlphaData->writable().front();
 			for( int y = tileBound.min.y; y < tileBound.max.y; ++y )
@@ -172,8 +172,9 @@ IECore::ConstFloatVectorDataPtr Offset::computeChannelData( const std::string &c
 		const Box2i outTileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
 		const Box2i inBound( outTileBound.min - offset, outTileBound.max - offset );
 
-		FloatVectorDataPtr outData = new FloatVectorData;
-		outData->writable().resize( ImagePlug::tileSize() * ImagePlug::tileSize() );
+		// The input tiles we visit exactly cover `inBound`, so every
+		// pixel of the (uninitialised) output buffer is written below.
+		FloatVectorDataPtr outData = ImagePlug::tileBuffer();
 		float *out = &outData->writable().front();
 
 		V2i inTileOrigin;
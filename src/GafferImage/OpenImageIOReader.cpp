@@ -659,9 +659,8 @@ IECore::ConstFloatVectorDataPtr OpenImageIOReader::computeChannelData( const std
 	);
 
 	// Create the output data buffer.
-	FloatVectorDataPtr resultData = new FloatVectorData;
+	FloatVectorDataPtr resultData = ImagePlug::tileBuffer();
 	vector<float> &result = resultData->writable();
-	result.resize( ImagePlug::tileSize() * ImagePlug::tileSize() );
 
 	// Flip the tile in the Y axis to convert it to our internal image data representation.
 	for( int y = 0; y < ImagePlug::tileSize(); ++y )
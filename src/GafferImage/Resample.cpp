@@ -35,10 +35,13 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <iostream>
+#include <algorithm>
 
 #include "OpenImageIO/fmath.h"
 #include "OpenImageIO/filter.h"
 
+#include "IECore/LRUCache.h"
+
 #include "Gaffer/Context.h"
 #include "Gaffer/StringPlug.h"
 
@@ -247,33 +250,170 @@ Filter2DPtr createFilter( const std::string &name, const V2f &filterWidth, const
 	throw Exception( boost::str( boost::format( "Unknown filter \"%s\"" ) % filterName ) );
 }
 
-// Precomputes all the filter weights for a whole row or column of a tile. For separable
-// filters these weights can then be reused across all rows/columns in the same tile.
-/// \todo The weights computed for a particular tile could also be reused for all
-/// tiles in the same tile column or row. We could achieve this by outputting
-/// the weights on an internal plug, and using Gaffer's caching to ensure they are
-/// only computed once and then reused. At the time of writing, profiles indicate that
-/// accessing pixels via the Sampler is the main bottleneck, but once that is optimised
-/// perhaps cached filter weights could have a benefit.
-void filterWeights( const OIIO::Filter2D *filter, const int filterRadius, const int x, const float ratio, const float offset, Passes pass, std::vector<float> &weights )
+// Filter weights for all the output pixels in a single row or column of a
+// tile. Each output pixel is the weighted sum of `support` consecutive
+// input pixels, starting at `inputStart[i]`, divided by `totalWeight[i]`.
+// For integer downsampling ratios every output pixel has the same weights,
+// so we store only a single set and set `uniform`.
+struct FilterTable : public IECore::RefCounted
+{
+
+	int support;
+	bool uniform;
+	std::vector<int> inputStart;
+	std::vector<float> weights;
+	std::vector<float> totalWeight;
+
+	const float *pixelWeights( int i ) const
+	{
+		return &weights[uniform ? 0 : i * support];
+	}
+
+	// The range of input pixels referenced by the table.
+	int inputBegin() const
+	{
+		return inputStart.front();
+	}
+
+	int inputEnd() const
+	{
+		return inputStart.back() + support;
+	}
+
+};
+
+IE_CORE_DECLAREPTR( FilterTable );
+
+// The weights depend only on the filter, the ratio and offset along the axis
+// in question, and the position of the tile along that axis. They can therefore
+// be shared by all tiles in the same tile column (for the horizontal pass) or
+// tile row (for the vertical pass), and by all channels. We cache them here
+// so they are only computed once.
+struct FilterTableKey
 {
-	weights.reserve( ( 2 * filterRadius + 1 ) * ImagePlug::tileSize() );
+
+	FilterTableKey()
+	{
+	}
+
+	FilterTableKey( const std::string &filter, const V2f &filterWidth, const V2f &ratio, float offset, int origin, Passes pass )
+		:	filter( filter ), filterWidth( filterWidth ), ratio( ratio ), offset( offset ), origin( origin ), pass( pass )
+	{
+	}
+
+	bool operator == ( const FilterTableKey &rhs ) const
+	{
+		return
+			filter == rhs.filter &&
+			filterWidth == rhs.filterWidth &&
+			ratio == rhs.ratio &&
+			offset == rhs.offset &&
+			origin == rhs.origin &&
+			pass == rhs.pass
+		;
+	}
+
+	std::string filter;
+	V2f filterWidth;
+	V2f ratio;
+	float offset;
+	int origin;
+	Passes pass;
+
+};
+
+inline size_t tbb_hasher( const FilterTableKey &key )
+{
+	IECore::MurmurHash h;
+	h.append( key.filter );
+	h.append( key.filterWidth );
+	h.append( key.ratio );
+	h.append( key.offset );
+	h.append( key.origin );
+	h.append( (int)key.pass );
+	return tbb_hasher( h );
+}
+
+ConstFilterTablePtr filterTableGetter( const FilterTableKey &key, size_t &cost )
+{
+	const Filter2DPtr filter = createFilter( key.filter, key.filterWidth, key.ratio );
+	const float ratio = key.pass == Horizontal ? key.ratio.x : key.ratio.y;
+	const int filterRadius = key.pass == Horizontal ? inputFilterRadius( filter.get(), key.ratio ).x : inputFilterRadius( filter.get(), key.ratio ).y;
+
+	FilterTablePtr result = new FilterTable;
+	result->support = 2 * filterRadius + 1;
+
+	// When downsampling by an integer ratio, the fractional part of
+	// the input position is identical for every output pixel, so they
+	// can all share the same weights.
+	const float inverseRatio = 1.0f / ratio;
+	result->uniform = ratio <= 1.0f && inverseRatio == floorf( inverseRatio );
+
+	const int numWeightSets = result->uniform ? 1 : ImagePlug::tileSize();
+	result->inputStart.reserve( ImagePlug::tileSize() );
+	result->weights.reserve( numWeightSets * result->support );
+	result->totalWeight.reserve( numWeightSets );
 
 	float iX; // input pixel position (floating point)
 	int iXI; // input pixel position (floored to int)
 	float iXF; // fractional part of input pixel position after flooring
-	for( int oX = x, eX = x + ImagePlug::tileSize(); oX < eX; ++oX )
+	for( int oX = key.origin, eX = key.origin + ImagePlug::tileSize(); oX < eX; ++oX )
 	{
-		iX = ( oX + 0.5 ) / ratio + offset;
+		iX = ( oX + 0.5 ) / ratio + key.offset;
 		iXF = OIIO::floorfrac( iX, &iXI );
+		result->inputStart.push_back( iXI - filterRadius );
 
-		int fX; // relative filter position
-		for( fX = -filterRadius; fX<= filterRadius; ++fX )
+		if( (int)result->totalWeight.size() == numWeightSets )
+		{
+			continue;
+		}
+
+		float totalWeight = 0.0f;
+		for( int fX = -filterRadius; fX <= filterRadius; ++fX )
 		{
 			const float f = ratio * (fX - ( iXF - 0.5f ) );
-			const float w = pass == Horizontal ? filter->xfilt( f ) : filter->yfilt( f );
-			weights.push_back( w );
+			const float w = key.pass == Horizontal ? filter->xfilt( f ) : filter->yfilt( f );
+			result->weights.push_back( w );
+			totalWeight += w;
+		}
+		result->totalWeight.push_back( totalWeight );
+	}
+
+	cost = result->weights.size() + result->inputStart.size();
+	return result;
+}
+
+typedef LRUCache<FilterTableKey, ConstFilterTablePtr> FilterTableCache;
+
+// Cost is measured in table entries, so this is a few megabytes.
+FilterTableCache g_filterTableCache( filterTableGetter, 1000000 );
+
+// Convolves `input`, which holds consecutive input pixels starting
+// at `inputOrigin`, to produce a tile's worth of output pixels. The
+// uniform variant is a fast path for integer downsampling ratios,
+// where the weights are the same for every output pixel.
+template<bool Uniform>
+void convolve( const FilterTable &table, const float *input, int inputOrigin, float *output )
+{
+	const int support = table.support;
+	const float *weights = &table.weights[0];
+	for( int i = 0, e = ImagePlug::tileSize(); i < e; ++i )
+	{
+		const float *in = input + ( table.inputStart[i] - inputOrigin );
+		const float *w = Uniform ? weights : weights + i * support;
+		const float totalWeight = table.totalWeight[Uniform ? 0 : i];
+
+		float v = 0.0f;
+		for( int k = 0; k < support; ++k )
+		{
+			if( w[k] == 0.0f )
+			{
+				continue;
+			}
+			v += w[k] * in[k];
 		}
+
+		output[i] = totalWeight != 0.0f ? v / totalWeight : 0.0f;
 	}
 }
 
@@ -532,7 +672,9 @@ IECore::ConstFloatVectorDataPtr Resample::computeChannelData( const std::string
 	V2f ratio, offset;
 	ratioAndOffset( dataWindowPlug()->getValue(), inPlug()->dataWindowPlug()->getValue(), ratio, offset );
 
-	Filter2DPtr filter = createFilter( filterPlug()->getValue(), filterWidthPlug()->getValue(), ratio );
+	const std::string filterName = filterPlug()->getValue();
+	const V2f filterWidth = filterWidthPlug()->getValue();
+	Filter2DPtr filter = createFilter( filterName, filterWidth, ratio );
 	const unsigned passes = requiredPasses( this, parent, filter.get() );
 
 	Sampler sampler(
@@ -545,8 +687,7 @@ IECore::ConstFloatVectorDataPtr Resample::computeChannelData( const std::string
 	const V2i filterRadius = inputFilterRadius( filter.get(), ratio );
 	const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
 
-	FloatVectorDataPtr resultData = new FloatVectorData;
-	resultData->writable().resize( ImagePlug::tileSize() * ImagePlug::tileSize() );
+	FloatVectorDataPtr resultData = ImagePlug::tileBuffer();
 	std::vector<float>::iterator pIt = resultData->writable().begin();
 
 	if( passes == Both )
@@ -595,12 +736,7 @@ IECore::ConstFloatVectorDataPtr Resample::computeChannelData( const std::string
 					}
 				}
 
-				if( totalW != 0.0f )
-				{
-					*pIt = v / totalW;
-				}
-
-				++pIt;
+				*pIt++ = totalW != 0.0f ? v / totalW : 0.0f;
 			}
 		}
 	}
@@ -613,87 +749,79 @@ IECore::ConstFloatVectorDataPtr Resample::computeChannelData( const std::string
 		// debug mode causes this pass to be output directly for inspection.
 
 		// Pixels in the same column share the same filter weights, so
-		// we precompute the weights now to avoid repeating work later.
-		std::vector<float> weights;
-		filterWeights( filter.get(), filterRadius.x, tileBound.min.x, ratio.x, offset.x, Horizontal, weights );
-
-		V2i oP; // output pixel position
-		float iX; // input pixel x coordinate (floating point)
-		int iXI; // input pixel position (floored to int)
-
-		for( oP.y = tileBound.min.y; oP.y < tileBound.max.y; ++oP.y )
+		// we get them from the cache rather than recomputing them for
+		// every tile.
+		ConstFilterTablePtr table = g_filterTableCache.get(
+			FilterTableKey( filterName, filterWidth, ratio, offset.x, tileBound.min.x, Horizontal )
+		);
+
+		// Fetch each input row in one go, and convolve it directly.
+		const int inputBegin = table->inputBegin();
+		const int inputEnd = table->inputEnd();
+		std::vector<float> row( inputEnd - inputBegin );
+		for( int y = tileBound.min.y; y < tileBound.max.y; ++y )
 		{
-			std::vector<float>::const_iterator wIt = weights.begin();
-			for( oP.x = tileBound.min.x; oP.x < tileBound.max.x; ++oP.x )
+			sampler.sampleRow( y, inputBegin, inputEnd, &row[0] );
+			if( table->uniform )
 			{
-
-				iX = ( oP.x + 0.5 ) / ratio.x + offset.x;
-				OIIO::floorfrac( iX, &iXI );
-
-				int fX; // relative filter position
-				float v = 0.0f;
-				float totalW = 0.0f;
-				for( fX = -filterRadius.x; fX<= filterRadius.x; ++fX )
-				{
-					const float w = *wIt++;
-					if( w == 0.0f )
-					{
-						continue;
-					}
-
-					v += w * sampler.sample( iXI + fX, oP.y );
-					totalW += w;
-				}
-
-				if( totalW != 0.0f )
-				{
-					*pIt = v / totalW;
-				}
-
-				++pIt;
+				convolve<true>( *table, &row[0], inputBegin, &*pIt );
 			}
+			else
+			{
+				convolve<false>( *table, &row[0], inputBegin, &*pIt );
+			}
+			pIt += ImagePlug::tileSize();
 		}
 	}
 	else if( passes == Vertical )
 	{
-		V2i oP; // output pixel position
-		float iY; // input pixel position (floating point)
-		int iYI; // input pixel position (floored to int)
-
-		// Pixels in the same row share the same filter weights, so
-		// we precompute the weights now to avoid repeating work later.
-		std::vector<float> weights;
-		filterWeights( filter.get(), filterRadius.y, tileBound.min.y, ratio.y, offset.y, Vertical, weights );
+		// Pixels in the same row share the same filter weights.
+		ConstFilterTablePtr table = g_filterTableCache.get(
+			FilterTableKey( filterName, filterWidth, ratio, offset.y, tileBound.min.y, Vertical )
+		);
+
+		// Gather all the input rows we need, so that we can accumulate
+		// whole rows at a time rather than sampling pixel by pixel.
+		const int inputBegin = table->inputBegin();
+		const int inputEnd = table->inputEnd();
+		const int tileSize = ImagePlug::tileSize();
+		std::vector<float> rows( ( inputEnd - inputBegin ) * tileSize );
+		for( int y = inputBegin; y < inputEnd; ++y )
+		{
+			sampler.sampleRow( y, tileBound.min.x, tileBound.max.x, &rows[( y - inputBegin ) * tileSize] );
+		}
 
-		for( oP.y = tileBound.min.y; oP.y < tileBound.max.y; ++oP.y )
+		std::vector<float> accumulator( tileSize );
+		for( int i = 0; i < tileSize; ++i )
 		{
-			iY = ( oP.y + 0.5 ) / ratio.y + offset.y;
-			OIIO::floorfrac( iY, &iYI );
+			const float *w = table->pixelWeights( i );
+			const float totalWeight = table->totalWeight[table->uniform ? 0 : i];
+			const float *in = &rows[( table->inputStart[i] - inputBegin ) * tileSize];
 
-			for( oP.x = tileBound.min.x; oP.x < tileBound.max.x; ++oP.x )
+			std::fill( accumulator.begin(), accumulator.end(), 0.0f );
+			for( int k = 0; k < table->support; ++k, in += tileSize )
 			{
-				int fY; // relative filter position
-				float v = 0.0f;
-				float totalW = 0.0f;
-				std::vector<float>::const_iterator wIt = weights.begin() + ( oP.y - tileBound.min.y ) * ( filterRadius.y * 2 + 1);
-				for( fY = -filterRadius.y; fY<= filterRadius.y; ++fY )
+				const float wk = w[k];
+				if( wk == 0.0f )
 				{
-					const float w = *wIt++;
-					if( w == 0.0f )
-					{
-						continue;
-					}
-
-					v += w * sampler.sample( oP.x, iYI + fY );
-					totalW += w;
+					continue;
 				}
-
-				if( totalW != 0.0f )
+				for( int x = 0; x < tileSize; ++x )
 				{
-					*pIt = v / totalW;
+					accumulator[x] += wk * in[x];
 				}
+			}
 
-				++pIt;
+			if( totalWeight != 0.0f )
+			{
+				for( int x = 0; x < tileSize; ++x )
+				{
+					*pIt++ = accumulator[x] / totalWeight;
+				}
+			}
+			else
+			{
+				pIt = std::fill_n( pIt, tileSize, 0.0f );
 			}
 		}
 	}
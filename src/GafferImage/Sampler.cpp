@@ -34,6 +34,8 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include "GafferImage/Sampler.h"
 
 using namespace IECore;
@@ -89,6 +91,75 @@ Sampler::Sampler( const GafferImage::ImagePlug *plug, const std::string &channel
 	m_dataCache.resize( m_cacheWidth * cacheHeight, NULL );
 }
 
+void Sampler::sampleRow( int y, int xBegin, int xEnd, float *buffer )
+{
+	assert( xBegin <= xEnd );
+	assert( contains( m_sampleWindow, V2i( xBegin, y ) ) );
+	assert( contains( m_sampleWindow, V2i( xEnd - 1, y ) ) );
+
+	float *bufferEnd = buffer + ( xEnd - xBegin );
+
+	// Deal with rows which are entirely black.
+
+	if(
+		empty( m_dataWindow ) ||
+		( m_boundingMode == Black && ( y < m_dataWindow.min.y || y >= m_dataWindow.max.y ) )
+	)
+	{
+		std::fill( buffer, bufferEnd, 0.0f );
+		return;
+	}
+
+	y = std::max( m_dataWindow.min.y, std::min( m_dataWindow.max.y - 1, y ) );
+
+	const float *tileData;
+	V2i tileOrigin;
+	V2i tileIndex;
+
+	// Pixels to the left of the data window.
+
+	int x = xBegin;
+	const int leftEnd = std::min( xEnd, m_dataWindow.min.x );
+	if( x < leftEnd )
+	{
+		float v = 0.0f;
+		if( m_boundingMode == Clamp )
+		{
+			cachedData( V2i( m_dataWindow.min.x, y ), tileData, tileOrigin, tileIndex );
+			v = *(tileData + tileIndex.y * ImagePlug::tileSize() + tileIndex.x);
+		}
+		std::fill( buffer, buffer + ( leftEnd - x ), v );
+		buffer += leftEnd - x;
+		x = leftEnd;
+	}
+
+	// Pixels within the data window, copied a tile
+	// span at a time.
+
+	const int insideEnd = std::min( xEnd, m_dataWindow.max.x );
+	while( x < insideEnd )
+	{
+		cachedData( V2i( x, y ), tileData, tileOrigin, tileIndex );
+		const int spanEnd = std::min( insideEnd, tileOrigin.x + ImagePlug::tileSize() );
+		const float *span = tileData + tileIndex.y * ImagePlug::tileSize() + tileIndex.x;
+		buffer = std::copy( span, span + ( spanEnd - x ), buffer );
+		x = spanEnd;
+	}
+
+	// Pixels to the right of the data window.
+
+	if( buffer < bufferEnd )
+	{
+		float v = 0.0f;
+		if( m_boundingMode == Clamp )
+		{
+			cachedData( V2i( m_dataWindow.max.x - 1, y ), tileData, tileOrigin, tileIndex );
+			v = *(tileData + tileIndex.y * ImagePlug::tileSize() + tileIndex.x);
+		}
+		std::fill( buffer, bufferEnd, v );
+	}
+}
+
 void Sampler::hash( IECore::MurmurHash &h ) const
 {
 	for ( int x = m_cacheWindow.min.x; x < m_cacheWindow.max.x; x += GafferImage::ImagePlug::tileSize() )
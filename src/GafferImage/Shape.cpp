@@ -289,11 +289,12 @@ IECore::ConstFloatVectorDataPtr Shape::computeChannelData( const std::string &ch
 		}
 		else
 		{
-			FloatVectorDataPtr resultData = shape->copy();
+			const vector<float> &shapeValues = shape->readable();
+			FloatVectorDataPtr resultData = ImagePlug::tileBuffer();
 			vector<float> &result = resultData->writable();
-			for( vector<float>::iterator it = result.begin(), eIt = result.end(); it != eIt; ++it )
+			for( size_t i = 0, e = shapeValues.size(); i < e; ++i )
 			{
-				*it *= c;
+				result[i] = shapeValues[i] * c;
 			}
 			return resultData;
 		}
@@ -569,9 +569,9 @@ IECore::ConstFloatVectorDataPtr Text::computeShapeChannelData(  const Imath::V2i
 	FacePtr face = ::face( layout->member<StringData>( "font" )->readable(), layout->member<V2iData>( "size" )->readable() );
 	FT_GlyphSlot slot = face->glyph;
 
-	FloatVectorDataPtr resultData = new FloatVectorData();
+	FloatVectorDataPtr resultData = ImagePlug::tileBuffer();
 	vector<float> &result = resultData->writable();
-	result.resize( ImagePlug::tileSize() * ImagePlug::tileSize(), 0.0f );
+	std::fill( result.begin(), result.end(), 0.0f );
 
 	const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
 
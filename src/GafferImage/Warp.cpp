@@ -247,9 +247,9 @@ IECore::ConstFloatVectorDataPtr Warp::computeChannelData( const std::string &cha
 
 	const Box2i dataWindow = outPlug()->dataWindowPlug()->getValue();
 
-	FloatVectorDataPtr resultData = new FloatVectorData;
+	FloatVectorDataPtr resultData = ImagePlug::tileBuffer();
 	vector<float> &result = resultData->writable();
-	result.reserve( ImagePlug::tileSize() * ImagePlug::tileSize() );
+	result.clear();
 
 	const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
 	V2i oP;
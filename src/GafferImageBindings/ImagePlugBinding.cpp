@@ -67,7 +67,7 @@ IECore::ImagePrimitivePtr image( const ImagePlug &plug )
 void GafferImageBindings::bindImagePlug()
 {
 
-	PlugClass<ImagePlug>()
+	scope s = PlugClass<ImagePlug>()
 		.def(
 			init< const std::string &, Gaffer::Plug::Direction, unsigned >
 			(
@@ -84,6 +84,12 @@ void GafferImageBindings::bindImagePlug()
 		.def( "imageHash", &ImagePlug::imageHash )
 		.def( "tileSize", &ImagePlug::tileSize ).staticmethod( "tileSize" )
 		.def( "tileOrigin", &ImagePlug::tileOrigin ).staticmethod( "tileOrigin" )
+		.def( "tileBufferStatistics", &ImagePlug::tileBufferStatistics ).staticmethod( "tileBufferStatistics" )
+	;
+
+	class_<ImagePlug::TileBufferStatistics>( "TileBufferStatistics" )
+		.def_readonly( "allocationCount", &ImagePlug::TileBufferStatistics::allocationCount )
+		.def_readonly( "reuseCount", &ImagePlug::TileBufferStatistics::reuseCount )
 	;
 
 }
@@ -37,11 +37,14 @@
 
 #include "boost/bind.hpp"
 
+#include "boost/functional/hash.hpp"
+
 #include "IECore/LRUCache.h"
 #include "IECore/Renderable.h"
 
 #include "Gaffer/Context.h"
 #include "Gaffer/StringPlug.h"
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
 
 #include "GafferScene/AlembicSource.h"
 
@@ -54,7 +57,7 @@ using namespace GafferScene;
 IE_CORE_DEFINERUNTIMETYPED( AlembicSource );
 
 //////////////////////////////////////////////////////////////////////////
-// Implementation of an LRUCache of FileIndexedIOs.
+// Implementation of LRUCaches of AlembicInputs.
 //////////////////////////////////////////////////////////////////////////
 
 namespace GafferScene
@@ -63,20 +66,111 @@ namespace GafferScene
 namespace Detail
 {
 
-AlembicInputPtr alembicInputGetter( const std::string &fileName, size_t &cost )
+// Cache of the root AlembicInput for each file.
+
+AlembicInputPtr fileGetter( const std::string &fileName, size_t &cost )
 {
 	cost = 1;
 	return new AlembicInput( fileName );
 }
 
-typedef LRUCache<std::string, AlembicInputPtr> AlembicInputCache;
+typedef LRUCache<std::string, AlembicInputPtr> FileCache;
 
-AlembicInputCache *alembicInputCache()
+FileCache *fileCache()
 {
-	static AlembicInputCache *c = new AlembicInputCache( alembicInputGetter, 200 );
+	static FileCache *c = new FileCache( fileGetter, 200 );
 	return c;
 }
 
+// Cache of the AlembicInputs for individual locations within files.
+// Walking from the root of the file to a particular location costs
+// one Alembic lookup per path component, and we would otherwise pay
+// it for every plug at every location. Instead we resolve each location
+// from its (cached) parent, so that in the common case a location is
+// resolved with a single lookup. Each location costs 1, so the limit
+// is the number of locations cached across all files.
+
+struct InputKey
+{
+
+	InputKey( const std::string &fileName, const ScenePlug::ScenePath &path )
+		:	fileName( fileName ), path( path ), parent( NULL )
+	{
+	}
+
+	bool operator == ( const InputKey &other ) const
+	{
+		return fileName == other.fileName && path == other.path;
+	}
+
+	std::string fileName;
+	ScenePlug::ScenePath path;
+	// Not part of the key proper - just a way of passing the
+	// already resolved parent through to inputGetter(). This is
+	// a raw pointer so that the copy of the key stored in the
+	// cache doesn't keep the parent alive, and it is only valid
+	// for the duration of the call to get().
+	AlembicInput *parent;
+
+};
+
+inline size_t hash_value( const InputKey &key )
+{
+	MurmurHash h;
+	h.append( key.fileName );
+	if( key.path.size() )
+	{
+		h.append( &(key.path[0]), key.path.size() );
+	}
+	return boost::hash<MurmurHash>()( h );
+}
+
+AlembicInputPtr inputGetter( const InputKey &key, size_t &cost )
+{
+	cost = 1;
+	if( key.parent )
+	{
+		return key.parent->child( key.path.back().value() );
+	}
+
+	// The parent wasn't resolved by input(), because the location
+	// was evicted after input() checked for it. We may not access
+	// the input cache from here, so we walk down from the root.
+	AlembicInputPtr parent = fileCache()->get( key.fileName );
+	for( ScenePlug::ScenePath::const_iterator it = key.path.begin(), eIt = key.path.end() - 1; it != eIt; ++it )
+	{
+		parent = parent->child( it->value() );
+	}
+	return parent->child( key.path.back().value() );
+}
+
+typedef IECorePreview::LRUCache<InputKey, AlembicInputPtr> InputCache;
+
+InputCache *inputCache()
+{
+	static InputCache *c = new InputCache( inputGetter, 100000 );
+	return c;
+}
+
+AlembicInputPtr input( const std::string &fileName, const ScenePlug::ScenePath &path )
+{
+	if( path.empty() )
+	{
+		return fileCache()->get( fileName );
+	}
+
+	InputKey key( fileName, path );
+	AlembicInputPtr parent;
+	if( !inputCache()->cached( key ) )
+	{
+		// Resolve the parent outside of the getter, since the getter
+		// may not access the input cache itself.
+		parent = input( fileName, ScenePlug::ScenePath( path.begin(), path.end() - 1 ) );
+		key.parent = parent.get();
+	}
+	return inputCache()->get( key );
+}
+
 } // namespace Detail
 
 } // namespace GafferScene
@@ -139,7 +233,8 @@ void AlembicSource::plugSet( Gaffer::Plug *plug )
 {
 	if( plug == refreshCountPlug() )
 	{
-		alembicInputCache()->clear();
+		inputCache()->clear();
+		fileCache()->clear();
 	}
 }
 
@@ -292,6 +387,21 @@ GafferScene::ConstPathMatcherDataPtr AlembicSource::computeSet( const IECore::In
 	return parent->setPlug()->defaultValue();
 }
 
+size_t AlembicSource::getInputCacheLimit()
+{
+	return inputCache()->getMaxCost();
+}
+
+void AlembicSource::setInputCacheLimit( size_t numLocations )
+{
+	inputCache()->setMaxCost( numLocations );
+}
+
+size_t AlembicSource::inputCacheUsage()
+{
+	return inputCache()->currentCost();
+}
+
 IECoreAlembic::AlembicInputPtr AlembicSource::inputForPath( const ScenePath &path ) const
 {
 	const std::string fileName = fileNamePlug()->getValue();
@@ -300,11 +410,5 @@ IECoreAlembic::AlembicInputPtr AlembicSource::inputForPath( const ScenePath &pat
 		return NULL;
 	}
 
-	AlembicInputPtr result = Detail::alembicInputCache()->get( fileName );
-	for( ScenePath::const_iterator it = path.begin(), eIt = path.end(); it != eIt; it++ )
-	{
-		result = result->child( it->value() );
-	}
-
-	return result;
+	return Detail::input( fileName, path );
 }
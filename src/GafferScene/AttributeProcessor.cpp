@@ -124,16 +124,18 @@ IECore::ConstCompoundObjectPtr AttributeProcessor::computeProcessedAttributes( c
 		return inputAttributes;
 	}
 
-	const std::string names = namesPlug()->getValue();
+	const CompiledMatchPattern names( namesPlug()->getValue(), /* multiple = */ true );
 	const bool invert = invertNamesPlug()->getValue();
 
 	CompoundObjectPtr result = new CompoundObject;
+	bool changed = false;
 	for( CompoundObject::ObjectMap::const_iterator it = inputAttributes->members().begin(), eIt = inputAttributes->members().end(); it != eIt; ++it )
 	{
 		ConstObjectPtr attribute = it->second;
-		if( matchMultiple( it->first, names ) != invert )
+		if( names.match( it->first ) != invert )
 		{
 			attribute = processAttribute( path, context, it->first, attribute.get() );
+			changed = changed || attribute != it->second;
 		}
 
 		if( attribute )
@@ -150,5 +152,12 @@ IECore::ConstCompoundObjectPtr AttributeProcessor::computeProcessedAttributes( c
 		}
 	}
 
+	if( !changed )
+	{
+		// processAttribute() passed everything through untouched, so
+		// share the input rather than caching an identical copy of it.
+		return inputAttributes;
+	}
+
 	return result;
 }
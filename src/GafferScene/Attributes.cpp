@@ -185,16 +185,10 @@ IECore::ConstCompoundObjectPtr Attributes::computeProcessedAttributes( const Sce
 		return inputAttributes;
 	}
 
-	CompoundObjectPtr result = new CompoundObject;
-	// Since we're not going to modify any existing members (only add new ones),
-	// and our result becomes const on returning it, we can directly reference
-	// the input members in our result without copying. Be careful not to modify
-	// them though!
-	result->members() = inputAttributes->members();
-
-	ap->fillCompoundObject( result->members() );
+	CompoundObjectPtr newAttributes = new CompoundObject;
+	ap->fillCompoundObject( newAttributes->members() );
 
-	return result;
+	return mergeAttributes( inputAttributes, newAttributes );
 }
 
 void Attributes::plugSet( Gaffer::Plug *plug )
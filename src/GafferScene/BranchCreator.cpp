@@ -38,11 +38,11 @@
 #include "boost/algorithm/string/predicate.hpp"
 
 #include "Gaffer/Context.h"
-#include "Gaffer/StringAlgo.h"
 #include "Gaffer/StringPlug.h"
 
 #include "GafferScene/PathMatcherData.h"
 #include "GafferScene/BranchCreator.h"
+#include "GafferScene/Private/ChildNamesMap.h"
 
 using namespace std;
 using namespace Imath;
@@ -54,9 +54,17 @@ IE_CORE_DEFINERUNTIMETYPED( BranchCreator );
 
 size_t BranchCreator::g_firstPlugIndex = 0;
 
-static InternedString g_childNamesKey( "__BranchCreatorChildNames" );
+static InternedString g_childNamesMapKey( "__BranchCreatorChildNamesMap" );
 static InternedString g_parentKey( "__BranchCreatorParent" );
-static InternedString g_forwardMappingKey( "__BranchCreatorForwardMappings" );
+
+// The ChildNamesMap merges the children of the parent in the input
+// scene (index 0) with the children of the branch (index 1).
+static const size_t g_branchChildNamesIndex = 1;
+
+static const Private::ChildNamesMap &childNamesMap( const CompoundData *mapping )
+{
+	return mapping->member<Private::ChildNamesMapData>( g_childNamesMapKey )->readable();
+}
 
 BranchCreator::BranchCreator( const std::string &name )
 	:	SceneProcessor( name )
@@ -291,7 +299,7 @@ void BranchCreator::hashChildNames( const ScenePath &path, const Gaffer::Context
 	}
 	else if( parentMatch == Filter::ExactMatch )
 	{
-		h = mapping->member<InternedStringVectorData>( g_childNamesKey )->Object::hash();
+		h = childNamesMap( mapping.get() ).outputChildNames()->Object::hash();
 	}
 	else
 	{
@@ -311,7 +319,7 @@ IECore::ConstInternedStringVectorDataPtr BranchCreator::computeChildNames( const
 	}
 	else if( parentMatch == Filter::ExactMatch )
 	{
-		return mapping->member<InternedStringVectorData>( g_childNamesKey );
+		return childNamesMap( mapping.get() ).outputChildNames();
 	}
 	else
 	{
@@ -427,7 +435,7 @@ GafferScene::ConstPathMatcherDataPtr BranchCreator::computeSet( const IECore::In
 		return inputSetData;
 	}
 
-	const CompoundData *forwardMapping = mapping->member<CompoundData>( g_forwardMappingKey );
+	const Private::ChildNamesMap &childNames = childNamesMap( mapping.get() );
 
 	PathMatcherDataPtr outputSetData = inputSetData->copy();
 	PathMatcher &outputSet = outputSetData->writable();
@@ -442,10 +450,8 @@ GafferScene::ConstPathMatcherDataPtr BranchCreator::computeSet( const IECore::In
 		}
 		assert( branchPath.size() == 1 );
 
-		const InternedStringData *outputName = forwardMapping->member<InternedStringData>( branchPath[0], /* throwExceptions = */ true );
-
 		outputPrefix.resize( parentPath.size() + 1 );
-		outputPrefix.back() = outputName->readable();
+		outputPrefix.back() = childNames.outputName( Private::ChildNamesMap::Input( branchPath[0], g_branchChildNamesIndex ) );
 		outputSet.addPaths( branchSet.subTree( *pIt ), outputPrefix );
 
 		pIt.prune(); // We only want to visit the first level
@@ -531,11 +537,6 @@ void BranchCreator::hashMapping( const Gaffer::Context *context, IECore::MurmurH
 	h.append( branchChildNamesHash );
 }
 
-/// \todo This mapping is very similar to the one created by the Group node. Perhaps
-/// some generalisation of the two could form the basis for a nice unified HierarchyProcessor?
-/// In this case I think we would have a custom mapping class rather than just pass around
-/// CompoundData, and then parentAndBranchPaths() (or the future version of it) could be a method
-/// on the mapping object.
 IECore::ConstCompoundDataPtr BranchCreator::computeMapping( const Gaffer::Context *context ) const
 {
 	// get the parent. currently this is simply retrieving the value of parentPlug(),
@@ -561,59 +562,17 @@ IECore::ConstCompoundDataPtr BranchCreator::computeMapping( const Gaffer::Contex
 		return static_cast<const CompoundData *>( mappingPlug()->defaultValue() );
 	}
 
-	// create our result. in future it might be useful to create our datatype for this,
-	// but for now we're just packing everything into a CompoundData.
-
-	CompoundDataPtr result = new CompoundData;
-	result->writable()[g_parentKey] = new InternedStringVectorData( parent );
-
-	CompoundDataPtr forwardMapping = new CompoundData;
-	result->writable()[g_forwardMappingKey] = forwardMapping;
-
-	// calculate the child names for the result. this is the full list of child names
-	// immediately below the parent. we need to be careful to ensure that we rename any
+	// Calculate the child names for the result. This is the full list of child names
+	// immediately below the parent. The ChildNamesMap takes care of renaming any
 	// branch names which conflict with existing children of the parent.
 
-	ConstInternedStringVectorDataPtr inChildNamesData = inPlug()->childNames( parent );
-	InternedStringVectorDataPtr childNamesData = new InternedStringVectorData();
-
-	const vector<InternedString> &inChildNames = inChildNamesData->readable();
-	const vector<InternedString> &branchChildNames = branchChildNamesData->readable();
-	vector<InternedString> &childNames = childNamesData->writable();
-
-	result->writable()[g_childNamesKey] = childNamesData;
+	vector<ConstInternedStringVectorDataPtr> inputChildNames;
+	inputChildNames.push_back( inPlug()->childNames( parent ) );
+	inputChildNames.push_back( branchChildNamesData );
 
-	set<InternedString> allNames;
-	for( vector<InternedString>::const_iterator it = inChildNames.begin(); it != inChildNames.end(); ++it )
-	{
-		allNames.insert( *it );
-		childNames.push_back( *it );
-	}
-
-	boost::format namePrefixSuffixFormatter( "%s%d" );
-
-	for( vector<InternedString>::const_iterator it = branchChildNames.begin(); it != branchChildNames.end(); ++it )
-	{
-		InternedString name = *it;
-		if( allNames.find( name ) != allNames.end() )
-		{
-			// uniqueify the name
-			string prefix;
-			int suffix = numericSuffix( name, 1, &prefix );
-
-			do
-			{
-				name = boost::str( namePrefixSuffixFormatter % prefix % suffix );
-				suffix++;
-			} while( allNames.find( name ) != allNames.end() );
-		}
-
-		allNames.insert( name );
-		childNames.push_back( name );
-
-		result->writable()[name] = new InternedStringData( *it );
-		forwardMapping->writable()[*it] = new InternedStringData( name );
-	}
+	CompoundDataPtr result = new CompoundData;
+	result->writable()[g_parentKey] = new InternedStringVectorData( parent );
+	result->writable()[g_childNamesMapKey] = new Private::ChildNamesMapData( Private::ChildNamesMap( inputChildNames ) );
 
 	return result;
 }
@@ -651,8 +610,8 @@ Filter::Result BranchCreator::parentAndBranchPaths( const IECore::CompoundData *
 
 	// path is descendant of parent
 
-	const InternedStringData *branchName = mapping->member<InternedStringData>( *pathIterator );
-	if( !branchName )
+	const Private::ChildNamesMap::Input *input = childNamesMap( mapping ).input( *pathIterator );
+	if( !input || input->index != g_branchChildNamesIndex )
 	{
 		// descendant comes from the input, rather than being part of the generated branch
 		return Filter::NoMatch;
@@ -661,7 +620,7 @@ Filter::Result BranchCreator::parentAndBranchPaths( const IECore::CompoundData *
 	// somewhere on the new branch
 
 	parentPath = parent;
-	branchPath.push_back( branchName->readable() );
+	branchPath.push_back( input->name );
 	branchPath.insert( branchPath.end(), ++pathIterator, pathIteratorEnd );
 
 	return Filter::AncestorMatch;
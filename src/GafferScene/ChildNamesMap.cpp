@@ -0,0 +1,227 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/format.hpp"
+#include "boost/functional/hash.hpp"
+
+#include "IECore/TypedData.inl"
+
+#include "Gaffer/StringAlgo.h"
+
+#include "GafferScene/TypeIds.h"
+#include "GafferScene/Private/ChildNamesMap.h"
+
+using namespace std;
+using namespace IECore;
+using namespace Gaffer;
+using namespace GafferScene::Private;
+
+//////////////////////////////////////////////////////////////////////////
+// ChildNamesMap
+//////////////////////////////////////////////////////////////////////////
+
+size_t ChildNamesMap::InternedStringHash::operator()( const IECore::InternedString &s ) const
+{
+	// InternedStrings are unique by address, so there is no
+	// need to hash the actual characters of the string.
+	return boost::hash<const char *>()( s.c_str() );
+}
+
+size_t ChildNamesMap::InputHash::operator()( const Input &input ) const
+{
+	size_t result = InternedStringHash()( input.name );
+	boost::hash_combine( result, input.index );
+	return result;
+}
+
+ChildNamesMap::ChildNamesMap()
+	:	m_outputChildNames( new InternedStringVectorData )
+{
+}
+
+ChildNamesMap::ChildNamesMap( const std::vector<IECore::ConstInternedStringVectorDataPtr> &inputChildNames )
+	:	m_outputChildNames( new InternedStringVectorData )
+{
+	vector<InternedString> &outputChildNames = m_outputChildNames->writable();
+
+	size_t size = 0;
+	for( vector<ConstInternedStringVectorDataPtr>::const_iterator it = inputChildNames.begin(), eIt = inputChildNames.end(); it != eIt; ++it )
+	{
+		size += (*it)->readable().size();
+	}
+	outputChildNames.reserve( size );
+	m_inputs.reserve( size );
+
+	boost::format namePrefixSuffixFormatter( "%s%d" );
+
+	for( size_t i = 0, e = inputChildNames.size(); i < e; ++i )
+	{
+		const vector<InternedString> &names = inputChildNames[i]->readable();
+		for( vector<InternedString>::const_iterator it = names.begin(), eIt = names.end(); it != eIt; ++it )
+		{
+			const Input input( *it, i );
+			InternedString name = *it;
+			if( m_inputs.find( name ) != m_inputs.end() )
+			{
+				// Uniquify the name
+				string prefix;
+				int suffix = numericSuffix( name.string(), 1, &prefix );
+
+				do
+				{
+					name = boost::str( namePrefixSuffixFormatter % prefix % suffix );
+					suffix++;
+				} while( m_inputs.find( name ) != m_inputs.end() );
+
+				m_renamedOutputs.insert( OutputMap::value_type( input, name ) );
+			}
+
+			m_inputs.insert( InputMap::value_type( name, input ) );
+			outputChildNames.push_back( name );
+		}
+	}
+}
+
+const IECore::InternedStringVectorData *ChildNamesMap::outputChildNames() const
+{
+	return m_outputChildNames.get();
+}
+
+const ChildNamesMap::Input *ChildNamesMap::input( const IECore::InternedString &outputName ) const
+{
+	InputMap::const_iterator it = m_inputs.find( outputName );
+	if( it == m_inputs.end() )
+	{
+		return NULL;
+	}
+	return &it->second;
+}
+
+const IECore::InternedString &ChildNamesMap::outputName( const Input &input ) const
+{
+	OutputMap::const_iterator it = m_renamedOutputs.find( input );
+	if( it != m_renamedOutputs.end() )
+	{
+		return it->second;
+	}
+
+	// Names which weren't renamed aren't stored in the forward
+	// mapping, so we validate them using the reverse mapping.
+	InputMap::const_iterator iIt = m_inputs.find( input.name );
+	if( iIt != m_inputs.end() && iIt->second == input )
+	{
+		return input.name;
+	}
+
+	throw IECore::Exception( boost::str( boost::format( "Unable to find output name for input %d child \"%s\"" ) % input.index % input.name.string() ) );
+}
+
+bool ChildNamesMap::operator == ( const ChildNamesMap &rhs ) const
+{
+	if( m_outputChildNames->readable() != rhs.m_outputChildNames->readable() )
+	{
+		return false;
+	}
+
+	for( vector<InternedString>::const_iterator it = m_outputChildNames->readable().begin(), eIt = m_outputChildNames->readable().end(); it != eIt; ++it )
+	{
+		if( !( *input( *it ) == *rhs.input( *it ) ) )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void ChildNamesMap::hash( IECore::MurmurHash &h ) const
+{
+	const vector<InternedString> &outputChildNames = m_outputChildNames->readable();
+	h.append( (uint64_t)outputChildNames.size() );
+	for( vector<InternedString>::const_iterator it = outputChildNames.begin(), eIt = outputChildNames.end(); it != eIt; ++it )
+	{
+		const Input *i = input( *it );
+		h.append( *it );
+		h.append( i->name );
+		h.append( (uint64_t)i->index );
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// ChildNamesMapData
+//////////////////////////////////////////////////////////////////////////
+
+namespace IECore
+{
+
+IECORE_RUNTIMETYPED_DEFINETEMPLATESPECIALISATION( GafferScene::Private::ChildNamesMapData, GafferScene::ChildNamesMapDataTypeId )
+
+template<>
+void ChildNamesMapData::save( SaveContext *context ) const
+{
+	Data::save( context );
+	msg( Msg::Warning, "ChildNamesMapData::save", "Not implemented" );
+}
+
+template<>
+void ChildNamesMapData::load( LoadContextPtr context )
+{
+	Data::load( context );
+	msg( Msg::Warning, "ChildNamesMapData::load", "Not implemented" );
+}
+
+template<>
+MurmurHash SharedDataHolder<GafferScene::Private::ChildNamesMap>::hash() const
+{
+	MurmurHash result;
+	readable().hash( result );
+	return result;
+}
+
+template<>
+void ChildNamesMapData::memoryUsage( Object::MemoryAccumulator &accumulator ) const
+{
+	Data::memoryUsage( accumulator );
+	const GafferScene::Private::ChildNamesMap &m = readable();
+	// Approximate, but good enough for the cache to account for us.
+	const size_t numChildren = m.outputChildNames()->readable().size();
+	accumulator.accumulate( m.outputChildNames() );
+	accumulator.accumulate( &m, sizeof( m ) + numChildren * ( sizeof( InternedString ) + sizeof( ChildNamesMap::Input ) + 2 * sizeof( void * ) ) );
+}
+
+template class TypedData<GafferScene::Private::ChildNamesMap>;
+
+} // namespace IECore
@@ -80,14 +80,14 @@ IECore::ConstCompoundObjectPtr CopyOptions::computeProcessedGlobals( const Gaffe
 
 	// copy matching options
 	const std::string prefix = "option:";
-	const std::string names = namesPlug()->getValue();
+	const CompiledMatchPattern names( namesPlug()->getValue(), /* multiple = */ true );
 
 	IECore::ConstCompoundObjectPtr sourceGlobals = sourcePlug()->globalsPlug()->getValue();
 	for( IECore::CompoundObject::ObjectMap::const_iterator it = sourceGlobals->members().begin(), eIt = sourceGlobals->members().end(); it != eIt; ++it )
 	{
 		if( boost::starts_with( it->first.c_str(), prefix ) )
 		{
-			if( matchMultiple( it->first.c_str() + prefix.size(), names.c_str() ) )
+			if( names.match( it->first.c_str() + prefix.size() ) )
 			{
 				result->members()[it->first] = it->second;
 			}
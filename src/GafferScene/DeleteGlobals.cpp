@@ -116,6 +116,7 @@ IECore::ConstCompoundObjectPtr DeleteGlobals::computeProcessedGlobals( const Gaf
 	}
 
 	const std::string prefix = namePrefix();
+	const CompiledMatchPattern pattern( names, /* multiple = */ true );
 
 	IECore::CompoundObjectPtr result = new IECore::CompoundObject;
 	for( IECore::CompoundObject::ObjectMap::const_iterator it = inputGlobals->members().begin(), eIt = inputGlobals->members().end(); it != eIt; ++it )
@@ -123,7 +124,7 @@ IECore::ConstCompoundObjectPtr DeleteGlobals::computeProcessedGlobals( const Gaf
 		bool keep = true;
 		if( boost::starts_with( it->first.c_str(), prefix ) )
 		{
-			if( matchMultiple( it->first.c_str() + prefix.size(), names.c_str() ) != invert )
+			if( pattern.match( it->first.c_str() + prefix.size() ) != invert )
 			{
 				keep = false;
 			}
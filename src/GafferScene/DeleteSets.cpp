@@ -118,12 +118,12 @@ IECore::ConstInternedStringVectorDataPtr DeleteSets::computeSetNames( const Gaff
 	InternedStringVectorDataPtr outputSetNamesData = new InternedStringVectorData;
 	std::vector<InternedString> &outputSetNames = outputSetNamesData->writable();
 
-	const std::string names = namesPlug()->getValue();
+	const CompiledMatchPattern names( namesPlug()->getValue(), /* multiple = */ true );
 	const bool invert = invertNamesPlug()->getValue();
 
 	for( std::vector<InternedString>::const_iterator it = inputSetNames.begin(); it != inputSetNames.end(); ++it )
 	{
-		if( matchMultiple( *it, names ) != (!invert) )
+		if( names.match( it->string() ) != (!invert) )
 		{
 			outputSetNames.push_back( *it );
 		}
@@ -44,6 +44,61 @@ using namespace IECore;
 using namespace Gaffer;
 using namespace GafferScene;
 
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Returns the index of `name` within `childNames`, or `childNames.size()`
+// if it is not present. Since the names are generated with consecutive
+// numeric suffixes, the index can usually be derived directly from the
+// suffix, which avoids a linear search for every copy.
+size_t copyIndex( const vector<InternedString> &childNames, const InternedString &name )
+{
+	if( childNames.empty() )
+	{
+		return 0;
+	}
+
+	const int suffix = numericSuffix( name.string() );
+	const int firstSuffix = numericSuffix( childNames[0].string() );
+	if( suffix >= 0 && firstSuffix >= 0 && suffix >= firstSuffix )
+	{
+		const size_t index = suffix - firstSuffix;
+		if( index < childNames.size() && childNames[index] == name )
+		{
+			return index;
+		}
+	}
+
+	return find( childNames.begin(), childNames.end(), name ) - childNames.begin();
+}
+
+// Returns `m` raised to the power `n`, using exponentiation by squaring
+// so that the cost is logarithmic rather than linear in `n`.
+Imath::M44f matrixPower( Imath::M44f m, size_t n )
+{
+	Imath::M44f result;
+	while( n )
+	{
+		if( n & 1 )
+		{
+			result = result * m;
+		}
+		m = m * m;
+		n >>= 1;
+	}
+	return result;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Duplicate
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( Duplicate );
 
 size_t Duplicate::g_firstPlugIndex = 0;
@@ -304,11 +359,9 @@ Imath::M44f Duplicate::computeBranchTransform( const ScenePath &parentPath, cons
 		ConstInternedStringVectorDataPtr childNamesData = childNamesPlug()->getValue();
 		const vector<InternedString> &childNames = childNamesData->readable();
 
-		size_t i = 0;
-		do
-		{
-			result = result * matrix;
-		} while( i < childNames.size() && branchPath[0] != childNames[i++] );
+		// The i'th copy is transformed by the matrix i + 1 times.
+		const size_t i = copyIndex( childNames, branchPath[0] );
+		result = result * matrixPower( matrix, i + 1 );
 	}
 	return result;
 }
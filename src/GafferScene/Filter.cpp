@@ -34,14 +34,90 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/blocked_range.h"
+
 #include "Gaffer/Context.h"
+#include "Gaffer/ParallelAlgo.h"
 
 #include "GafferScene/Filter.h"
 #include "GafferScene/FilterPlug.h"
+#include "GafferScene/ScenePlug.h"
 
+using namespace std;
 using namespace GafferScene;
 using namespace Gaffer;
 
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Evaluates a filter output for a range of children, using a
+// context per task. Used to implement the default child match
+// queries.
+template<typename Result>
+class ChildEvaluator
+{
+
+	public :
+
+		ChildEvaluator( const Plug *filterOut, const Context *context, const ScenePlug::ScenePath &parent, const vector<IECore::InternedString> &childNames, vector<Result> &results )
+			:	m_filterOut( static_cast<const IntPlug *>( filterOut ) ), m_context( context ), m_parent( parent ), m_childNames( childNames ), m_results( results )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &range ) const
+		{
+			ContextPtr context = new Context( *m_context, Context::Borrowed );
+			Context::Scope scopedContext( context.get() );
+
+			ScenePlug::ScenePath childPath = m_parent;
+			childPath.push_back( IECore::InternedString() );
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				childPath.back() = m_childNames[i];
+				context->set( ScenePlug::scenePathContextName, childPath );
+				evaluate( m_results[i] );
+			}
+		}
+
+	private :
+
+		void evaluate( unsigned &result ) const
+		{
+			result = m_filterOut->getValue();
+		}
+
+		void evaluate( IECore::MurmurHash &result ) const
+		{
+			result = m_filterOut->hash();
+		}
+
+		const IntPlug *m_filterOut;
+		const Context *m_context;
+		const ScenePlug::ScenePath &m_parent;
+		const vector<IECore::InternedString> &m_childNames;
+		vector<Result> &m_results;
+
+};
+
+// Returns true if the value of `plug` is computed, and may therefore
+// vary with the "scene:path" context variable.
+/// \todo Share this logic with PathFilter and Switch::variesWithContext().
+bool variesWithContext( const Plug *plug )
+{
+	const Plug *source = plug->source<Plug>();
+	return source->direction() == Plug::Out && IECore::runTimeCast<const ComputeNode>( source->node() );
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Filter
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( Filter );
 
 const IECore::InternedString Filter::inputSceneContextName( "scene:filter:inputScene" );
@@ -149,3 +225,63 @@ unsigned Filter::computeMatch( const ScenePlug *scene, const Gaffer::Context *co
 {
 	return NoMatch;
 }
+
+void Filter::childMatches( const std::vector<IECore::InternedString> &parent, const std::vector<IECore::InternedString> &childNames, std::vector<unsigned> &results ) const
+{
+	const Context *context = Context::current();
+	if( outPlug()->getInput<Plug>() || variesWithContext( enabledPlug() ) )
+	{
+		// Either our own hashMatch() and computeMatch() are bypassed
+		// by the connection, or enabledPlug() may differ from child to
+		// child. In both cases we must evaluate outPlug() per child.
+		Filter::computeChildMatches( getInputScene( context ), parent, childNames, context, results );
+		return;
+	}
+
+	if( !enabledPlug()->getValue() )
+	{
+		results.assign( childNames.size(), NoMatch );
+		return;
+	}
+
+	computeChildMatches( getInputScene( context ), parent, childNames, context, results );
+}
+
+IECore::MurmurHash Filter::childMatchesHash( const std::vector<IECore::InternedString> &parent, const std::vector<IECore::InternedString> &childNames ) const
+{
+	IECore::MurmurHash h;
+	const Context *context = Context::current();
+	if( outPlug()->getInput<Plug>() || variesWithContext( enabledPlug() ) )
+	{
+		// See comments in childMatches().
+		Filter::hashChildMatches( getInputScene( context ), parent, childNames, context, h );
+		return h;
+	}
+
+	const bool enabled = enabledPlug()->getValue();
+	h.append( enabled );
+	if( enabled )
+	{
+		hashChildMatches( getInputScene( context ), parent, childNames, context, h );
+	}
+	return h;
+}
+
+void Filter::hashChildMatches( const ScenePlug *scene, const std::vector<IECore::InternedString> &parent, const std::vector<IECore::InternedString> &childNames, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	vector<IECore::MurmurHash> hashes( childNames.size() );
+	ChildEvaluator<IECore::MurmurHash> evaluator( outPlug(), context, parent, childNames, hashes );
+	isolatedParallelFor( tbb::blocked_range<size_t>( 0, childNames.size() ), evaluator );
+
+	for( vector<IECore::MurmurHash>::const_iterator it = hashes.begin(), eIt = hashes.end(); it != eIt; ++it )
+	{
+		h.append( *it );
+	}
+}
+
+void Filter::computeChildMatches( const ScenePlug *scene, const std::vector<IECore::InternedString> &parent, const std::vector<IECore::InternedString> &childNames, const Gaffer::Context *context, std::vector<unsigned> &results ) const
+{
+	results.resize( childNames.size() );
+	ChildEvaluator<unsigned> evaluator( outPlug(), context, parent, childNames, results );
+	isolatedParallelFor( tbb::blocked_range<size_t>( 0, childNames.size() ), evaluator );
+}
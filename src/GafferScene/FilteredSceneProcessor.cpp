@@ -106,3 +106,50 @@ Filter::Result FilteredSceneProcessor::filterValue( const Gaffer::Context *conte
 	Context::Scope s( c.get() );
 	return (Filter::Result)filterPlug()->getValue();
 }
+
+void FilteredSceneProcessor::childFilterHash( const ScenePath &path, const std::vector<IECore::InternedString> &childNames, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	ContextPtr c = filterContext( context );
+	Context::Scope s( c.get() );
+
+	const Plug *source = filterPlug()->source<Plug>();
+	const Filter *filter = runTimeCast<const Filter>( source->node() );
+	if( filter && source == filter->outPlug() )
+	{
+		h.append( filter->childMatchesHash( path, childNames ) );
+		return;
+	}
+
+	ScenePath childPath = path;
+	childPath.push_back( InternedString() ); // for the child name
+	for( std::vector<InternedString>::const_iterator it = childNames.begin(), eIt = childNames.end(); it != eIt; ++it )
+	{
+		childPath.back() = *it;
+		c->set( ScenePlug::scenePathContextName, childPath );
+		filterPlug()->hash( h );
+	}
+}
+
+void FilteredSceneProcessor::childFilterValues( const ScenePath &path, const std::vector<IECore::InternedString> &childNames, const Gaffer::Context *context, std::vector<unsigned> &results ) const
+{
+	ContextPtr c = filterContext( context );
+	Context::Scope s( c.get() );
+
+	const Plug *source = filterPlug()->source<Plug>();
+	const Filter *filter = runTimeCast<const Filter>( source->node() );
+	if( filter && source == filter->outPlug() )
+	{
+		filter->childMatches( path, childNames, results );
+		return;
+	}
+
+	results.resize( childNames.size() );
+	ScenePath childPath = path;
+	childPath.push_back( InternedString() ); // for the child name
+	for( size_t i = 0, e = childNames.size(); i < e; ++i )
+	{
+		childPath.back() = childNames[i];
+		c->set( ScenePlug::scenePathContextName, childPath );
+		results[i] = filterPlug()->getValue();
+	}
+}
@@ -35,8 +35,7 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
-#include "boost/lexical_cast.hpp"
-#include "boost/regex.hpp"
+#include "boost/format.hpp"
 
 #include "OpenEXR/ImathBoxAlgo.h"
 
@@ -50,6 +49,7 @@
 
 #include "GafferScene/Group.h"
 #include "GafferScene/PathMatcherData.h"
+#include "GafferScene/Private/ChildNamesMap.h"
 
 using namespace std;
 using namespace Imath;
@@ -69,7 +69,7 @@ Group::Group( const std::string &name )
 	addChild( new StringPlug( "name", Plug::In, "group" ) );
 	addChild( new TransformPlug( "transform" ) );
 
-	addChild( new Gaffer::ObjectPlug( "__mapping", Gaffer::Plug::Out, new CompoundObject() ) );
+	addChild( new Gaffer::ObjectPlug( "__mapping", Gaffer::Plug::Out, new Private::ChildNamesMapData() ) );
 
 	outPlug()->globalsPlug()->setInput( inPlug()->globalsPlug() );
 }
@@ -370,8 +370,8 @@ IECore::ConstInternedStringVectorDataPtr Group::computeChildNames( const ScenePa
 	}
 	else if( path.size() == 1 )
 	{
-		ConstCompoundObjectPtr mapping = boost::static_pointer_cast<const CompoundObject>( mappingPlug()->getValue() );
-		return mapping->member<InternedStringVectorData>( "__GroupChildNames" );
+		Private::ConstChildNamesMapDataPtr mapping = boost::static_pointer_cast<const Private::ChildNamesMapData>( mappingPlug()->getValue() );
+		return mapping->readable().outputChildNames();
 	}
 	else
 	{
@@ -428,8 +428,8 @@ GafferScene::ConstPathMatcherDataPtr Group::computeSet( const IECore::InternedSt
 {
 	InternedString groupName = namePlug()->getValue();
 
-	ConstCompoundObjectPtr mapping = boost::static_pointer_cast<const CompoundObject>( mappingPlug()->getValue() );
-	const ObjectVector *forwardMappings = mapping->member<ObjectVector>( "__GroupForwardMappings", true /* throw if missing */ );
+	Private::ConstChildNamesMapDataPtr mapping = boost::static_pointer_cast<const Private::ChildNamesMapData>( mappingPlug()->getValue() );
+	const Private::ChildNamesMap &childNamesMap = mapping->readable();
 
 	PathMatcherDataPtr resultData = new PathMatcherData;
 	PathMatcher &result = resultData->writable();
@@ -438,12 +438,10 @@ GafferScene::ConstPathMatcherDataPtr Group::computeSet( const IECore::InternedSt
 		ConstPathMatcherDataPtr inputSetData = inPlugs()->getChild<ScenePlug>( i )->setPlug()->getValue();
 		const PathMatcher &inputSet = inputSetData->readable();
 
-		const CompoundData *forwardMapping = static_cast<const IECore::CompoundData *>( forwardMappings->members()[i].get() );
-
 		// We want our outputSet to reference the data within inputSet rather
 		// than do an expensive copy. This is complicated slightly by the fact
 		// that we may need to rename the children of the root according to the
-		// forwardMapping object. Here we do that by taking subtrees of the input
+		// mapping. Here we do that by taking subtrees of the input
 		// and adding them to our output under a renamed prefix.
 		for( PathMatcher::RawIterator pIt = inputSet.begin(), peIt = inputSet.end(); pIt != peIt; ++pIt )
 		{
@@ -455,11 +453,9 @@ GafferScene::ConstPathMatcherDataPtr Group::computeSet( const IECore::InternedSt
 			}
 			assert( inputPath.size() == 1 );
 
-			const InternedStringData *outputName = forwardMapping->member<InternedStringData>( inputPath[0], /* throwExceptions = */ true );
-
 			vector<InternedString> prefix;
 			prefix.push_back( groupName );
-			prefix.push_back( outputName->readable() );
+			prefix.push_back( childNamesMap.outputName( Private::ChildNamesMap::Input( inputPath[0], i ) ) );
 			result.addPaths( inputSet.subTree( inputPath ), prefix );
 
 			pIt.prune(); // We only want to visit the first level
@@ -471,86 +467,33 @@ GafferScene::ConstPathMatcherDataPtr Group::computeSet( const IECore::InternedSt
 
 IECore::ObjectPtr Group::computeMapping( const Gaffer::Context *context ) const
 {
-	/// \todo It might be more optimal to make our own Object subclass better tailored
-	/// for passing the information we want.
-	CompoundObjectPtr result = new CompoundObject();
-
-	InternedStringVectorDataPtr childNamesData = new InternedStringVectorData();
-	vector<InternedString> &childNames = childNamesData->writable();
-	result->members()["__GroupChildNames"] = childNamesData;
-
-	ObjectVectorPtr forwardMappings = new ObjectVector;
-	result->members()["__GroupForwardMappings"] = forwardMappings;
-
-	boost::regex namePrefixSuffixRegex( "^(.*[^0-9]+)([0-9]+)$" );
-	boost::format namePrefixSuffixFormatter( "%s%d" );
-
-	set<InternedString> allNames;
+	vector<ConstInternedStringVectorDataPtr> inputChildNames;
+	inputChildNames.reserve( inPlugs()->children().size() );
 	for( ScenePlugIterator it( inPlugs() ); !it.done(); ++it )
 	{
-		ConstInternedStringVectorDataPtr inChildNamesData = (*it)->childNames( ScenePath() );
-		CompoundDataPtr forwardMapping = new CompoundData;
-		forwardMappings->members().push_back( forwardMapping );
-
-		const vector<InternedString> &inChildNames = inChildNamesData->readable();
-		for( vector<InternedString>::const_iterator cIt = inChildNames.begin(), ceIt = inChildNames.end(); cIt!=ceIt; cIt++ )
-		{
-			InternedString name = *cIt;
-			if( allNames.find( name ) != allNames.end() )
-			{
-				// uniqueify the name
-				/// \todo This code is almost identical to code in GraphComponent::setName(),
-				/// is there a sensible place it can be shared? The primary obstacle is that
-				/// each use has a different method of storing the existing names.
-				string prefix = name;
-				int suffix = 1;
-
-				boost::cmatch match;
-				if( regex_match( name.value().c_str(), match, namePrefixSuffixRegex ) )
-				{
-					prefix = match[1];
-					suffix = boost::lexical_cast<int>( match[2] );
-				}
-
-				do
-				{
-					name = boost::str( namePrefixSuffixFormatter % prefix % suffix );
-					suffix++;
-				} while( allNames.find( name ) != allNames.end() );
-			}
-
-			allNames.insert( name );
-			childNames.push_back( name );
-			forwardMapping->writable()[*cIt] = new InternedStringData( name );
-
-			CompoundObjectPtr entry = new CompoundObject;
-			entry->members()["n"] = new InternedStringData( *cIt );
-			entry->members()["i"] = new IntData( it.base() - inPlugs()->children().begin() );
-			result->members()[name] = entry;
-		}
+		inputChildNames.push_back( (*it)->childNames( ScenePath() ) );
 	}
-
-	return result;
+	return new Private::ChildNamesMapData( Private::ChildNamesMap( inputChildNames ) );
 }
 
 SceneNode::ScenePath Group::sourcePath( const ScenePath &outputPath, const ScenePlug **source ) const
 {
 	const InternedString mappedChildName = outputPath[1];
 
-	ConstCompoundObjectPtr mapping = boost::static_pointer_cast<const CompoundObject>( mappingPlug()->getValue() );
-	const CompoundObject *entry = mapping->member<CompoundObject>( mappedChildName );
-	if( !entry )
+	Private::ConstChildNamesMapDataPtr mapping = boost::static_pointer_cast<const Private::ChildNamesMapData>( mappingPlug()->getValue() );
+	const Private::ChildNamesMap::Input *input = mapping->readable().input( mappedChildName );
+	if( !input )
 	{
 		string outputPathString;
 		ScenePlug::pathToString( outputPath, outputPathString );
 		throw Exception( boost::str( boost::format( "Unable to find mapping for output path \"%s\"" ) % outputPathString ) );
 	}
 
-	*source = inPlugs()->getChild<ScenePlug>( entry->member<IntData>( "i" )->readable() );
+	*source = inPlugs()->getChild<ScenePlug>( input->index );
 
 	ScenePath result;
 	result.reserve( outputPath.size() - 1 );
-	result.push_back( entry->member<InternedStringData>( "n" )->readable() );
+	result.push_back( input->name );
 	result.insert( result.end(), outputPath.begin() + 2, outputPath.end() );
 	return result;
 }
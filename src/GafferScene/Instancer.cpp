@@ -35,7 +35,6 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
-#include "tbb/parallel_reduce.h"
 #include "tbb/blocked_range.h"
 
 #include "boost/lexical_cast.hpp"
@@ -45,6 +44,7 @@
 
 #include "Gaffer/Context.h"
 #include "Gaffer/StringPlug.h"
+#include "Gaffer/ParallelAlgo.h"
 
 #include "GafferScene/Instancer.h"
 
@@ -265,7 +265,7 @@ Imath::Box3f Instancer::computeBranchBound( const ScenePath &parentPath, const S
 			}
 
 			BoundUnion unioner( this, branchChildPath, context, p.get() );
-			parallel_reduce(
+			isolatedParallelReduce(
 				blocked_range<size_t>( 0, p->readable().size() ),
 				unioner
 			);
@@ -179,14 +179,7 @@ void Isolate::hashChildNames( const ScenePath &path, const Gaffer::Context *cont
 		ConstInternedStringVectorDataPtr inputChildNamesData = inPlug()->childNamesPlug()->getValue();
 		const vector<InternedString> &inputChildNames = inputChildNamesData->readable();
 
-		ScenePath childPath = path;
-		childPath.push_back( InternedString() ); // for the child name
-		for( vector<InternedString>::const_iterator it = inputChildNames.begin(), eIt = inputChildNames.end(); it != eIt; ++it )
-		{
-			childPath[path.size()] = *it;
-			tmpContext->set( ScenePlug::scenePathContextName, childPath );
-			filterPlug()->hash( h );
-		}
+		childFilterHash( path, inputChildNames, context, h );
 	}
 	else
 	{
@@ -209,15 +202,13 @@ IECore::ConstInternedStringVectorDataPtr Isolate::computeChildNames( const Scene
 		InternedStringVectorDataPtr outputChildNamesData = new InternedStringVectorData;
 		vector<InternedString> &outputChildNames = outputChildNamesData->writable();
 
-		ScenePath childPath = path;
-		childPath.push_back( InternedString() ); // for the child name
-		for( vector<InternedString>::const_iterator it = inputChildNames.begin(), eIt = inputChildNames.end(); it != eIt; it++ )
+		vector<unsigned> matches;
+		childFilterValues( path, inputChildNames, context, matches );
+		for( size_t i = 0, e = inputChildNames.size(); i < e; ++i )
 		{
-			childPath[path.size()] = *it;
-			tmpContext->set( ScenePlug::scenePathContextName, childPath );
-			if( filterPlug()->getValue() != Filter::NoMatch )
+			if( matches[i] != Filter::NoMatch )
 			{
-				outputChildNames.push_back( *it );
+				outputChildNames.push_back( inputChildNames[i] );
 			}
 		}
 
@@ -318,3 +309,75 @@ bool Isolate::mayPruneChildren( const ScenePath &path, unsigned filterValue ) co
 
 	return filterValue == Filter::DescendantMatch || filterValue == Filter::NoMatch;
 }
+
+unsigned Isolate::computeSetMatch( const IECore::InternedString &setName, const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const
+{
+	const unsigned inputMatch = inPlug()->setMatch( setName, path );
+	if( inputMatch == Filter::NoMatch )
+	{
+		return Filter::NoMatch;
+	}
+
+	const std::string fromString = fromPlug()->getValue();
+	ScenePlug::ScenePath fromPath; ScenePlug::stringToPath( fromString, fromPath );
+
+	// Walk down from the root to the path, evaluating the filter
+	// in the same way that computeSet() traverses the input set,
+	// to find the location at which the path is removed, if any.
+
+	size_t removedSize = path.size() + 1;
+	bool descendantsRemoved = false;
+	{
+		ContextPtr tmpContext = filterContext( context );
+		Context::Scope scopedContext( tmpContext.get() );
+
+		ScenePath prefix;
+		prefix.reserve( path.size() );
+		for( size_t i = 0; i <= path.size(); ++i )
+		{
+			if( i )
+			{
+				prefix.push_back( path[i-1] );
+			}
+			tmpContext->set( ScenePlug::scenePathContextName, prefix );
+			const int m = filterPlug()->getValue();
+			if( m & ( Filter::ExactMatch | Filter::AncestorMatch ) )
+			{
+				// Everything at or below here is kept.
+				break;
+			}
+			else if( !( m & Filter::DescendantMatch ) && boost::starts_with( prefix, fromPath ) )
+			{
+				// Removed, along with everything below.
+				removedSize = i;
+				break;
+			}
+			// Either there's a match further down, or we're
+			// above `from` and must keep walking, as computeSet()
+			// does. In both cases, descendants may be removed.
+			descendantsRemoved = i == path.size();
+		}
+	}
+
+	if( removedSize <= path.size() )
+	{
+		// The path has been removed, along with everything below
+		// the removed location. Ancestors of that location remain.
+		if( !removedSize )
+		{
+			return Filter::NoMatch;
+		}
+		const ScenePath ancestor( path.begin(), path.begin() + removedSize - 1 );
+		const unsigned ancestorMatch = inPlug()->setMatch( setName, ancestor );
+		return ancestorMatch & ( Filter::ExactMatch | Filter::AncestorMatch ) ? Filter::AncestorMatch : Filter::NoMatch;
+	}
+
+	if( descendantsRemoved && ( inputMatch & Filter::DescendantMatch ) )
+	{
+		// We can't know whether any descendants remain without
+		// visiting them all, so fall back to computing the whole set.
+		return FilteredSceneProcessor::computeSetMatch( setName, path, context, parent );
+	}
+
+	return inputMatch;
+}
@@ -405,12 +405,14 @@ IECore::ConstCompoundObjectPtr LightTweaks::computeProcessedAttributes( const Sc
 	}
 
 
+	const CompiledMatchPattern typePattern( type, /* multiple = */ true );
+
 	CompoundObjectPtr result = new CompoundObject;
 	const CompoundObject::ObjectMap &in = inputAttributes->members();
 	CompoundObject::ObjectMap &out = result->members();
 	for( CompoundObject::ObjectMap::const_iterator it = in.begin(), eIt = in.end(); it != eIt; ++it )
 	{
-		if( !matchMultiple( it->first, type ) )
+		if( !typePattern.match( it->first ) )
 		{
 			out.insert( *it );
 			continue;
@@ -34,6 +34,9 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
 #include "IECore/Primitive.h"
 
 #include "Gaffer/StringPlug.h"
@@ -48,6 +51,70 @@ using namespace GafferScene;
 
 IE_CORE_DEFINERUNTIMETYPED( MapOffset );
 
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+class Offsetter
+{
+
+	public :
+
+		Offsetter( const float *in, float offset, float *out )
+			:	m_in( in ), m_offset( offset ), m_out( out )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &range ) const
+		{
+			for( size_t i = range.begin(), e = range.end(); i < e; ++i )
+			{
+				m_out[i] = m_in[i] + m_offset;
+			}
+		}
+
+	private :
+
+		const float *m_in;
+		const float m_offset;
+		float *m_out;
+
+};
+
+// Replaces the named variable with an offset version of itself. The
+// input data is read directly and the result written to new data,
+// rather than copying the input data and then modifying it.
+void offsetVariable( Primitive *primitive, const std::string &name, float offset )
+{
+	PrimitiveVariableMap::iterator it = primitive->variables.find( name );
+	if( it == primitive->variables.end() )
+	{
+		return;
+	}
+
+	const FloatVectorData *inData = runTimeCast<const FloatVectorData>( it->second.data.get() );
+	if( !inData )
+	{
+		return;
+	}
+
+	const vector<float> &in = inData->readable();
+	FloatVectorDataPtr outData = new FloatVectorData;
+	vector<float> &out = outData->writable();
+	out.resize( in.size() );
+	if( !in.empty() )
+	{
+		tbb::parallel_for( tbb::blocked_range<size_t>( 0, in.size(), 1000 ), Offsetter( &in[0], offset, &out[0] ) );
+	}
+
+	it->second.data = outData;
+}
+
+} // namespace
+
 size_t MapOffset::g_firstPlugIndex = 0;
 
 MapOffset::MapOffset( const std::string &name )
@@ -156,7 +223,8 @@ IECore::ConstObjectPtr MapOffset::computeProcessedObject( const ScenePath &path,
 		return inputObject;
 	}
 
-	// do the work
+	// Do the work. The copy of the primitive shares all its data with the
+	// input, and we only replace the s and t variables.
 
 	PrimitivePtr result = inputPrimitive->copy();
 
@@ -166,21 +234,8 @@ IECore::ConstObjectPtr MapOffset::computeProcessedObject( const ScenePath &path,
 	offset.x += (udim - 1001) % 10;
 	offset.y += (udim - 1001) / 10;
 
-	if( FloatVectorDataPtr sData = result->variableData<FloatVectorData>( sName ) )
-	{
-		for( vector<float>::iterator it = sData->writable().begin(), eIt = sData->writable().end(); it != eIt; ++it )
-		{
-			*it += offset.x;
-		}
-	}
-
-	if( FloatVectorDataPtr tData = result->variableData<FloatVectorData>( tName ) )
-	{
-		for( vector<float>::iterator it = tData->writable().begin(), eIt = tData->writable().end(); it != eIt; ++it )
-		{
-			*it += offset.y;
-		}
-	}
+	offsetVariable( result.get(), sName, offset.x );
+	offsetVariable( result.get(), tName, offset.y );
 
 	return result;
 }
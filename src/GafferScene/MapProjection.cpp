@@ -34,7 +34,8 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
-#include "OpenEXR/ImathFun.h"
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
 
 #include "IECore/Primitive.h"
 #include "IECore/Camera.h"
@@ -52,6 +53,67 @@ using namespace GafferScene;
 
 IE_CORE_DEFINERUNTIMETYPED( MapProjection );
 
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Projects a range of points into the screen window of the camera,
+// writing the results into preallocated s and t arrays. The projection
+// type is a template parameter so that the inner loop is branch free.
+template<bool Perspective>
+class Projector
+{
+
+	public :
+
+		Projector( const V3f *p, const M44f &objectToCamera, float tanFOV, const Box2f &screenWindow, float *s, float *t )
+			:	m_p( p ), m_objectToCamera( objectToCamera ), m_tanFOV( tanFOV ), m_screenWindow( screenWindow ), m_s( s ), m_t( t )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &range ) const
+		{
+			const V2f screenMin = m_screenWindow.min;
+			const V2f screenSize = m_screenWindow.size();
+			for( size_t i = range.begin(), e = range.end(); i < e; ++i )
+			{
+				const V3f pCamera = m_p[i] * m_objectToCamera;
+				V2f pScreen( pCamera.x, pCamera.y );
+				if( Perspective )
+				{
+					pScreen /= pCamera.z * m_tanFOV;
+				}
+				// Map a degenerate screen window to 0, as
+				// Imath::lerpfactor() does.
+				m_s[i] = screenSize.x != 0.0f ? ( pScreen.x - screenMin.x ) / screenSize.x : 0.0f;
+				m_t[i] = screenSize.y != 0.0f ? ( pScreen.y - screenMin.y ) / screenSize.y : 0.0f;
+			}
+		}
+
+	private :
+
+		const V3f *m_p;
+		const M44f m_objectToCamera;
+		const float m_tanFOV;
+		const Box2f m_screenWindow;
+		float *m_s;
+		float *m_t;
+
+};
+
+// Returns the named parameter from the camera, or NULL if it
+// doesn't exist or has the wrong type.
+template<typename T>
+const T *cameraParameter( const Camera *camera, const char *name )
+{
+	return camera->parametersData()->member<T>( name );
+}
+
+} // namespace
+
 size_t MapProjection::g_firstPlugIndex = 0;
 
 MapProjection::MapProjection( const std::string &name )
@@ -175,50 +237,59 @@ IECore::ConstObjectPtr MapProjection::computeProcessedObject( const ScenePath &p
 	M44f objectMatrix = inPlug()->fullTransform( path );
 	M44f objectToCamera = objectMatrix * cameraMatrix.inverse();
 
-	CameraPtr camera = constCamera->copy();
-	camera->addStandardParameters();
+	// We only need to read a few parameters from the camera, so we avoid
+	// copying it unless it is missing parameters that must be filled in
+	// by addStandardParameters().
+	if(
+		!cameraParameter<StringData>( constCamera.get(), "projection" ) ||
+		!cameraParameter<FloatData>( constCamera.get(), "projection:fov" ) ||
+		!cameraParameter<Box2fData>( constCamera.get(), "screenWindow" )
+	)
+	{
+		CameraPtr camera = constCamera->copy();
+		camera->addStandardParameters();
+		constCamera = camera;
+	}
+
 	float tanFOV = -1;
-	if( camera->parametersData()->member<StringData>( "projection" )->readable() == "perspective" )
+	if( cameraParameter<StringData>( constCamera.get(), "projection" )->readable() == "perspective" )
 	{
-		const float fov = camera->parametersData()->member<FloatData>( "projection:fov" )->readable();
+		const float fov = cameraParameter<FloatData>( constCamera.get(), "projection:fov" )->readable();
 		tanFOV = tan( degreesToRadians( fov / 2.0f ) ); // camera x coordinate at screen window x==1
 	}
 
-	const Box2f &screenWindow = camera->parametersData()->member<Box2fData>( "screenWindow" )->readable();
+	const Box2f &screenWindow = cameraParameter<Box2fData>( constCamera.get(), "screenWindow" )->readable();
 
-	// do the work
+	// Do the work. The copy of the primitive shares all its existing data
+	// with the input, and we only add the new s and t variables.
 
 	PrimitivePtr result = inputPrimitive->copy();
 
+	const vector<V3f> &p = pData->readable();
+
 	FloatVectorDataPtr sData = new FloatVectorData();
 	FloatVectorDataPtr tData = new FloatVectorData();
+	vector<float> &s = sData->writable();
+	vector<float> &t = tData->writable();
+	s.resize( p.size() );
+	t.resize( p.size() );
 
 	result->variables[sName] = PrimitiveVariable( PrimitiveVariable::Vertex, sData );
 	result->variables[tName] = PrimitiveVariable( PrimitiveVariable::Vertex, tData );
 
-	const vector<V3f> &p = pData->readable();
-	vector<float> &s = sData->writable();
-	vector<float> &t = tData->writable();
-	s.reserve( p.size() );
-	t.reserve( p.size() );
+	if( p.empty() )
+	{
+		return result;
+	}
 
-	for( size_t i = 0, e = p.size(); i < e; ++i )
+	const tbb::blocked_range<size_t> range( 0, p.size(), 1000 );
+	if( tanFOV > 0.0f )
 	{
-		V3f pCamera = p[i] * objectToCamera;
-		V2f pScreen;
-		if( tanFOV > 0.0f )
-		{
-			// perspective
-			const float d = pCamera.z * tanFOV;
-			pScreen = V2f( pCamera.x / d, pCamera.y / d );
-		}
-		else
-		{
-			// orthographic
-			pScreen = V2f( pCamera.x, pCamera.y );
-		}
-		s.push_back( lerpfactor( pScreen.x, screenWindow.min.x, screenWindow.max.x ) );
-		t.push_back( lerpfactor( pScreen.y, screenWindow.min.y, screenWindow.max.y ) );
+		tbb::parallel_for( range, Projector<true>( &p[0], objectToCamera, tanFOV, screenWindow, &s[0], &t[0] ) );
+	}
+	else
+	{
+		tbb::parallel_for( range, Projector<false>( &p[0], objectToCamera, tanFOV, screenWindow, &s[0], &t[0] ) );
 	}
 
 	return result;
@@ -48,6 +48,18 @@ using namespace Gaffer;
 using namespace IECore;
 using namespace std;
 
+namespace
+{
+
+/// \todo Share this logic with Filter and Switch::variesWithContext().
+bool variesWithContext( const Plug *plug )
+{
+	const Plug *source = plug->source<Plug>();
+	return source->direction() == Plug::Out && IECore::runTimeCast<const ComputeNode>( source->node() );
+}
+
+} // namespace
+
 IE_CORE_DEFINERUNTIMETYPED( PathFilter );
 
 size_t PathFilter::g_firstPlugIndex = 0;
@@ -90,9 +102,7 @@ void PathFilter::plugDirtied( const Gaffer::Plug *plug )
 {
 	if( plug == pathsPlug() )
 	{
-		//\todo: share this logic with Switch::variesWithContext()
-		Plug* sourcePlug = pathsPlug()->source<Plug>();
-		if( sourcePlug->direction() == Plug::Out && IECore::runTimeCast<const ComputeNode>( sourcePlug->node() ) )
+		if( variesWithContext( pathsPlug() ) )
 		{
 			// pathsPlug() is receiving data from a plug whose value is context varying, meaning
 			// we need to use the intermediate pathMatcherPlug() in computeMatch() instead:
@@ -183,3 +193,56 @@ unsigned PathFilter::computeMatch( const ScenePlug *scene, const Gaffer::Context
 	}
 	return NoMatch;
 }
+
+void PathFilter::hashChildMatches( const ScenePlug *scene, const std::vector<IECore::InternedString> &parent, const std::vector<IECore::InternedString> &childNames, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	if( !m_pathMatcher && variesWithContext( pathsPlug() ) )
+	{
+		// The paths are computed, and may differ from child
+		// to child, so we must evaluate each child separately.
+		Filter::hashChildMatches( scene, parent, childNames, context, h );
+		return;
+	}
+
+	h.append( (uint64_t)parent.size() );
+	if( parent.size() )
+	{
+		h.append( &(parent[0]), parent.size() );
+	}
+	h.append( (uint64_t)childNames.size() );
+	if( childNames.size() )
+	{
+		h.append( &(childNames[0]), childNames.size() );
+	}
+
+	if( m_pathMatcher )
+	{
+		m_pathMatcher->hash( h );
+	}
+	else
+	{
+		pathMatcherPlug()->hash( h );
+	}
+}
+
+void PathFilter::computeChildMatches( const ScenePlug *scene, const std::vector<IECore::InternedString> &parent, const std::vector<IECore::InternedString> &childNames, const Gaffer::Context *context, std::vector<unsigned> &results ) const
+{
+	if( !m_pathMatcher && variesWithContext( pathsPlug() ) )
+	{
+		// See comments in hashChildMatches().
+		Filter::computeChildMatches( scene, parent, childNames, context, results );
+		return;
+	}
+
+	ConstPathMatcherDataPtr pathMatcherData = m_pathMatcher ? m_pathMatcher : pathMatcherPlug()->getValue();
+	const PathMatcher &pathMatcher = pathMatcherData->readable();
+
+	results.resize( childNames.size() );
+	ScenePlug::ScenePath childPath = parent;
+	childPath.push_back( InternedString() ); // for the child name
+	for( size_t i = 0, e = childNames.size(); i < e; ++i )
+	{
+		childPath.back() = childNames[i];
+		results[i] = pathMatcher.match( childPath );
+	}
+}
@@ -185,11 +185,15 @@ class InteractiveRender::SceneGraph
 			}
 
 			// Render Sets. We must obviously update these if
-			// the sets have changed, but we also need to do an
-			// update if the attributes have changed, because in
-			// that case we may have overwritten the sets attribute.
-
-			if( ( dirtyComponents & RenderSetsComponent ) || ( changedComponents & AttributesComponent ) )
+			// the sets have changed at this location or above, but
+			// we also need to do an update if the attributes have
+			// changed, because in that case we may have overwritten
+			// the sets attribute.
+
+			if(
+				( changedComponents & AttributesComponent ) ||
+				( ( dirtyComponents & RenderSetsComponent ) && ( renderSets.renderSetsChanges().match( path ) & ( Filter::ExactMatch | Filter::AncestorMatch ) ) )
+			)
 			{
 				if( updateRenderSets( path, renderSets ) )
 				{
@@ -527,6 +531,32 @@ class InteractiveRender::SceneGraphUpdateTask : public tbb::task
 		virtual task *execute()
 		{
 
+			// If only the sets have been dirtied, we need only visit
+			// the locations whose set memberships have changed, along
+			// with their ancestors and descendants. Everything else is
+			// already up to date.
+
+			if( m_dirtyComponents & SceneGraph::SetsComponent )
+			{
+				const unsigned setChangesMatch = this->setChangesMatch();
+				if(
+					setChangesMatch == Filter::NoMatch &&
+					!( m_dirtyComponents & ~( SceneGraph::SetsComponent | SceneGraph::RenderSetsComponent ) ) &&
+					!m_changedParentComponents
+				)
+				{
+					return NULL;
+				}
+
+				if( typeSetChangesMatch() & Filter::ExactMatch )
+				{
+					// The location has moved into or out of the
+					// type of scene graph we're constructing, so
+					// we must rebuild it from scratch.
+					m_sceneGraph->clear();
+				}
+			}
+
 			// Figure out if this location belongs in the type
 			// of scene graph we're constructing. If it doesn't
 			// belong, and neither do any of its descendants,
@@ -596,7 +626,36 @@ class InteractiveRender::SceneGraphUpdateTask : public tbb::task
 			return m_interactiveRender->inPlug();
 		}
 
-		/// \todo Fast path for when sets were not dirtied.
+		// Returns the match for this location against the changes
+		// in the sets which determine the type of scene graph.
+		unsigned typeSetChangesMatch() const
+		{
+			const RenderSets &renderSets = m_interactiveRender->m_renderSets;
+			switch( m_sceneGraphType )
+			{
+				case SceneGraph::CameraType :
+					return renderSets.camerasSetChanges().match( m_scenePath );
+				case SceneGraph::LightType :
+					return renderSets.lightsSetChanges().match( m_scenePath );
+				case SceneGraph::ObjectType :
+					return renderSets.lightsSetChanges().match( m_scenePath ) | renderSets.camerasSetChanges().match( m_scenePath );
+				default :
+					return Filter::NoMatch;
+			}
+		}
+
+		// Returns the match for this location against all the
+		// changes made to the sets in the last update.
+		unsigned setChangesMatch() const
+		{
+			unsigned result = typeSetChangesMatch();
+			if( m_dirtyComponents & SceneGraph::RenderSetsComponent )
+			{
+				result |= m_interactiveRender->m_renderSets.renderSetsChanges().match( m_scenePath );
+			}
+			return result;
+		}
+
 		const unsigned sceneGraphMatch() const
 		{
 			switch( m_sceneGraphType )
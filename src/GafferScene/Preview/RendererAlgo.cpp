@@ -180,6 +180,18 @@ InternedString g_lightsSetName( "__lights" );
 std::string g_renderSetsPrefix( "render:" );
 ConstInternedStringVectorDataPtr g_emptySetsAttribute = new InternedStringVectorData;
 
+// Adds the paths in `a` which are not in `b` to `result`.
+void addMissingPaths( const PathMatcher &a, const PathMatcher &b, PathMatcher &result )
+{
+	for( PathMatcher::Iterator it = a.begin(), eIt = a.end(); it != eIt; ++it )
+	{
+		if( !( b.match( *it ) & Filter::ExactMatch ) )
+		{
+			result.addPath( *it );
+		}
+	}
+}
+
 } // namespace
 
 namespace GafferScene
@@ -234,11 +246,19 @@ struct RenderSets::Updater
 
 			context->set( ScenePlug::setNameContextName, n );
 			const IECore::MurmurHash &hash = m_scene->setPlug()->hash();
+			s->changes = PathMatcher();
 			if( s->hash != hash )
 			{
-				s->set = m_scene->setPlug()->getValue( &hash )->readable();
+				ConstPathMatcherDataPtr setData = m_scene->setPlug()->getValue( &hash );
+				const PathMatcher &set = setData->readable();
+				addMissingPaths( s->set, set, s->changes );
+				addMissingPaths( set, s->set, s->changes );
+				s->set = set;
 				s->hash = hash;
-				changed |= potentialChange;
+				if( !s->changes.isEmpty() )
+				{
+					changed |= potentialChange;
+				}
 			}
 		}
 	}
@@ -272,6 +292,7 @@ RenderSets::RenderSets( const ScenePlug *scene )
 unsigned RenderSets::update( const ScenePlug *scene )
 {
 	unsigned changed = NothingChanged;
+	m_renderSetsChanges = PathMatcher();
 
 	// Figure out the names of the sets we want, and make
 	// sure we have an entry for each of them in m_renderSets.
@@ -294,6 +315,7 @@ unsigned RenderSets::update( const ScenePlug *scene )
 	{
 		if( std::find( setNames.begin(), setNames.end(), it->first ) == setNames.end() )
 		{
+			m_renderSetsChanges.addPaths( it->second.set );
 			it = m_sets.erase( it );
 			changed |= RenderSetsChanged;
 		}
@@ -308,6 +330,11 @@ unsigned RenderSets::update( const ScenePlug *scene )
 	Updater updater( scene, Context::current(), *this, changed );
 	parallel_reduce( tbb::blocked_range<size_t>( 0, m_sets.size() + 2 ), updater );
 
+	for( Sets::const_iterator it = m_sets.begin(), eIt = m_sets.end(); it != eIt; ++it )
+	{
+		m_renderSetsChanges.addPaths( it->second.changes );
+	}
+
 	return updater.changed;
 }
 
@@ -316,6 +343,7 @@ void RenderSets::clear()
 	m_sets.clear();
 	m_camerasSet = Set();
 	m_lightsSet = Set();
+	m_renderSetsChanges = PathMatcher();
 }
 
 const PathMatcher &RenderSets::camerasSet() const
@@ -328,6 +356,21 @@ const PathMatcher &RenderSets::lightsSet() const
 	return m_lightsSet.set;
 }
 
+const PathMatcher &RenderSets::camerasSetChanges() const
+{
+	return m_camerasSet.changes;
+}
+
+const PathMatcher &RenderSets::lightsSetChanges() const
+{
+	return m_lightsSet.changes;
+}
+
+const PathMatcher &RenderSets::renderSetsChanges() const
+{
+	return m_renderSetsChanges;
+}
+
 ConstInternedStringVectorDataPtr RenderSets::setsAttribute( const std::vector<IECore::InternedString> &path ) const
 {
 	InternedStringVectorDataPtr resultData = NULL;
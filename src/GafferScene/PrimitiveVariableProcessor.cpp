@@ -126,7 +126,7 @@ IECore::ConstObjectPtr PrimitiveVariableProcessor::computeProcessedObject( const
 		return inputObject;
 	}
 
-	const std::string names = namesPlug()->getValue();
+	const CompiledMatchPattern names( namesPlug()->getValue(), /* multiple = */ true );
 
 	bool invert = invertNamesPlug()->getValue();
 	IECore::PrimitivePtr result = inputGeometry->copy();
@@ -135,7 +135,7 @@ IECore::ConstObjectPtr PrimitiveVariableProcessor::computeProcessedObject( const
 	{
 		next = it;
 		next++;
-		if( matchMultiple( it->first, names ) != invert )
+		if( names.match( it->first ) != invert )
 		{
 			processPrimitiveVariable( path, context, inputGeometry, it->second );
 			if( it->second.interpolation == IECore::PrimitiveVariable::Invalid || !it->second.data )
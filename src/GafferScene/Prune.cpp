@@ -176,14 +176,7 @@ void Prune::hashChildNames( const ScenePath &path, const Gaffer::Context *contex
 		ConstInternedStringVectorDataPtr inputChildNamesData = inPlug()->childNamesPlug()->getValue();
 		const vector<InternedString> &inputChildNames = inputChildNamesData->readable();
 
-		ScenePath childPath = path;
-		childPath.push_back( InternedString() ); // for the child name
-		for( vector<InternedString>::const_iterator it = inputChildNames.begin(), eIt = inputChildNames.end(); it != eIt; ++it )
-		{
-			childPath[path.size()] = *it;
-			tmpContext->set( ScenePlug::scenePathContextName, childPath );
-			filterPlug()->hash( h );
-		}
+		childFilterHash( path, inputChildNames, context, h );
 	}
 	else
 	{
@@ -211,15 +204,13 @@ IECore::ConstInternedStringVectorDataPtr Prune::computeChildNames( const ScenePa
 		InternedStringVectorDataPtr outputChildNamesData = new InternedStringVectorData;
 		vector<InternedString> &outputChildNames = outputChildNamesData->writable();
 
-		ScenePath childPath = path;
-		childPath.push_back( InternedString() ); // for the child name
-		for( vector<InternedString>::const_iterator it = inputChildNames.begin(), eIt = inputChildNames.end(); it != eIt; ++it )
+		vector<unsigned> matches;
+		childFilterValues( path, inputChildNames, context, matches );
+		for( size_t i = 0, e = inputChildNames.size(); i < e; ++i )
 		{
-			childPath[path.size()] = *it;
-			tmpContext->set( ScenePlug::scenePathContextName, childPath );
-			if( !(filterPlug()->getValue() & Filter::ExactMatch) )
+			if( !(matches[i] & Filter::ExactMatch) )
 			{
-				outputChildNames.push_back( *it );
+				outputChildNames.push_back( inputChildNames[i] );
 			}
 		}
 
@@ -302,3 +293,68 @@ GafferScene::ConstPathMatcherDataPtr Prune::computeSet( const IECore::InternedSt
 
 	return outputSetData;
 }
+
+unsigned Prune::computeSetMatch( const IECore::InternedString &setName, const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const
+{
+	const unsigned inputMatch = inPlug()->setMatch( setName, path );
+	if( inputMatch == Filter::NoMatch )
+	{
+		return Filter::NoMatch;
+	}
+
+	// Walk down from the root to the path, evaluating the filter
+	// in the same way that computeSet() traverses the input set,
+	// to find the location at which the path is pruned, if any.
+
+	size_t prunedSize = path.size() + 1;
+	bool descendantsPruned = false;
+	{
+		ContextPtr tmpContext = filterContext( context );
+		Context::Scope scopedContext( tmpContext.get() );
+
+		ScenePath prefix;
+		prefix.reserve( path.size() );
+		for( size_t i = 0; i <= path.size(); ++i )
+		{
+			if( i )
+			{
+				prefix.push_back( path[i-1] );
+			}
+			tmpContext->set( ScenePlug::scenePathContextName, prefix );
+			const int m = filterPlug()->getValue();
+			if( m & ( Filter::ExactMatch | Filter::AncestorMatch ) )
+			{
+				prunedSize = i;
+				break;
+			}
+			else if( !( m & Filter::DescendantMatch ) )
+			{
+				// Nothing at or below here is pruned.
+				break;
+			}
+			descendantsPruned = i == path.size();
+		}
+	}
+
+	if( prunedSize <= path.size() )
+	{
+		// The path has been pruned, along with everything below
+		// the pruned location. Ancestors of that location remain.
+		if( !prunedSize )
+		{
+			return Filter::NoMatch;
+		}
+		const ScenePath ancestor( path.begin(), path.begin() + prunedSize - 1 );
+		const unsigned ancestorMatch = inPlug()->setMatch( setName, ancestor );
+		return ancestorMatch & ( Filter::ExactMatch | Filter::AncestorMatch ) ? Filter::AncestorMatch : Filter::NoMatch;
+	}
+
+	if( descendantsPruned && ( inputMatch & Filter::DescendantMatch ) )
+	{
+		// We can't know whether any descendants remain without
+		// visiting them all, so fall back to computing the whole set.
+		return FilteredSceneProcessor::computeSetMatch( setName, path, context, parent );
+	}
+
+	return inputMatch;
+}
@@ -486,20 +486,18 @@ void transformSamples( const ScenePlug *scene, size_t segments, const Imath::V2f
 
 	motionTimes( segments, shutter, sampleTimes );
 
-	ContextPtr timeContext = new Context( *Context::current(), Context::Borrowed );
-	Context::Scope scopedTimeContext( timeContext.get() );
+	const vector<float> times( sampleTimes.begin(), sampleTimes.end() );
+	const ScenePlug::ScenePath &path = Context::current()->get<ScenePlug::ScenePath>( ScenePlug::scenePathContextName );
+	GafferScene::transformSamples( scene, path, times, samples );
 
 	bool moving = false;
-	samples.reserve( sampleTimes.size() );
-	for( std::set<float>::const_iterator it = sampleTimes.begin(), eIt = sampleTimes.end(); it != eIt; ++it )
+	for( vector<M44f>::const_iterator it = samples.begin(), eIt = samples.end(); it != eIt; ++it )
 	{
-		timeContext->setFrame( *it );
-		const M44f m = scene->transformPlug()->getValue();
-		if( !moving && !samples.empty() && m != samples.front() )
+		if( *it != samples.front() )
 		{
 			moving = true;
+			break;
 		}
-		samples.push_back( m );
 	}
 
 	if( !moving )
@@ -541,20 +539,34 @@ void objectSamples( const ScenePlug *scene, size_t segments, const Imath::V2f &s
 
 	motionTimes( segments, shutter, sampleTimes );
 
-	ContextPtr timeContext = new Context( *Context::current(), Context::Borrowed );
-	Context::Scope scopedTimeContext( timeContext.get() );
+	const vector<float> times( sampleTimes.begin(), sampleTimes.end() );
+	const ScenePlug::ScenePath &path = Context::current()->get<ScenePlug::ScenePath>( ScenePlug::scenePathContextName );
+	vector<ConstObjectPtr> objects;
+	vector<MurmurHash> objectHashes;
+
+	// Only primitives can be motion blurred, so we evaluate the first
+	// sample on its own, and only evaluate the rest if it is one. This
+	// avoids redundant work at group locations, and for lights, cameras
+	// and procedurals.
+	GafferScene::objectSamples( scene, path, vector<float>( 1, times.front() ), objects, &objectHashes );
+	if( runTimeCast<const Primitive>( objects.front().get() ) && times.size() > 1 )
+	{
+		vector<ConstObjectPtr> remainingObjects;
+		vector<MurmurHash> remainingHashes;
+		GafferScene::objectSamples( scene, path, vector<float>( times.begin() + 1, times.end() ), remainingObjects, &remainingHashes );
+		objects.insert( objects.end(), remainingObjects.begin(), remainingObjects.end() );
+		objectHashes.insert( objectHashes.end(), remainingHashes.begin(), remainingHashes.end() );
+	}
 
 	bool moving = false;
 	MurmurHash lastHash;
-	samples.reserve( sampleTimes.size() );
-	for( std::set<float>::const_iterator it = sampleTimes.begin(), eIt = sampleTimes.end(); it != eIt; ++it )
+	samples.reserve( objects.size() );
+	for( size_t i = 0, e = objects.size(); i < e; ++i )
 	{
-		timeContext->setFrame( *it );
-
-		const MurmurHash objectHash = scene->objectPlug()->hash();
-		ConstObjectPtr object = scene->objectPlug()->getValue( &objectHash );
+		const Object *object = objects[i].get();
+		const MurmurHash &objectHash = objectHashes[i];
 
-		if( const Primitive *primitive = runTimeCast<const Primitive>( object.get() ) )
+		if( const Primitive *primitive = runTimeCast<const Primitive>( object ) )
 		{
 			// We can support multiple samples for these, so check to see
 			// if we actually have something moving.
@@ -565,7 +577,7 @@ void objectSamples( const ScenePlug *scene, size_t segments, const Imath::V2f &s
 			samples.push_back( primitive );
 			lastHash = objectHash;
 		}
-		else if( const VisibleRenderable *renderable = runTimeCast< const VisibleRenderable >( object.get() ) )
+		else if( const VisibleRenderable *renderable = runTimeCast< const VisibleRenderable >( object ) )
 		{
 			// We can't motion blur these chappies, so just take the one
 			// sample.
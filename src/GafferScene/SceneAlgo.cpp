@@ -36,7 +36,7 @@
 
 #include "tbb/spin_mutex.h"
 #include "tbb/task.h"
-#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
 
 #include "boost/algorithm/string/predicate.hpp"
 
@@ -48,6 +48,7 @@
 #include "IECore/VisibleRenderable.h"
 
 #include "Gaffer/Context.h"
+#include "Gaffer/ParallelAlgo.h"
 
 #include "GafferScene/SceneAlgo.h"
 #include "GafferScene/Filter.h"
@@ -202,19 +203,97 @@ IECore::TransformPtr GafferScene::transform( const ScenePlug *scene, const Scene
 		}
 	}
 
+	vector<float> times;
+	times.reserve( numSamples );
+	for( int i = 0; i < numSamples; i++ )
+	{
+		times.push_back( lerp( shutter[0], shutter[1], (float)i / std::max( 1, numSamples - 1 ) ) );
+	}
+
+	vector<M44f> samples;
+	fullTransformSamples( scene, path, times, samples );
+
 	MatrixMotionTransformPtr result = new MatrixMotionTransform();
-	ContextPtr transformContext = new Context( *Context::current(), Context::Borrowed );
-	Context::Scope scopedContext( transformContext.get() );
 	for( int i = 0; i < numSamples; i++ )
 	{
-		float frame = lerp( shutter[0], shutter[1], (float)i / std::max( 1, numSamples - 1 ) );
-		transformContext->setFrame( frame );
-		result->snapshots()[frame] = scene->fullTransform( path );
+		result->snapshots()[times[i]] = samples[i];
 	}
 
 	return result;
 }
 
+//////////////////////////////////////////////////////////////////////////
+// Motion sampling
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Evaluates `plug` at each of `times` in the current context. The
+// samples are evaluated serially, because there are typically only a
+// handful of them, and callers are usually already parallelised over
+// locations. Identical samples are shared via the compute cache, since
+// we pass it the hash we've already computed.
+template<typename PlugType, typename ValueType>
+void evaluateSamples( const PlugType *plug, const vector<float> &times, vector<ValueType> &samples, vector<MurmurHash> &hashes )
+{
+	ContextPtr timeContext = new Context( *Context::current(), Context::Borrowed );
+	Context::Scope scopedTimeContext( timeContext.get() );
+
+	hashes.resize( times.size() );
+	samples.resize( times.size() );
+	for( size_t i = 0, e = times.size(); i < e; ++i )
+	{
+		timeContext->setFrame( times[i] );
+		hashes[i] = plug->hash();
+		samples[i] = plug->getValue( &hashes[i] );
+	}
+}
+
+} // namespace
+
+void GafferScene::transformSamples( const ScenePlug *scene, const ScenePlug::ScenePath &path, const std::vector<float> &times, std::vector<Imath::M44f> &samples )
+{
+	ContextPtr pathContext = new Context( *Context::current(), Context::Borrowed );
+	pathContext->set( ScenePlug::scenePathContextName, path );
+	Context::Scope scopedPathContext( pathContext.get() );
+
+	vector<MurmurHash> hashes;
+	evaluateSamples( scene->transformPlug(), times, samples, hashes );
+}
+
+void GafferScene::fullTransformSamples( const ScenePlug *scene, const ScenePlug::ScenePath &path, const std::vector<float> &times, std::vector<Imath::M44f> &samples )
+{
+	ContextPtr pathContext = new Context( *Context::current(), Context::Borrowed );
+	Context::Scope scopedPathContext( pathContext.get() );
+
+	samples.assign( times.size(), M44f() );
+
+	vector<M44f> localSamples;
+	vector<MurmurHash> hashes;
+	ScenePlug::ScenePath p( path );
+	while( p.size() )
+	{
+		pathContext->set( ScenePlug::scenePathContextName, p );
+		evaluateSamples( scene->transformPlug(), times, localSamples, hashes );
+		for( size_t i = 0, e = times.size(); i < e; ++i )
+		{
+			samples[i] = samples[i] * localSamples[i];
+		}
+		p.pop_back();
+	}
+}
+
+void GafferScene::objectSamples( const ScenePlug *scene, const ScenePlug::ScenePath &path, const std::vector<float> &times, std::vector<IECore::ConstObjectPtr> &samples, std::vector<IECore::MurmurHash> *hashes )
+{
+	ContextPtr pathContext = new Context( *Context::current(), Context::Borrowed );
+	pathContext->set( ScenePlug::scenePathContextName, path );
+	Context::Scope scopedPathContext( pathContext.get() );
+
+	vector<MurmurHash> localHashes;
+	evaluateSamples( scene->objectPlug(), times, samples, hashes ? *hashes : localHashes );
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Camera algo
 // This is deprecated, and should be replaced by GafferScene::Preview::RendererAlgo::applyCameraGlobals
@@ -481,7 +560,7 @@ IECore::ConstCompoundDataPtr GafferScene::sets( const ScenePlug *scene, const st
 	setsVector.resize( setNames.size(), NULL );
 
 	Sets setsCompute( scene, Context::current(), setNames, setsVector );
-	parallel_for( tbb::blocked_range<size_t>( 0, setsVector.size() ), setsCompute );
+	isolatedParallelFor( tbb::blocked_range<size_t>( 0, setsVector.size() ), setsCompute );
 
 	CompoundDataPtr result = new CompoundData;
 	for( size_t i = 0, e = setsVector.size(); i < e; ++i )
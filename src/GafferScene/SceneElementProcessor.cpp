@@ -295,6 +295,73 @@ IECore::ConstCompoundObjectPtr SceneElementProcessor::computeProcessedAttributes
 	return inputAttributes;
 }
 
+IECore::ConstCompoundObjectPtr SceneElementProcessor::mergeAttributes( IECore::ConstCompoundObjectPtr inputAttributes, IECore::ConstCompoundObjectPtr newAttributes )
+{
+	const CompoundObject::ObjectMap &inputMembers = inputAttributes->members();
+	const CompoundObject::ObjectMap &newMembers = newAttributes->members();
+
+	if( newMembers.empty() )
+	{
+		return inputAttributes;
+	}
+	else if( inputMembers.empty() )
+	{
+		return newAttributes;
+	}
+
+	// See if we would actually change anything. This is common when
+	// several nodes in a chain assign the same values, and returning
+	// the input lets us avoid storing another map for the output. We
+	// only compare pointers, since the shared values from an upstream
+	// compute will be identical, and deep comparisons could cost more
+	// than the merge itself.
+	bool changed = false;
+	for( CompoundObject::ObjectMap::const_iterator it = newMembers.begin(), eIt = newMembers.end(); it != eIt; ++it )
+	{
+		CompoundObject::ObjectMap::const_iterator inputIt = inputMembers.find( it->first );
+		if( inputIt == inputMembers.end() || inputIt->second != it->second )
+		{
+			changed = true;
+			break;
+		}
+	}
+
+	if( !changed )
+	{
+		return inputAttributes;
+	}
+
+	// Since we're not going to modify any existing members (only add new ones),
+	// and our result becomes const on returning it, we can directly reference
+	// the input members in our result without copying. Be careful not to modify
+	// them though! Both maps are sorted, so we merge them in a single pass,
+	// always appending at the end of the result, rather than copying the input
+	// map and then looking up each new member in turn.
+	CompoundObjectPtr result = new CompoundObject;
+	CompoundObject::ObjectMap &resultMembers = result->members();
+	const CompoundObject::ObjectMap::key_compare keyLess = inputMembers.key_comp();
+	CompoundObject::ObjectMap::const_iterator inputIt = inputMembers.begin();
+	CompoundObject::ObjectMap::const_iterator newIt = newMembers.begin();
+	while( inputIt != inputMembers.end() || newIt != newMembers.end() )
+	{
+		if( newIt == newMembers.end() || ( inputIt != inputMembers.end() && keyLess( inputIt->first, newIt->first ) ) )
+		{
+			resultMembers.insert( resultMembers.end(), *inputIt++ );
+		}
+		else
+		{
+			if( inputIt != inputMembers.end() && !keyLess( newIt->first, inputIt->first ) )
+			{
+				// Replaced by the new member.
+				++inputIt;
+			}
+			resultMembers.insert( resultMembers.end(), *newIt++ );
+		}
+	}
+
+	return result;
+}
+
 bool SceneElementProcessor::processesObject() const
 {
 	return false;
@@ -101,6 +101,23 @@ void SceneNode::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outp
 	}
 }
 
+const std::vector<IECore::InternedString> *SceneNode::ignoredContextVariables( const Gaffer::ValuePlug *output ) const
+{
+	const ScenePlug *scenePlug = output->parent<ScenePlug>();
+	if( !scenePlug )
+	{
+		return ComputeNode::ignoredContextVariables( output );
+	}
+
+	if( output == scenePlug->globalsPlug() || output == scenePlug->setNamesPlug() || output == scenePlug->setPlug() )
+	{
+		static const std::vector<IECore::InternedString> g_globalIgnored( 1, ScenePlug::scenePathContextName );
+		return &g_globalIgnored;
+	}
+
+	return ComputeNode::ignoredContextVariables( output );
+}
+
 void SceneNode::hash( const ValuePlug *output, const Context *context, IECore::MurmurHash &h ) const
 {
 	const ScenePlug *scenePlug = output->parent<ScenePlug>();
@@ -349,6 +366,22 @@ GafferScene::ConstPathMatcherDataPtr SceneNode::computeSet( const IECore::Intern
 	throw IECore::NotImplementedException( string( typeName() ) + "::computeSet" );
 }
 
+unsigned SceneNode::computeSetMatch( const IECore::InternedString &setName, const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const
+{
+	return parent->setPlug()->getValue()->readable().match( path );
+}
+
+unsigned SceneNode::setMatch( const IECore::InternedString &setName, const ScenePath &path, const ScenePlug *parent ) const
+{
+	if( !enabledPlug()->getValue() )
+	{
+		// Derived classes are free to do what they want with
+		// the set when disabled, so we must defer to compute().
+		return parent->setPlug()->getValue()->readable().match( path );
+	}
+	return computeSetMatch( setName, path, Context::current(), parent );
+}
+
 IECore::MurmurHash SceneNode::hashOfTransformedChildBounds( const ScenePath &path, const ScenePlug *out, const IECore::InternedStringVectorData *childNamesData ) const
 {
 	ConstInternedStringVectorDataPtr computedChildNames;
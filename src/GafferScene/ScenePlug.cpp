@@ -41,6 +41,7 @@
 #include "Gaffer/StringAlgo.h"
 
 #include "GafferScene/ScenePlug.h"
+#include "GafferScene/SceneNode.h"
 #include "GafferScene/PathMatcherData.h"
 
 using namespace Gaffer;
@@ -379,6 +380,28 @@ ConstPathMatcherDataPtr ScenePlug::set( const IECore::InternedString &setName )
 	return setPlug()->getValue();
 }
 
+unsigned ScenePlug::setMatch( const IECore::InternedString &setName, const ScenePath &scenePath ) const
+{
+	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
+	tmpContext->set( setNameContextName, setName );
+	removeNonGlobalContextVariables( tmpContext.get() );
+	Context::Scope scopedContext( tmpContext.get() );
+
+	// If the set is computed by a SceneNode, we give it the opportunity
+	// to answer the query without computing the whole set.
+	const PathMatcherDataPlug *sourceSetPlug = setPlug()->source<PathMatcherDataPlug>();
+	const ScenePlug *sourceScenePlug = sourceSetPlug->parent<ScenePlug>();
+	if( sourceScenePlug && sourceScenePlug->direction() == Out )
+	{
+		if( const SceneNode *sourceNode = IECore::runTimeCast<const SceneNode>( sourceScenePlug->node() ) )
+		{
+			return sourceNode->setMatch( setName, scenePath, sourceScenePlug );
+		}
+	}
+
+	return sourceSetPlug->getValue()->readable().match( scenePath );
+}
+
 IECore::MurmurHash ScenePlug::boundHash( const ScenePath &scenePath ) const
 {
 	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
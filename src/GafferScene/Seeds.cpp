@@ -35,9 +35,16 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
-#include "IECore/PointDistributionOp.h"
+#include "boost/format.hpp"
+
+#include "tbb/blocked_range.h"
+
+#include "IECore/MeshPrimitive.h"
+#include "IECore/PointsPrimitive.h"
+#include "IECore/PointDistribution.h"
 
 #include "Gaffer/StringPlug.h"
+#include "Gaffer/ParallelAlgo.h"
 
 #include "GafferScene/Seeds.h"
 
@@ -47,6 +54,320 @@ using namespace IECore;
 using namespace Gaffer;
 using namespace GafferScene;
 
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Provides read-only access to a float primitive variable, regardless
+// of its interpolation. An accessor for a missing variable returns the
+// default value for every query.
+class FloatAccessor
+{
+
+	public :
+
+		FloatAccessor( const MeshPrimitive *mesh, const std::string &name, float defaultValue )
+			:	m_data( NULL ), m_interpolation( PrimitiveVariable::Constant ), m_constant( defaultValue )
+		{
+			PrimitiveVariableMap::const_iterator it = mesh->variables.find( name );
+			if( it == mesh->variables.end() )
+			{
+				return;
+			}
+
+			if( const FloatVectorData *d = runTimeCast<const FloatVectorData>( it->second.data.get() ) )
+			{
+				m_data = &d->readable();
+				m_interpolation = it->second.interpolation;
+			}
+			else if( const FloatData *d = runTimeCast<const FloatData>( it->second.data.get() ) )
+			{
+				m_constant = d->readable();
+			}
+			else
+			{
+				throw IECore::Exception( boost::str( boost::format( "Primitive variable \"%s\" has unsupported type \"%s\"" ) % name % it->second.data->typeName() ) );
+			}
+		}
+
+		bool isConstant() const
+		{
+			return !m_data;
+		}
+
+		float operator()( int face, int faceVertex, int vertex ) const
+		{
+			if( !m_data )
+			{
+				return m_constant;
+			}
+
+			switch( m_interpolation )
+			{
+				case PrimitiveVariable::Uniform :
+					return (*m_data)[face];
+				case PrimitiveVariable::Vertex :
+				case PrimitiveVariable::Varying :
+					return (*m_data)[vertex];
+				case PrimitiveVariable::FaceVarying :
+					return (*m_data)[faceVertex];
+				default :
+					return (*m_data)[0];
+			}
+		}
+
+	private :
+
+		const std::vector<float> *m_data;
+		PrimitiveVariable::Interpolation m_interpolation;
+		float m_constant;
+
+};
+
+// Scatters points over individual triangles, using the blue noise
+// PointDistribution in the UV space of the mesh. Because the distribution
+// is defined globally in UV space, the points are continuous across
+// triangle boundaries, and each triangle can be processed independently
+// of all others.
+class TriangleScatterer
+{
+
+	public :
+
+		TriangleScatterer( float density, std::vector<V3f> &points )
+			:	m_density( density ), m_points( points )
+		{
+		}
+
+		void scatter( const V2f uv[3], const V3f p[3], const float density[3] )
+		{
+			const V2f e0 = uv[1] - uv[0];
+			const V2f e1 = uv[2] - uv[0];
+			const float uvArea = 0.5f * fabs( e0.x * e1.y - e0.y * e1.x );
+			if( uvArea == 0.0f )
+			{
+				return;
+			}
+
+			const float area = 0.5f * ( ( p[1] - p[0] ) % ( p[2] - p[0] ) ).length();
+			if( area == 0.0f )
+			{
+				return;
+			}
+
+			m_uv = uv;
+			m_p = p;
+			m_triangleDensity = density;
+			m_d00 = e0.dot( e0 );
+			m_d01 = e0.dot( e1 );
+			m_d11 = e1.dot( e1 );
+			m_denominator = m_d00 * m_d11 - m_d01 * m_d01;
+
+			Box2f bound;
+			bound.extendBy( uv[0] );
+			bound.extendBy( uv[1] );
+			bound.extendBy( uv[2] );
+
+			DensitySampler densitySampler( *this );
+			PointEmitter pointEmitter( *this );
+			PointDistribution::defaultInstance()( bound, m_density * area / uvArea, densitySampler, pointEmitter );
+		}
+
+	private :
+
+		bool barycentric( const V2f &uv, V3f &result ) const
+		{
+			const V2f e0 = m_uv[1] - m_uv[0];
+			const V2f e1 = m_uv[2] - m_uv[0];
+			const V2f e2 = uv - m_uv[0];
+			const float d20 = e2.dot( e0 );
+			const float d21 = e2.dot( e1 );
+			result[1] = ( m_d11 * d20 - m_d01 * d21 ) / m_denominator;
+			result[2] = ( m_d00 * d21 - m_d01 * d20 ) / m_denominator;
+			result[0] = 1.0f - result[1] - result[2];
+			return result[0] >= 0.0f && result[1] >= 0.0f && result[2] >= 0.0f;
+		}
+
+		struct DensitySampler
+		{
+			DensitySampler( const TriangleScatterer &s ) : scatterer( s ) {}
+			float operator()( const V2f &uv ) const
+			{
+				V3f b;
+				if( !scatterer.barycentric( uv, b ) )
+				{
+					return 0.0f;
+				}
+				const float *d = scatterer.m_triangleDensity;
+				return b[0] * d[0] + b[1] * d[1] + b[2] * d[2];
+			}
+			const TriangleScatterer &scatterer;
+		};
+
+		struct PointEmitter
+		{
+			PointEmitter( const TriangleScatterer &s ) : scatterer( s ) {}
+			void operator()( const V2f &uv ) const
+			{
+				V3f b;
+				if( scatterer.barycentric( uv, b ) )
+				{
+					const V3f *p = scatterer.m_p;
+					scatterer.m_points.push_back( b[0] * p[0] + b[1] * p[1] + b[2] * p[2] );
+				}
+			}
+			const TriangleScatterer &scatterer;
+		};
+
+		const float m_density;
+		std::vector<V3f> &m_points;
+
+		const V2f *m_uv;
+		const V3f *m_p;
+		const float *m_triangleDensity;
+		float m_d00, m_d01, m_d11, m_denominator;
+
+};
+
+// The mesh is divided into fixed size chunks of faces, which
+// are scattered in parallel and then concatenated in order.
+// Since the chunking doesn't depend on the number of threads,
+// neither does the result.
+const int g_facesPerChunk = 1000;
+
+class ChunkScatterer
+{
+
+	public :
+
+		ChunkScatterer( const MeshPrimitive *mesh, const std::vector<int> &chunkFaceVertexOffsets, const FloatAccessor &s, const FloatAccessor &t, const FloatAccessor &density, float densityMultiplier, std::vector<std::vector<V3f> > &chunkPoints )
+			:	m_verticesPerFace( mesh->verticesPerFace()->readable() ),
+				m_vertexIds( mesh->vertexIds()->readable() ),
+				m_positions( mesh->variableData<V3fVectorData>( "P", PrimitiveVariable::Vertex )->readable() ),
+				m_chunkFaceVertexOffsets( chunkFaceVertexOffsets ),
+				m_s( s ), m_t( t ), m_density( density ), m_densityMultiplier( densityMultiplier ),
+				m_chunkPoints( chunkPoints )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &range ) const
+		{
+			for( size_t chunk = range.begin(); chunk != range.end(); ++chunk )
+			{
+				scatterChunk( chunk );
+			}
+		}
+
+	private :
+
+		void scatterChunk( size_t chunk ) const
+		{
+			TriangleScatterer scatterer( m_densityMultiplier, m_chunkPoints[chunk] );
+
+			const int beginFace = chunk * g_facesPerChunk;
+			const int endFace = min( beginFace + g_facesPerChunk, (int)m_verticesPerFace.size() );
+			int faceVertex = m_chunkFaceVertexOffsets[chunk];
+
+			V2f uv[3];
+			V3f p[3];
+			float density[3];
+			for( int face = beginFace; face < endFace; ++face )
+			{
+				const int numFaceVertices = m_verticesPerFace[face];
+				// Fan triangulation, matching TriangulateOp.
+				for( int i = 1; i < numFaceVertices - 1; ++i )
+				{
+					const int faceVertices[3] = { faceVertex, faceVertex + i, faceVertex + i + 1 };
+					for( int j = 0; j < 3; ++j )
+					{
+						const int vertex = m_vertexIds[faceVertices[j]];
+						uv[j] = V2f( m_s( face, faceVertices[j], vertex ), m_t( face, faceVertices[j], vertex ) );
+						p[j] = m_positions[vertex];
+						density[j] = m_density( face, faceVertices[j], vertex );
+					}
+					scatterer.scatter( uv, p, density );
+				}
+				faceVertex += numFaceVertices;
+			}
+		}
+
+		const std::vector<int> &m_verticesPerFace;
+		const std::vector<int> &m_vertexIds;
+		const std::vector<V3f> &m_positions;
+		const std::vector<int> &m_chunkFaceVertexOffsets;
+		const FloatAccessor &m_s;
+		const FloatAccessor &m_t;
+		const FloatAccessor &m_density;
+		const float m_densityMultiplier;
+		std::vector<std::vector<V3f> > &m_chunkPoints;
+
+};
+
+PointsPrimitivePtr scatter( const MeshPrimitive *mesh, float density, const std::string &densityPrimitiveVariable )
+{
+	if( !mesh->variableData<V3fVectorData>( "P", PrimitiveVariable::Vertex ) )
+	{
+		throw IECore::Exception( "MeshPrimitive has no \"P\" primitive variable" );
+	}
+
+	if( mesh->variables.find( "s" ) == mesh->variables.end() || mesh->variables.find( "t" ) == mesh->variables.end() )
+	{
+		throw IECore::Exception( "MeshPrimitive has no uv primitive variables" );
+	}
+
+	const FloatAccessor s( mesh, "s", 0.0f );
+	const FloatAccessor t( mesh, "t", 0.0f );
+	const FloatAccessor densityAccessor( mesh, densityPrimitiveVariable, 1.0f );
+
+	// Compute the offset of the first face-vertex in each chunk,
+	// so that chunks can be processed independently.
+	const vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+	const size_t numChunks = ( verticesPerFace.size() + g_facesPerChunk - 1 ) / g_facesPerChunk;
+	vector<int> chunkFaceVertexOffsets( numChunks, 0 );
+	int faceVertex = 0;
+	for( size_t face = 0, e = verticesPerFace.size(); face < e; ++face )
+	{
+		if( face % g_facesPerChunk == 0 )
+		{
+			chunkFaceVertexOffsets[face / g_facesPerChunk] = faceVertex;
+		}
+		faceVertex += verticesPerFace[face];
+	}
+
+	// Make sure the tile set is loaded before we use it
+	// from multiple threads.
+	PointDistribution::defaultInstance();
+
+	vector<vector<V3f> > chunkPoints( numChunks );
+	ChunkScatterer chunkScatterer( mesh, chunkFaceVertexOffsets, s, t, densityAccessor, density, chunkPoints );
+	isolatedParallelFor( tbb::blocked_range<size_t>( 0, numChunks ), chunkScatterer );
+
+	size_t numPoints = 0;
+	for( vector<vector<V3f> >::const_iterator it = chunkPoints.begin(), eIt = chunkPoints.end(); it != eIt; ++it )
+	{
+		numPoints += it->size();
+	}
+
+	V3fVectorDataPtr pointsData = new V3fVectorData;
+	vector<V3f> &points = pointsData->writable();
+	points.reserve( numPoints );
+	for( vector<vector<V3f> >::const_iterator it = chunkPoints.begin(), eIt = chunkPoints.end(); it != eIt; ++it )
+	{
+		points.insert( points.end(), it->begin(), it->end() );
+	}
+
+	return new PointsPrimitive( pointsData );
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Seeds
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( Seeds );
 
 size_t Seeds::g_firstPlugIndex = 0;
@@ -58,6 +379,7 @@ Seeds::Seeds( const std::string &name )
 	addChild( new StringPlug( "name", Plug::In, "seeds" ) );
 	addChild( new FloatPlug( "density", Plug::In, 1.0f, 0.0f ) );
 	addChild( new StringPlug( "pointType", Plug::In, "gl:point" ) );
+	addChild( new StringPlug( "densityPrimitiveVariable" ) );
 }
 
 Seeds::~Seeds()
@@ -94,11 +416,21 @@ const Gaffer::StringPlug *Seeds::pointTypePlug() const
 	return getChild<StringPlug>( g_firstPlugIndex + 2 );
 }
 
+Gaffer::StringPlug *Seeds::densityPrimitiveVariablePlug()
+{
+	return getChild<StringPlug>( g_firstPlugIndex + 3 );
+}
+
+const Gaffer::StringPlug *Seeds::densityPrimitiveVariablePlug() const
+{
+	return getChild<StringPlug>( g_firstPlugIndex + 3 );
+}
+
 void Seeds::affects( const Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	BranchCreator::affects( input, outputs );
 
-	if( input == densityPlug() || input == pointTypePlug() )
+	if( input == densityPlug() || input == pointTypePlug() || input == densityPrimitiveVariablePlug() )
 	{
 		outputs.push_back( outPlug()->objectPlug() );
 	}
@@ -155,6 +487,7 @@ void Seeds::hashBranchObject( const ScenePath &parentPath, const ScenePath &bran
 		h.append( inPlug()->objectHash( parentPath ) );
 		densityPlug()->hash( h );
 		pointTypePlug()->hash( h );
+		densityPrimitiveVariablePlug()->hash( h );
 		return;
 	}
 
@@ -172,11 +505,7 @@ IECore::ConstObjectPtr Seeds::computeBranchObject( const ScenePath &parentPath,
 			return outPlug()->objectPlug()->defaultValue();
 		}
 
-		PointDistributionOpPtr op = new PointDistributionOp();
-		op->meshParameter()->setValue( mesh->copy() );
-		op->densityParameter()->setNumericValue( densityPlug()->getValue() );
-
-		PrimitivePtr result = runTimeCast<Primitive>( op->operate() );
+		PointsPrimitivePtr result = scatter( mesh.get(), densityPlug()->getValue(), densityPrimitiveVariablePlug()->getValue() );
 		result->variables["type"] = PrimitiveVariable( PrimitiveVariable::Constant, new StringData( pointTypePlug()->getValue() ) );
 
 		return result;
@@ -129,7 +129,5 @@ unsigned SetFilter::computeMatch( const ScenePlug *scene, const Gaffer::Context
 	}
 
 	const ScenePlug::ScenePath &path = context->get<ScenePlug::ScenePath>( ScenePlug::scenePathContextName );
-	ConstPathMatcherDataPtr set = scene->set( setPlug()->getValue() );
-
-	return set->readable().match( path );
+	return scene->setMatch( setPlug()->getValue(), path );
 }
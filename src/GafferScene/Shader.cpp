@@ -63,7 +63,7 @@ IE_CORE_DEFINERUNTIMETYPED( Shader );
 size_t Shader::g_firstPlugIndex = 0;
 
 Shader::Shader( const std::string &name )
-	:	DependencyNode( name )
+	:	ComputeNode( name )
 {
 	storeIndexOfNextChild( g_firstPlugIndex );
 	addChild( new StringPlug( "name" ) );
@@ -73,6 +73,8 @@ Shader::Shader( const std::string &name )
 	addChild( new StringPlug( "__nodeName", Gaffer::Plug::In, name, Plug::Default & ~(Plug::Serialisable | Plug::AcceptsInputs), Context::NoSubstitutions ) );
 	addChild( new Color3fPlug( "__nodeColor", Gaffer::Plug::In, Color3f( 0.0f ) ) );
 	nodeColorPlug()->setFlags( Plug::Serialisable | Plug::AcceptsInputs, false );
+	addChild( new ObjectVectorPlug( "__outState", Gaffer::Plug::Out, new IECore::ObjectVector ) );
+	addChild( new CompoundObjectPlug( "__outAttributes", Gaffer::Plug::Out, new IECore::CompoundObject ) );
 
 	nameChangedSignal().connect( boost::bind( &Shader::nameChanged, this ) );
 	Metadata::nodeValueChangedSignal().connect( boost::bind( &Shader::nodeMetadataChanged, this, ::_1, ::_2, ::_3 ) );
@@ -154,6 +156,26 @@ const Gaffer::Color3fPlug *Shader::nodeColorPlug() const
 	return getChild<Color3fPlug>( g_firstPlugIndex + 5 );
 }
 
+Gaffer::ObjectVectorPlug *Shader::outStatePlug()
+{
+	return getChild<ObjectVectorPlug>( g_firstPlugIndex + 6 );
+}
+
+const Gaffer::ObjectVectorPlug *Shader::outStatePlug() const
+{
+	return getChild<ObjectVectorPlug>( g_firstPlugIndex + 6 );
+}
+
+Gaffer::CompoundObjectPlug *Shader::outAttributesPlug()
+{
+	return getChild<CompoundObjectPlug>( g_firstPlugIndex + 7 );
+}
+
+const Gaffer::CompoundObjectPlug *Shader::outAttributesPlug() const
+{
+	return getChild<CompoundObjectPlug>( g_firstPlugIndex + 7 );
+}
+
 IECore::MurmurHash Shader::attributesHash() const
 {
 	IECore::MurmurHash h;
@@ -163,27 +185,17 @@ IECore::MurmurHash Shader::attributesHash() const
 
 void Shader::attributesHash( IECore::MurmurHash &h ) const
 {
-	NetworkBuilder networkBuilder( this );
-	h.append( networkBuilder.stateHash() );
+	h.append( outAttributesPlug()->hash() );
 }
 
 IECore::ConstCompoundObjectPtr Shader::attributes() const
 {
-	IECore::CompoundObjectPtr result = new IECore::CompoundObject;
-	NetworkBuilder networkBuilder( this );
-	if( !networkBuilder.state()->members().empty() )
-	{
-		result->members()[typePlug()->getValue()] = boost::const_pointer_cast<IECore::ObjectVector>(
-			networkBuilder.state()
-		);
-	}
-	return result;
+	return outAttributesPlug()->getValue();
 }
 
 IECore::MurmurHash Shader::stateHash() const
 {
-	NetworkBuilder networkBuilder( this );
-	return networkBuilder.stateHash();
+	return outStatePlug()->hash();
 }
 
 void Shader::stateHash( IECore::MurmurHash &h ) const
@@ -193,13 +205,12 @@ void Shader::stateHash( IECore::MurmurHash &h ) const
 
 IECore::ConstObjectVectorPtr Shader::state() const
 {
-	NetworkBuilder networkBuilder( this );
-	return networkBuilder.state();
+	return outStatePlug()->getValue();
 }
 
 void Shader::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
-	DependencyNode::affects( input, outputs );
+	ComputeNode::affects( input, outputs );
 
 	if(
 		parametersPlug()->isAncestorOf( input ) ||
@@ -210,6 +221,9 @@ void Shader::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs
 		input->parent<Plug>() == nodeColorPlug()
 	)
 	{
+		outputs.push_back( outStatePlug() );
+		outputs.push_back( outAttributesPlug() );
+
 		const Plug *out = outPlug();
 		if( out )
 		{
@@ -231,6 +245,48 @@ void Shader::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs
 	}
 }
 
+void Shader::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	ComputeNode::hash( output, context, h );
+
+	if( output == outStatePlug() )
+	{
+		NetworkBuilder networkBuilder( this );
+		h.append( networkBuilder.stateHash() );
+	}
+	else if( output == outAttributesPlug() )
+	{
+		outStatePlug()->hash( h );
+		typePlug()->hash( h );
+	}
+}
+
+void Shader::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
+{
+	if( output == outStatePlug() )
+	{
+		NetworkBuilder networkBuilder( this );
+		static_cast<ObjectVectorPlug *>( output )->setValue( networkBuilder.state() );
+		return;
+	}
+
+	if( output == outAttributesPlug() )
+	{
+		IECore::CompoundObjectPtr result = new IECore::CompoundObject;
+		IECore::ConstObjectVectorPtr state = outStatePlug()->getValue();
+		if( !state->members().empty() )
+		{
+			result->members()[typePlug()->getValue()] = boost::const_pointer_cast<IECore::ObjectVector>( state );
+		}
+		static_cast<CompoundObjectPlug *>( output )->setValue( result );
+		return;
+	}
+
+	// Shaders don't compute anything on their other outputs - they
+	// are purely there to represent connections within the network.
+	output->setToDefault();
+}
+
 void Shader::parameterHash( const Gaffer::Plug *parameterPlug, NetworkBuilder &network, IECore::MurmurHash &h ) const
 {
 	const Plug *inputPlug = parameterPlug->source<Plug>();
@@ -35,18 +35,106 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <set>
+
+#include "boost/bind.hpp"
+
+#include "Gaffer/Context.h"
+
 #include "GafferScene/ShaderAssignment.h"
+#include "GafferScene/Filter.h"
+#include "GafferScene/Shader.h"
 
 using namespace IECore;
 using namespace Gaffer;
 using namespace GafferScene;
 
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Returns true if any parameter of the network is driven by a node
+// other than a Shader, such as an Expression or Random node. Such nodes
+// may read the per-location context variables, so the network may differ
+// from location to location.
+bool variesWithContext( const Shader *shader, std::set<const Shader *> &visited )
+{
+	if( !visited.insert( shader ).second )
+	{
+		return false;
+	}
+
+	for( RecursiveInputPlugIterator it( shader ); !it.done(); ++it )
+	{
+		const Plug *plug = it->get();
+		if( !plug->getInput<Plug>() )
+		{
+			continue;
+		}
+
+		const Plug *source = plug->source<Plug>();
+		if( source->direction() != Plug::Out )
+		{
+			continue;
+		}
+
+		const Shader *inputShader = runTimeCast<const Shader>( source->node() );
+		if( inputShader && ( source == inputShader->outPlug() || inputShader->outPlug()->isAncestorOf( source ) ) )
+		{
+			if( variesWithContext( inputShader, visited ) )
+			{
+				return true;
+			}
+		}
+		else if( runTimeCast<const ComputeNode>( source->node() ) )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool variesWithContext( const ShaderPlug *plug )
+{
+	const Plug *source = plug->source<Plug>();
+	const Shader *shader = runTimeCast<const Shader>( source->node() );
+	if( source == plug || !shader )
+	{
+		return false;
+	}
+	std::set<const Shader *> visited;
+	return variesWithContext( shader, visited );
+}
+
+// The shader network is usually the same for every location we assign
+// it to, but the context we're called in varies per location. Evaluating
+// the network in a context without the per-location variables means that
+// the hash cache sees a single context, so the network is hashed (and
+// built) once rather than once per location.
+ContextPtr shaderContext( const Context *context )
+{
+	ContextPtr result = new Context( *context, Context::Borrowed );
+	result->remove( Filter::inputSceneContextName );
+	result->remove( ScenePlug::scenePathContextName );
+	return result;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// ShaderAssignment
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( ShaderAssignment );
 
 size_t ShaderAssignment::g_firstPlugIndex = 0;
 
 ShaderAssignment::ShaderAssignment( const std::string &name )
-	:	SceneElementProcessor( name )
+	:	SceneElementProcessor( name ), m_shaderVariesWithContext( false )
 {
 	storeIndexOfNextChild( g_firstPlugIndex );
 	addChild( new ShaderPlug( "shader" ) );
@@ -55,6 +143,8 @@ ShaderAssignment::ShaderAssignment( const std::string &name )
 	outPlug()->objectPlug()->setInput( inPlug()->objectPlug() );
 	outPlug()->transformPlug()->setInput( inPlug()->transformPlug() );
 	outPlug()->boundPlug()->setInput( inPlug()->boundPlug() );
+
+	plugDirtiedSignal().connect( boost::bind( &ShaderAssignment::plugDirtied, this, ::_1 ) );
 }
 
 ShaderAssignment::~ShaderAssignment()
@@ -81,6 +171,17 @@ void ShaderAssignment::affects( const Gaffer::Plug *input, AffectedPlugsContaine
 	}
 }
 
+void ShaderAssignment::plugDirtied( const Gaffer::Plug *plug )
+{
+	if( plug == shaderPlug() )
+	{
+		// Any edit to the network, including new connections into it,
+		// dirties shaderPlug(), so this is our chance to decide whether
+		// or not the network can be shared between locations.
+		m_shaderVariesWithContext = variesWithContext( shaderPlug() );
+	}
+}
+
 bool ShaderAssignment::processesAttributes() const
 {
 	return true;
@@ -88,27 +189,29 @@ bool ShaderAssignment::processesAttributes() const
 
 void ShaderAssignment::hashProcessedAttributes( const ScenePath &path, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
+	if( m_shaderVariesWithContext )
+	{
+		h.append( shaderPlug()->attributesHash() );
+		return;
+	}
+
+	ContextPtr c = shaderContext( context );
+	Context::Scope scope( c.get() );
 	h.append( shaderPlug()->attributesHash() );
 }
 
 IECore::ConstCompoundObjectPtr ShaderAssignment::computeProcessedAttributes( const ScenePath &path, const Gaffer::Context *context, IECore::ConstCompoundObjectPtr inputAttributes ) const
 {
-	ConstCompoundObjectPtr attributes = shaderPlug()->attributes();
-	if( attributes->members().empty() )
+	ConstCompoundObjectPtr attributes;
+	if( m_shaderVariesWithContext )
 	{
-		return inputAttributes;
+		attributes = shaderPlug()->attributes();
 	}
-
-	CompoundObjectPtr result = new CompoundObject;
-	// Since we're not going to modify any existing members (only add new ones),
-	// and our result becomes const on returning it, we can directly reference
-	// the input members in our result without copying. Be careful not to modify
-	// them though!
-	result->members() = inputAttributes->members();
-	for( CompoundObject::ObjectMap::const_iterator it = attributes->members().begin(), eIt = attributes->members().end(); it != eIt; ++it )
+	else
 	{
-		result->members()[it->first] = it->second;
+		ContextPtr c = shaderContext( context );
+		Context::Scope scope( c.get() );
+		attributes = shaderPlug()->attributes();
 	}
-
-	return result;
+	return mergeAttributes( inputAttributes, attributes );
 }
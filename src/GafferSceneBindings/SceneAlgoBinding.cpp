@@ -129,6 +129,61 @@ IECore::CompoundDataPtr setsWrapper2( const ScenePlug *scene, object pythonSetNa
 	return copy ? result->copy() : boost::const_pointer_cast<IECore::CompoundData>( result );
 }
 
+list transformSamplesWrapper( const ScenePlug *scene, const ScenePlug::ScenePath &path, object pythonTimes, bool full )
+{
+	std::vector<float> times;
+	boost::python::container_utils::extend_container( times, pythonTimes );
+
+	std::vector<Imath::M44f> samples;
+	{
+		IECorePython::ScopedGILRelease r;
+		if( full )
+		{
+			fullTransformSamples( scene, path, times, samples );
+		}
+		else
+		{
+			transformSamples( scene, path, times, samples );
+		}
+	}
+
+	list result;
+	for( std::vector<Imath::M44f>::const_iterator it = samples.begin(), eIt = samples.end(); it != eIt; ++it )
+	{
+		result.append( *it );
+	}
+	return result;
+}
+
+list transformSamplesWrapper1( const ScenePlug *scene, const ScenePlug::ScenePath &path, object pythonTimes )
+{
+	return transformSamplesWrapper( scene, path, pythonTimes, false );
+}
+
+list fullTransformSamplesWrapper( const ScenePlug *scene, const ScenePlug::ScenePath &path, object pythonTimes )
+{
+	return transformSamplesWrapper( scene, path, pythonTimes, true );
+}
+
+list objectSamplesWrapper( const ScenePlug *scene, const ScenePlug::ScenePath &path, object pythonTimes, bool copy )
+{
+	std::vector<float> times;
+	boost::python::container_utils::extend_container( times, pythonTimes );
+
+	std::vector<IECore::ConstObjectPtr> samples;
+	{
+		IECorePython::ScopedGILRelease r;
+		objectSamples( scene, path, times, samples );
+	}
+
+	list result;
+	for( std::vector<IECore::ConstObjectPtr>::const_iterator it = samples.begin(), eIt = samples.end(); it != eIt; ++it )
+	{
+		result.append( copy ? (*it)->copy() : boost::const_pointer_cast<IECore::Object>( *it ) );
+	}
+	return result;
+}
+
 } // namespace
 
 namespace GafferSceneBindings
@@ -152,6 +207,13 @@ void bindSceneAlgo()
 		&cameraWrapper2,
 		( arg( "scene" ), args( "cameraPath" ), arg( "globals" ) = object() )
 	);
+	def( "transformSamples", &transformSamplesWrapper1 );
+	def( "fullTransformSamples", &fullTransformSamplesWrapper );
+	def(
+		"objectSamples",
+		&objectSamplesWrapper,
+		( arg( "scene" ), arg( "path" ), arg( "times" ), arg( "_copy" ) = true )
+	);
 	def( "setExists", &setExistsWrapper );
 	def(
 		"sets",
@@ -196,6 +196,12 @@ PathMatcherDataPtr setWrapper( const ScenePlug &plug, const IECore::InternedStri
 	return copy ? s->copy() : boost::const_pointer_cast<PathMatcherData>( s );
 }
 
+unsigned setMatchWrapper( const ScenePlug &plug, const IECore::InternedString &setName, const ScenePlug::ScenePath &scenePath )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return plug.setMatch( setName, scenePath );
+}
+
 IECore::MurmurHash boundHashWrapper( const ScenePlug &plug, const ScenePlug::ScenePath &scenePath )
 {
 	IECorePython::ScopedGILRelease gilRelease;
@@ -295,6 +301,7 @@ void GafferSceneBindings::bindScenePlug()
 		.def( "globals", &globalsWrapper, ( boost::python::arg_( "_copy" ) = true ) )
 		.def( "setNames", &setNamesWrapper, ( boost::python::arg_( "_copy" ) = true ) )
 		.def( "set", &setWrapper, ( boost::python::arg_( "_copy" ) = true ) )
+		.def( "setMatch", &setMatchWrapper )
 		// hash accessors
 		.def( "boundHash", &boundHashWrapper )
 		.def( "transformHash", &transformHashWrapper )
@@ -146,7 +146,14 @@ BOOST_PYTHON_MODULE( _GafferScene )
 	bindOptions();
 	bindGroup();
 
-	GafferBindings::DependencyNodeClass<AlembicSource>();
+	GafferBindings::DependencyNodeClass<AlembicSource>()
+		.def( "getInputCacheLimit", &AlembicSource::getInputCacheLimit )
+		.staticmethod( "getInputCacheLimit" )
+		.def( "setInputCacheLimit", &AlembicSource::setInputCacheLimit )
+		.staticmethod( "setInputCacheLimit" )
+		.def( "inputCacheUsage", &AlembicSource::inputCacheUsage )
+		.staticmethod( "inputCacheUsage" )
+	;
 	GafferBindings::DependencyNodeClass<SubTree>();
 	GafferBindings::DependencyNodeClass<Light>();
 	GafferBindings::DependencyNodeClass<Prune>();
@@ -0,0 +1,167 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "tbb/atomic.h"
+
+#include "GafferSceneTest/CapturingRenderer.h"
+
+using namespace IECore;
+using namespace IECoreScenePreview;
+using namespace GafferSceneTest;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+tbb::atomic<size_t> g_attributesCreated;
+tbb::atomic<size_t> g_objectsCreated;
+tbb::atomic<size_t> g_attributeEdits;
+tbb::atomic<size_t> g_transformEdits;
+
+class CapturingAttributes : public Renderer::AttributesInterface
+{
+};
+
+class CapturingObject : public Renderer::ObjectInterface
+{
+
+	public :
+
+		virtual void transform( const Imath::M44f &transform )
+		{
+			++g_transformEdits;
+		}
+
+		virtual void transform( const std::vector<Imath::M44f> &samples, const std::vector<float> &times )
+		{
+			++g_transformEdits;
+		}
+
+		virtual bool attributes( const Renderer::AttributesInterface *attributes )
+		{
+			++g_attributeEdits;
+			return true;
+		}
+
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// CapturingRenderer
+//////////////////////////////////////////////////////////////////////////
+
+Renderer::TypeDescription<CapturingRenderer> CapturingRenderer::g_typeDescription( "Capturing" );
+
+CapturingRenderer::Statistics::Statistics()
+	:	attributesCreated( 0 ), objectsCreated( 0 ), attributeEdits( 0 ), transformEdits( 0 )
+{
+}
+
+CapturingRenderer::CapturingRenderer( RenderType renderType, const std::string &fileName )
+{
+}
+
+CapturingRenderer::~CapturingRenderer()
+{
+}
+
+CapturingRenderer::Statistics CapturingRenderer::statistics()
+{
+	Statistics result;
+	result.attributesCreated = g_attributesCreated;
+	result.objectsCreated = g_objectsCreated;
+	result.attributeEdits = g_attributeEdits;
+	result.transformEdits = g_transformEdits;
+	return result;
+}
+
+void CapturingRenderer::resetStatistics()
+{
+	g_attributesCreated = 0;
+	g_objectsCreated = 0;
+	g_attributeEdits = 0;
+	g_transformEdits = 0;
+}
+
+void CapturingRenderer::option( const IECore::InternedString &name, const IECore::Data *value )
+{
+}
+
+void CapturingRenderer::output( const IECore::InternedString &name, const Output *output )
+{
+}
+
+Renderer::AttributesInterfacePtr CapturingRenderer::attributes( const IECore::CompoundObject *attributes )
+{
+	++g_attributesCreated;
+	return new CapturingAttributes;
+}
+
+Renderer::ObjectInterfacePtr CapturingRenderer::camera( const std::string &name, const IECore::Camera *camera, const AttributesInterface *attributes )
+{
+	++g_objectsCreated;
+	return new CapturingObject;
+}
+
+Renderer::ObjectInterfacePtr CapturingRenderer::light( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes )
+{
+	++g_objectsCreated;
+	return new CapturingObject;
+}
+
+Renderer::ObjectInterfacePtr CapturingRenderer::object( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes )
+{
+	++g_objectsCreated;
+	return new CapturingObject;
+}
+
+Renderer::ObjectInterfacePtr CapturingRenderer::object( const std::string &name, const std::vector<const IECore::Object *> &samples, const std::vector<float> &times, const AttributesInterface *attributes )
+{
+	++g_objectsCreated;
+	return new CapturingObject;
+}
+
+void CapturingRenderer::render()
+{
+}
+
+void CapturingRenderer::pause()
+{
+}
@@ -47,6 +47,7 @@
 #include "GafferSceneTest/TestLight.h"
 #include "GafferSceneTest/ScenePlugTest.h"
 #include "GafferSceneTest/PathMatcherTest.h"
+#include "GafferSceneTest/CapturingRenderer.h"
 
 using namespace boost::python;
 using namespace GafferSceneTest;
@@ -74,4 +75,18 @@ BOOST_PYTHON_MODULE( _GafferSceneTest )
 	def( "testPathMatcherIteratorPrune", &testPathMatcherIteratorPrune );
 	def( "testPathMatcherFind", &testPathMatcherFind );
 
+	{
+		scope s = class_<CapturingRenderer, boost::noncopyable>( "CapturingRenderer", no_init )
+			.def( "statistics", &CapturingRenderer::statistics ).staticmethod( "statistics" )
+			.def( "resetStatistics", &CapturingRenderer::resetStatistics ).staticmethod( "resetStatistics" )
+		;
+
+		class_<CapturingRenderer::Statistics>( "Statistics" )
+			.def_readonly( "attributesCreated", &CapturingRenderer::Statistics::attributesCreated )
+			.def_readonly( "objectsCreated", &CapturingRenderer::Statistics::objectsCreated )
+			.def_readonly( "attributeEdits", &CapturingRenderer::Statistics::attributeEdits )
+			.def_readonly( "transformEdits", &CapturingRenderer::Statistics::transformEdits )
+		;
+	}
+
 }
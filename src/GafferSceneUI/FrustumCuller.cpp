@@ -0,0 +1,114 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "GafferSceneUI/FrustumCuller.h"
+
+using namespace Imath;
+using namespace GafferSceneUI;
+
+FrustumCuller::FrustumCuller( const Imath::V2i &viewportSize, float minimumScreenSize )
+	:	m_viewportSize( viewportSize ), m_minimumScreenSize( minimumScreenSize )
+{
+}
+
+FrustumCuller::Visibility FrustumCuller::visibility( const Imath::Box3f &bound, const Imath::M44f &objectToClip, bool parentContained ) const
+{
+	if( bound.isEmpty() )
+	{
+		return Culled;
+	}
+
+	// Transform the corners into homogeneous clip space, where the
+	// frustum is defined by -w <= x, y, z <= w. For each of the six
+	// planes we count the corners which lie outside it.
+
+	int outside[6] = { 0, 0, 0, 0, 0, 0 };
+	bool allInside = true;
+	bool allInFront = true;
+	Box2f ndcBound;
+	for( int i = 0; i < 8; ++i )
+	{
+		const V3f p(
+			i & 1 ? bound.max.x : bound.min.x,
+			i & 2 ? bound.max.y : bound.min.y,
+			i & 4 ? bound.max.z : bound.min.z
+		);
+
+		const V4f c = V4f( p.x, p.y, p.z, 1.0f ) * objectToClip;
+
+		const bool o[6] = { c.x < -c.w, c.x > c.w, c.y < -c.w, c.y > c.w, c.z < -c.w, c.z > c.w };
+		for( int j = 0; j < 6; ++j )
+		{
+			outside[j] += o[j];
+			allInside = allInside && !o[j];
+		}
+
+		if( c.w > 0.0f )
+		{
+			ndcBound.extendBy( V2f( c.x / c.w, c.y / c.w ) );
+		}
+		else
+		{
+			allInFront = false;
+		}
+	}
+
+	if( !parentContained )
+	{
+		for( int j = 0; j < 6; ++j )
+		{
+			if( outside[j] == 8 )
+			{
+				return Culled;
+			}
+		}
+	}
+
+	// We can only measure the projected size reliably if the
+	// whole bound is in front of the camera.
+	if( allInFront && m_minimumScreenSize > 0.0f )
+	{
+		const V2f screenSize = ndcBound.size() * m_viewportSize * 0.5f;
+		if( std::max( screenSize.x, screenSize.y ) < m_minimumScreenSize )
+		{
+			return StandIn;
+		}
+	}
+
+	return parentContained || allInside ? Contained : Intersecting;
+}
@@ -34,13 +34,20 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "tbb/task.h"
 #include "tbb/concurrent_unordered_set.h"
 
 #include "boost/bind.hpp"
 #include "boost/algorithm/string/predicate.hpp"
 
+#include "OpenEXR/ImathPlane.h"
+
 #include "IECore/CurvesPrimitive.h"
+#include "IECore/MeshPrimitive.h"
 #include "IECore/MessageHandler.h"
 
 #include "IECoreGL/Renderable.h"
@@ -48,10 +55,12 @@
 #include "IECoreGL/Primitive.h"
 #include "IECoreGL/Selector.h"
 #include "IECoreGL/CurvesPrimitive.h"
+#include "IECoreGL/MeshPrimitive.h"
 
 #include "GafferUI/ViewportGadget.h"
 
 #include "GafferSceneUI/SceneGadget.h"
+#include "GafferSceneUI/FrustumCuller.h"
 #include "GafferSceneUI/ObjectVisualiser.h"
 #include "GafferSceneUI/AttributeVisualiser.h"
 
@@ -162,7 +171,7 @@ class SceneGadget::SceneGraph
 	public :
 
 		SceneGraph()
-			:	m_selected( false ), m_visible( true ), m_expanded( false )
+			:	m_selected( false ), m_visible( true ), m_expanded( false ), m_cullable( true ), m_isMesh( false )
 		{
 		}
 
@@ -171,13 +180,31 @@ class SceneGadget::SceneGraph
 			clear();
 		}
 
-		void render( IECoreGL::State *currentState, IECoreGL::Selector *selector = NULL ) const
+		// If a culler is provided, locations outside the frustum are skipped,
+		// and locations which are too small to see are drawn as a bounding box.
+		// The parentToClip matrix is only used when culling.
+		void render( IECoreGL::State *currentState, IECoreGL::Selector *selector = NULL, const FrustumCuller *culler = NULL, const M44f &parentToClip = M44f(), bool parentContained = false ) const
 		{
 			if( !m_visible || !valid() )
 			{
 				return;
 			}
 
+			M44f objectToClip;
+			FrustumCuller::Visibility visibility = FrustumCuller::Intersecting;
+			if( culler )
+			{
+				objectToClip = m_transform * parentToClip;
+				if( m_cullable )
+				{
+					visibility = culler->visibility( m_bound, objectToClip, parentContained );
+					if( visibility == FrustumCuller::Culled )
+					{
+						return;
+					}
+				}
+			}
+
 			const bool haveTransform = m_transform != M44f();
 			if( haveTransform )
 			{
@@ -194,25 +221,14 @@ class SceneGadget::SceneGraph
 						m_selectionId = selector->loadName();
 					}
 
-					if( m_renderable )
-					{
-						m_renderable->render( currentState );
-					}
-
-					if( m_attributesRenderable )
-					{
-						m_attributesRenderable->render( currentState );
-					}
-
-					if( m_boundRenderable )
+					if( visibility == FrustumCuller::StandIn )
 					{
 						IECoreGL::State::ScopedBinding wireframeScope( wireframeState(), *currentState );
-						m_boundRenderable->render( currentState );
+						renderStandIn( currentState );
 					}
-
-					for( std::vector<SceneGraph *>::const_iterator it = m_children.begin(), eIt = m_children.end(); it != eIt; ++it )
+					else
 					{
-						(*it)->render( currentState, selector );
+						renderContents( currentState, selector, culler, objectToClip, visibility == FrustumCuller::Contained );
 					}
 				}
 
@@ -228,6 +244,7 @@ class SceneGadget::SceneGraph
 			applySelectionWalk( selection, rootPath, true );
 		}
 
+
 		bool pathFromSelectionId( GLuint selectionId, ScenePlug::ScenePath &path ) const
 		{
 			path.clear();
@@ -273,12 +290,59 @@ class SceneGadget::SceneGraph
 			deferReferenceRemoval( m_boundRenderable );
 			deferReferenceRemoval( m_attributesRenderable );
 			clearChildren();
+			m_isMesh = false;
 			m_objectHash = m_attributesHash = IECore::MurmurHash();
 		}
 
 	private :
 
 		friend class UpdateTask;
+		friend class PickIndex;
+
+		void renderContents( IECoreGL::State *currentState, IECoreGL::Selector *selector, const FrustumCuller *culler, const M44f &objectToClip, bool contained ) const
+		{
+			if( m_renderable )
+			{
+				m_renderable->render( currentState );
+			}
+
+			if( m_attributesRenderable )
+			{
+				m_attributesRenderable->render( currentState );
+			}
+
+			if( m_boundRenderable )
+			{
+				IECoreGL::State::ScopedBinding wireframeScope( wireframeState(), *currentState );
+				m_boundRenderable->render( currentState );
+			}
+
+			for( std::vector<SceneGraph *>::const_iterator it = m_children.begin(), eIt = m_children.end(); it != eIt; ++it )
+			{
+				(*it)->render( currentState, selector, culler, objectToClip, contained );
+			}
+		}
+
+		// Draws our bound using a unit cube scaled to fit, so that
+		// we don't need to make a renderable for every location.
+		void renderStandIn( IECoreGL::State *currentState ) const
+		{
+			static IECoreGL::ConstRenderablePtr g_unitBox;
+			if( !g_unitBox )
+			{
+				IECore::CurvesPrimitivePtr curvesBox = IECore::CurvesPrimitive::createBox( Box3f( V3f( 0 ), V3f( 1 ) ) );
+				g_unitBox = boost::static_pointer_cast<const IECoreGL::Renderable>(
+					IECoreGL::CachedConverter::defaultCachedConverter()->convert( curvesBox.get() )
+				);
+			}
+
+			const V3f size = m_bound.size();
+			glPushMatrix();
+			glTranslatef( m_bound.min.x, m_bound.min.y, m_bound.min.z );
+			glScalef( size.x, size.y, size.z );
+			g_unitBox->render( currentState );
+			glPopMatrix();
+		}
 
 		void clearChildren()
 		{
@@ -368,6 +432,13 @@ class SceneGadget::SceneGraph
 		bool m_selected;
 		bool m_visible;
 		bool m_expanded;
+		// False if we have something to draw which isn't
+		// accounted for by m_bound, in which case we mustn't
+		// be culled.
+		bool m_cullable;
+		// True if m_renderable is a mesh with vertex positions,
+		// so that the PickIndex can intersect its triangles.
+		bool m_isMesh;
 
 		IECore::MurmurHash m_objectHash;
 		IECore::MurmurHash m_attributesHash;
@@ -466,9 +537,15 @@ class SceneGadget::UpdateTask : public tbb::task
 				{
 					IECore::ConstObjectPtr object = m_sceneGadget->m_scene->objectPlug()->getValue( &objectHash );
 					deferReferenceRemoval( m_sceneGraph->m_renderable );
+					m_sceneGraph->m_isMesh = false;
 					if( !object->isInstanceOf( IECore::NullObjectTypeId ) )
 					{
 						m_sceneGraph->m_renderable = objectToRenderable( object.get() );
+						if( IECore::runTimeCast<const IECoreGL::MeshPrimitive>( m_sceneGraph->m_renderable.get() ) )
+						{
+							const IECore::MeshPrimitive *mesh = IECore::runTimeCast<const IECore::MeshPrimitive>( object.get() );
+							m_sceneGraph->m_isMesh = mesh && mesh->variableData<IECore::V3fVectorData>( "P", IECore::PrimitiveVariable::Vertex );
+						}
 					}
 					m_sceneGraph->m_objectHash = objectHash;
 				}
@@ -483,6 +560,14 @@ class SceneGadget::UpdateTask : public tbb::task
 
 			m_sceneGraph->m_bound = m_sceneGraph->m_renderable ? m_sceneGraph->m_renderable->bound() : Box3f();
 
+			// We can only be culled if our bound accounts for everything we draw.
+			// Attribute visualisations aren't included in the bound, and some
+			// renderables don't provide one.
+			m_sceneGraph->m_cullable =
+				!m_sceneGraph->m_attributesRenderable &&
+				( !m_sceneGraph->m_renderable || !m_sceneGraph->m_bound.isEmpty() )
+			;
+
 			// Update the expansion state
 
 			const bool previouslyExpanded = m_sceneGraph->m_expanded;
@@ -577,6 +662,10 @@ class SceneGadget::UpdateTask : public tbb::task
 			{
 				const Box3f childBound = transform( (*it)->m_bound, (*it)->m_transform );
 				m_sceneGraph->m_bound.extendBy( childBound );
+				if( (*it)->m_visible && !(*it)->m_cullable )
+				{
+					m_sceneGraph->m_cullable = false;
+				}
 			}
 
 			return NULL;
@@ -607,6 +696,835 @@ class SceneGadget::UpdateTask : public tbb::task
 
 };
 
+//////////////////////////////////////////////////////////////////////////
+// PickIndex implementation
+//
+// A bounding volume hierarchy over everything drawn by the SceneGraph,
+// used to answer objectAt() and objectsAt() queries without the cost of
+// rendering the whole scene for OpenGL selection. Solid meshes are
+// intersected exactly, using a per-mesh hierarchy of world space triangles
+// built the first time a query reaches them. Rather than hold on to the
+// meshes, we fetch them from the scene again when building the hierarchy,
+// and the hierarchies themselves are discarded when they exceed a memory
+// limit. We can't reproduce the rasterisation of other primitives, draw
+// styles and visualisations, so queries which encounter them report that
+// they are undecided, and the SceneGadget falls back to OpenGL selection.
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const size_t g_maxEntriesPerLeaf = 4;
+const size_t g_maxTrianglesPerLeaf = 8;
+const size_t g_maxTriangleIndexMemory = 256 * 1024 * 1024;
+
+// Clips a polygon (or a line segment if it has only two vertices)
+// against a convex volume defined by inward facing planes, returning
+// true if any part of it lies inside.
+bool clipToPlanes( std::vector<V3f> &polygon, const std::vector<Plane3f> &planes )
+{
+	std::vector<V3f> clipped;
+	for( std::vector<Plane3f>::const_iterator pIt = planes.begin(), peIt = planes.end(); pIt != peIt; ++pIt )
+	{
+		clipped.clear();
+		for( size_t i = 0, n = polygon.size(); i < n; ++i )
+		{
+			const V3f &a = polygon[i];
+			const V3f &b = polygon[(i+1)%n];
+			const float da = pIt->distanceTo( a );
+			const float db = pIt->distanceTo( b );
+			if( da >= 0.0f )
+			{
+				clipped.push_back( a );
+			}
+			if( ( da >= 0.0f ) != ( db >= 0.0f ) )
+			{
+				clipped.push_back( a + ( b - a ) * ( da / ( da - db ) ) );
+			}
+		}
+		polygon.swap( clipped );
+		if( polygon.empty() )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+enum BoxClassification
+{
+	Outside,
+	Inside,
+	Straddling
+};
+
+BoxClassification classify( const Box3f &box, const std::vector<Plane3f> &planes )
+{
+	BoxClassification result = Inside;
+	for( std::vector<Plane3f>::const_iterator it = planes.begin(), eIt = planes.end(); it != eIt; ++it )
+	{
+		int numInside = 0;
+		for( int i = 0; i < 8; ++i )
+		{
+			const V3f corner(
+				i & 1 ? box.max.x : box.min.x,
+				i & 2 ? box.max.y : box.min.y,
+				i & 4 ? box.max.z : box.min.z
+			);
+			numInside += it->distanceTo( corner ) >= 0.0f;
+		}
+		if( !numInside )
+		{
+			return Outside;
+		}
+		else if( numInside < 8 )
+		{
+			result = Straddling;
+		}
+	}
+	return result;
+}
+
+// Intersects a box with the segment origin + t * direction,
+// returning the parametric distance to the entry point.
+bool intersect( const Box3f &box, const V3f &origin, const V3f &inverseDirection, float &tEntry )
+{
+	float t0 = 0.0f;
+	float t1 = 1.0f;
+	for( int i = 0; i < 3; ++i )
+	{
+		float tA = ( box.min[i] - origin[i] ) * inverseDirection[i];
+		float tB = ( box.max[i] - origin[i] ) * inverseDirection[i];
+		if( tA > tB )
+		{
+			std::swap( tA, tB );
+		}
+		t0 = std::max( t0, tA );
+		t1 = std::min( t1, tB );
+		if( t0 > t1 )
+		{
+			return false;
+		}
+	}
+	tEntry = t0;
+	return true;
+}
+
+// Möller-Trumbore intersection, considering both sides of the triangle.
+bool intersect( const V3f &v0, const V3f &v1, const V3f &v2, const V3f &origin, const V3f &direction, float &t )
+{
+	const V3f e1 = v1 - v0;
+	const V3f e2 = v2 - v0;
+	const V3f p = direction % e2;
+	const float det = e1 ^ p;
+	if( fabs( det ) < 1e-12f )
+	{
+		return false;
+	}
+
+	const float inverseDet = 1.0f / det;
+	const V3f s = origin - v0;
+	const float u = ( s ^ p ) * inverseDet;
+	if( u < 0.0f || u > 1.0f )
+	{
+		return false;
+	}
+
+	const V3f q = s % e1;
+	const float v = ( direction ^ q ) * inverseDet;
+	if( v < 0.0f || u + v > 1.0f )
+	{
+		return false;
+	}
+
+	t = ( e2 ^ q ) * inverseDet;
+	return t >= 0.0f && t <= 1.0f;
+}
+
+} // namespace
+
+class SceneGadget::PickIndex
+{
+
+	public :
+
+		enum Result
+		{
+			Miss,
+			Hit,
+			// The query couldn't be answered without
+			// OpenGL selection.
+			Undecided
+		};
+
+		PickIndex( const SceneGadget *sceneGadget )
+			:	m_scene( sceneGadget->m_scene ), m_context( sceneGadget->m_context ), m_undecidable( false ), m_triangleIndexMemory( 0 )
+		{
+			// We can't tell which components of the base state are
+			// overrides, so we require the base state to be exact as
+			// well as the state inherited by each location. This errs
+			// on the side of falling back to OpenGL selection.
+			DrawStyle drawStyle;
+			drawStyle.apply( sceneGadget->m_baseState.get() );
+			m_baseDrawStyleExact = drawStyle.exact();
+
+			ScenePlug::ScenePath path;
+			addEntries( sceneGadget->m_sceneGraph.get(), M44f(), drawStyle, path );
+			if( m_entries.size() )
+			{
+				m_nodes.reserve( 2 * m_entries.size() );
+				build( m_entries, m_nodes, 0, m_entries.size(), g_maxEntriesPerLeaf );
+			}
+		}
+
+		Result objectAt( const IECore::LineSegment3f &line, ScenePlug::ScenePath &path ) const
+		{
+			if( m_undecidable )
+			{
+				return Undecided;
+			}
+
+			// Find all the entries whose bounds are hit by the line,
+			// and visit them in order of distance.
+
+			const V3f direction = line.p1 - line.p0;
+			const V3f inverseDirection( 1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z );
+
+			std::vector<std::pair<float, size_t> > candidates;
+			std::vector<size_t> stack;
+			if( m_nodes.size() )
+			{
+				stack.push_back( 0 );
+			}
+			while( stack.size() )
+			{
+				const Node &node = m_nodes[stack.back()];
+				const size_t nodeIndex = stack.back();
+				stack.pop_back();
+
+				float t;
+				if( !intersect( node.bound, line.p0, inverseDirection, t ) )
+				{
+					continue;
+				}
+
+				if( node.count )
+				{
+					for( size_t i = node.first, e = node.first + node.count; i < e; ++i )
+					{
+						if( intersect( m_entries[i].bound, line.p0, inverseDirection, t ) )
+						{
+							candidates.push_back( std::make_pair( t, i ) );
+						}
+					}
+				}
+				else
+				{
+					stack.push_back( node.right );
+					stack.push_back( nodeIndex + 1 );
+				}
+			}
+
+			std::sort( candidates.begin(), candidates.end() );
+
+			float nearest = std::numeric_limits<float>::max();
+			const Entry *hit = NULL;
+			for( std::vector<std::pair<float, size_t> >::const_iterator it = candidates.begin(), eIt = candidates.end(); it != eIt; ++it )
+			{
+				if( it->first > nearest )
+				{
+					// Nothing further away can be in front of our hit.
+					break;
+				}
+
+				const Entry &entry = m_entries[it->second];
+				if( entry.type != Entry::Mesh )
+				{
+					return Undecided;
+				}
+
+				boost::shared_ptr<const TriangleIndex> index = triangleIndex( entry );
+				if( !index )
+				{
+					return Undecided;
+				}
+
+				if( meshIntersects( *index, line, direction, inverseDirection, nearest, stack ) )
+				{
+					hit = &entry;
+				}
+			}
+
+			if( !hit )
+			{
+				return Miss;
+			}
+
+			path = hit->path;
+			return Hit;
+		}
+
+		// The frustum is specified as a set of planes with normals
+		// facing inwards.
+		Result objectsAt( const std::vector<Plane3f> &frustum, PathMatcher &paths, size_t &numAdded ) const
+		{
+			if( m_undecidable )
+			{
+				return Undecided;
+			}
+
+			std::vector<const Entry *> hits;
+			std::vector<size_t> stack;
+			std::vector<size_t> triangleStack;
+			std::vector<V3f> polygon;
+			if( m_nodes.size() )
+			{
+				stack.push_back( 0 );
+			}
+			while( stack.size() )
+			{
+				const Node &node = m_nodes[stack.back()];
+				const size_t nodeIndex = stack.back();
+				stack.pop_back();
+
+				const BoxClassification nodeClassification = classify( node.bound, frustum );
+				if( nodeClassification == Outside )
+				{
+					continue;
+				}
+
+				if( !node.count )
+				{
+					stack.push_back( node.right );
+					stack.push_back( nodeIndex + 1 );
+					continue;
+				}
+
+				for( size_t i = node.first, e = node.first + node.count; i < e; ++i )
+				{
+					const Entry &entry = m_entries[i];
+					const BoxClassification classification = nodeClassification == Inside ? Inside : classify( entry.bound, frustum );
+					if( classification == Outside )
+					{
+						continue;
+					}
+					else if( classification == Inside )
+					{
+						// Everything drawn is inside the bound, so
+						// must be inside the frustum.
+						hits.push_back( &entry );
+						continue;
+					}
+
+					switch( entry.type )
+					{
+						case Entry::Mesh :
+						{
+							boost::shared_ptr<const TriangleIndex> index = triangleIndex( entry );
+							if( !index )
+							{
+								return Undecided;
+							}
+							if( meshIntersects( *index, frustum, triangleStack, polygon ) )
+							{
+								hits.push_back( &entry );
+							}
+							break;
+						}
+						case Entry::Wireframe :
+							if( wireframeIntersects( entry, frustum, polygon ) )
+							{
+								hits.push_back( &entry );
+							}
+							break;
+						default :
+							return Undecided;
+					}
+				}
+			}
+
+			numAdded = 0;
+			for( std::vector<const Entry *>::const_iterator it = hits.begin(), eIt = hits.end(); it != eIt; ++it )
+			{
+				numAdded += paths.addPath( (*it)->path );
+			}
+
+			return hits.size() ? Hit : Miss;
+		}
+
+	private :
+
+		// Nodes are stored depth first, so that the left child of
+		// an interior node immediately follows it.
+		struct Node
+		{
+			Box3f bound;
+			size_t first;
+			// Zero for interior nodes.
+			size_t count;
+			size_t right;
+		};
+
+		struct Triangle
+		{
+			Box3f bound;
+			int vertexIds[3];
+		};
+
+		// A bounding volume hierarchy over the triangles
+		// of a mesh, in the space of the SceneGadget.
+		struct TriangleIndex
+		{
+			std::vector<V3f> positions;
+			std::vector<Triangle> triangles;
+			std::vector<Node> nodes;
+
+			size_t memoryUsage() const
+			{
+				return
+					positions.capacity() * sizeof( V3f ) +
+					triangles.capacity() * sizeof( Triangle ) +
+					nodes.capacity() * sizeof( Node )
+				;
+			}
+		};
+
+		struct Entry
+		{
+
+			enum Type
+			{
+				// Has triangles we can intersect exactly.
+				Mesh,
+				// A bounding box drawn as lines.
+				Wireframe,
+				// Anything else.
+				Other
+			};
+
+			Type type;
+			// In the space of the SceneGadget.
+			Box3f bound;
+			// In the space of the location.
+			Box3f objectBound;
+			M44f transform;
+			ScenePlug::ScenePath path;
+			// For Mesh entries, the hash of the object
+			// that was drawn.
+			IECore::MurmurHash objectHash;
+			// Built on demand by triangleIndex(), because
+			// queries typically visit only a few meshes.
+			mutable boost::shared_ptr<const TriangleIndex> triangleIndex;
+
+		};
+
+		// The components of the OpenGL state which determine
+		// whether or not a mesh draws anything outside of
+		// its triangles.
+		struct DrawStyle
+		{
+
+			DrawStyle()
+				:	solid( true ), points( false ), bound( false ), outline( false )
+			{
+			}
+
+			void apply( const IECoreGL::State *state )
+			{
+				if( const IECoreGL::Primitive::DrawSolid *c = state->get<IECoreGL::Primitive::DrawSolid>() )
+				{
+					solid = c->value();
+				}
+				if( const IECoreGL::Primitive::DrawPoints *c = state->get<IECoreGL::Primitive::DrawPoints>() )
+				{
+					points = c->value();
+				}
+				if( const IECoreGL::Primitive::DrawBound *c = state->get<IECoreGL::Primitive::DrawBound>() )
+				{
+					bound = c->value();
+				}
+				if( const IECoreGL::Primitive::DrawOutline *c = state->get<IECoreGL::Primitive::DrawOutline>() )
+				{
+					outline = c->value();
+				}
+			}
+
+			// True if a mesh is drawn exactly as its triangles. The
+			// wireframe is ignored because it lies on the triangles.
+			bool exact() const
+			{
+				return solid && !points && !bound && !outline;
+			}
+
+			bool solid;
+			bool points;
+			bool bound;
+			bool outline;
+
+		};
+
+		template<typename T>
+		struct CentroidLess
+		{
+
+			CentroidLess( int axis )
+				:	m_axis( axis )
+			{
+			}
+
+			bool operator()( const T &a, const T &b ) const
+			{
+				return a.bound.center()[m_axis] < b.bound.center()[m_axis];
+			}
+
+			int m_axis;
+
+		};
+
+		void addEntries( const SceneGraph *sceneGraph, const M44f &parentTransform, const DrawStyle &parentDrawStyle, ScenePlug::ScenePath &path )
+		{
+			// This mirrors SceneGraph::render().
+
+			if( !sceneGraph->m_visible || !sceneGraph->valid() )
+			{
+				return;
+			}
+
+			const M44f transform = sceneGraph->m_transform * parentTransform;
+			DrawStyle drawStyle = parentDrawStyle;
+			drawStyle.apply( sceneGraph->m_state.get() );
+
+			if( sceneGraph->m_renderable )
+			{
+				// If the mesh isn't drawn solid, or has points or bounds drawn
+				// as well, we can't intersect it exactly, and must leave it to
+				// OpenGL selection.
+				const bool exact = sceneGraph->m_isMesh && m_baseDrawStyleExact && drawStyle.exact();
+				addEntry( exact ? Entry::Mesh : Entry::Other, sceneGraph->m_renderable->bound(), transform, sceneGraph->m_objectHash, path );
+			}
+
+			if( sceneGraph->m_attributesRenderable )
+			{
+				addEntry( Entry::Other, sceneGraph->m_attributesRenderable->bound(), transform, IECore::MurmurHash(), path );
+			}
+
+			if( sceneGraph->m_boundRenderable )
+			{
+				addEntry( Entry::Wireframe, sceneGraph->m_bound, transform, IECore::MurmurHash(), path );
+			}
+
+			path.push_back( IECore::InternedString() ); // space for the child name
+			for( std::vector<SceneGraph *>::const_iterator it = sceneGraph->m_children.begin(), eIt = sceneGraph->m_children.end(); it != eIt; ++it )
+			{
+				path.back() = (*it)->m_name;
+				addEntries( *it, transform, drawStyle, path );
+			}
+			path.pop_back();
+		}
+
+		void addEntry( Entry::Type type, const Box3f &bound, const M44f &transform, const IECore::MurmurHash &objectHash, const ScenePlug::ScenePath &path )
+		{
+			if( bound.isEmpty() || bound.isInfinite() )
+			{
+				if( type == Entry::Other )
+				{
+					// We have no idea where this will be drawn.
+					m_undecidable = true;
+				}
+				return;
+			}
+
+			m_entries.push_back( Entry() );
+			Entry &entry = m_entries.back();
+			entry.type = type;
+			entry.bound = Imath::transform( bound, transform );
+			entry.objectBound = bound;
+			entry.transform = transform;
+			entry.path = path;
+			entry.objectHash = objectHash;
+		}
+
+		// Builds the node for the items in the range [begin, end),
+		// partitioning them at the median centroid on the longest axis.
+		template<typename T>
+		static void build( std::vector<T> &items, std::vector<Node> &nodes, size_t begin, size_t end, size_t maxItemsPerLeaf )
+		{
+			const size_t nodeIndex = nodes.size();
+			nodes.push_back( Node() );
+
+			Box3f bound, centroidBound;
+			for( size_t i = begin; i < end; ++i )
+			{
+				bound.extendBy( items[i].bound );
+				centroidBound.extendBy( items[i].bound.center() );
+			}
+			nodes[nodeIndex].bound = bound;
+			nodes[nodeIndex].first = begin;
+
+			if( end - begin <= maxItemsPerLeaf )
+			{
+				nodes[nodeIndex].count = end - begin;
+				return;
+			}
+
+			const size_t middle = ( begin + end ) / 2;
+			std::nth_element(
+				items.begin() + begin, items.begin() + middle, items.begin() + end,
+				CentroidLess<T>( centroidBound.majorAxis() )
+			);
+
+			nodes[nodeIndex].count = 0;
+			build( items, nodes, begin, middle, maxItemsPerLeaf );
+			nodes[nodeIndex].right = nodes.size();
+			build( items, nodes, middle, end, maxItemsPerLeaf );
+		}
+
+		// Picking only happens on the UI thread, so we don't
+		// need to guard against concurrent construction. Returns
+		// null if the mesh can no longer be retrieved from the scene.
+		boost::shared_ptr<const TriangleIndex> triangleIndex( const Entry &entry ) const
+		{
+			if( entry.triangleIndex )
+			{
+				return entry.triangleIndex;
+			}
+
+			// We don't keep the meshes ourselves, because that would
+			// double the memory used by the viewer on heavy scenes. The
+			// compute cache usually makes fetching them again cheap.
+			IECore::ConstMeshPrimitivePtr mesh;
+			{
+				ContextPtr context = new Context( *m_context, Context::Borrowed );
+				context->set( ScenePlug::scenePathContextName, entry.path );
+				Context::Scope scopedContext( context.get() );
+				if( !m_scene || m_scene->objectPlug()->hash() != entry.objectHash )
+				{
+					// The scene has changed since it was drawn.
+					return boost::shared_ptr<const TriangleIndex>();
+				}
+				mesh = IECore::runTimeCast<const IECore::MeshPrimitive>( m_scene->objectPlug()->getValue( &entry.objectHash ) );
+			}
+
+			const IECore::V3fVectorData *pData = mesh ? mesh->variableData<IECore::V3fVectorData>( "P", IECore::PrimitiveVariable::Vertex ) : NULL;
+			if( !pData )
+			{
+				return boost::shared_ptr<const TriangleIndex>();
+			}
+
+			boost::shared_ptr<TriangleIndex> index( new TriangleIndex );
+
+			const std::vector<V3f> &p = pData->readable();
+			index->positions.resize( p.size() );
+			for( size_t i = 0, e = p.size(); i < e; ++i )
+			{
+				index->positions[i] = p[i] * entry.transform;
+			}
+
+			const std::vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+			const std::vector<int> &vertexIds = mesh->vertexIds()->readable();
+			index->triangles.reserve( vertexIds.size() );
+
+			size_t faceStart = 0;
+			for( std::vector<int>::const_iterator it = verticesPerFace.begin(), eIt = verticesPerFace.end(); it != eIt; ++it )
+			{
+				for( int i = 1; i < *it - 1; ++i )
+				{
+					Triangle triangle;
+					triangle.vertexIds[0] = vertexIds[faceStart];
+					triangle.vertexIds[1] = vertexIds[faceStart+i];
+					triangle.vertexIds[2] = vertexIds[faceStart+i+1];
+					for( int j = 0; j < 3; ++j )
+					{
+						triangle.bound.extendBy( index->positions[triangle.vertexIds[j]] );
+					}
+					index->triangles.push_back( triangle );
+				}
+				faceStart += *it;
+			}
+
+			if( index->triangles.size() )
+			{
+				index->nodes.reserve( 2 * index->triangles.size() );
+				build( index->triangles, index->nodes, 0, index->triangles.size(), g_maxTrianglesPerLeaf );
+			}
+
+			// Keep the indices we've built within our memory limit,
+			// discarding the existing ones if necessary. They'll be
+			// rebuilt if a later query needs them.
+			const size_t memory = index->memoryUsage();
+			if( m_triangleIndexMemory + memory > g_maxTriangleIndexMemory )
+			{
+				for( std::vector<const Entry *>::const_iterator it = m_indexedEntries.begin(), eIt = m_indexedEntries.end(); it != eIt; ++it )
+				{
+					(*it)->triangleIndex.reset();
+				}
+				m_indexedEntries.clear();
+				m_triangleIndexMemory = 0;
+			}
+
+			if( memory <= g_maxTriangleIndexMemory )
+			{
+				entry.triangleIndex = index;
+				m_indexedEntries.push_back( &entry );
+				m_triangleIndexMemory += memory;
+			}
+
+			return index;
+		}
+
+		// Returns true if the line hits a triangle closer than `nearest`,
+		// updating `nearest` to the distance to the hit.
+		static bool meshIntersects( const TriangleIndex &index, const IECore::LineSegment3f &line, const V3f &direction, const V3f &inverseDirection, float &nearest, std::vector<size_t> &stack )
+		{
+			bool result = false;
+			stack.clear();
+			if( index.nodes.size() )
+			{
+				stack.push_back( 0 );
+			}
+			while( stack.size() )
+			{
+				const Node &node = index.nodes[stack.back()];
+				const size_t nodeIndex = stack.back();
+				stack.pop_back();
+
+				float t;
+				if( !intersect( node.bound, line.p0, inverseDirection, t ) || t > nearest )
+				{
+					continue;
+				}
+
+				if( !node.count )
+				{
+					stack.push_back( node.right );
+					stack.push_back( nodeIndex + 1 );
+					continue;
+				}
+
+				for( size_t i = node.first, e = node.first + node.count; i < e; ++i )
+				{
+					const Triangle &triangle = index.triangles[i];
+					if(
+						intersect(
+							index.positions[triangle.vertexIds[0]],
+							index.positions[triangle.vertexIds[1]],
+							index.positions[triangle.vertexIds[2]],
+							line.p0, direction, t
+						) &&
+						t < nearest
+					)
+					{
+						nearest = t;
+						result = true;
+					}
+				}
+			}
+
+			return result;
+		}
+
+		static bool meshIntersects( const TriangleIndex &index, const std::vector<Plane3f> &frustum, std::vector<size_t> &stack, std::vector<V3f> &polygon )
+		{
+			stack.clear();
+			if( index.nodes.size() )
+			{
+				stack.push_back( 0 );
+			}
+			while( stack.size() )
+			{
+				const Node &node = index.nodes[stack.back()];
+				const size_t nodeIndex = stack.back();
+				stack.pop_back();
+
+				const BoxClassification classification = classify( node.bound, frustum );
+				if( classification == Outside )
+				{
+					continue;
+				}
+				else if( classification == Inside )
+				{
+					// Nodes are never empty, so at least one
+					// triangle must be inside the frustum.
+					return true;
+				}
+
+				if( !node.count )
+				{
+					stack.push_back( node.right );
+					stack.push_back( nodeIndex + 1 );
+					continue;
+				}
+
+				for( size_t i = node.first, e = node.first + node.count; i < e; ++i )
+				{
+					const Triangle &triangle = index.triangles[i];
+					polygon.clear();
+					for( int j = 0; j < 3; ++j )
+					{
+						polygon.push_back( index.positions[triangle.vertexIds[j]] );
+					}
+					if( clipToPlanes( polygon, frustum ) )
+					{
+						return true;
+					}
+				}
+			}
+
+			return false;
+		}
+
+		static bool wireframeIntersects( const Entry &entry, const std::vector<Plane3f> &frustum, std::vector<V3f> &polygon )
+		{
+			for( int i = 0; i < 8; ++i )
+			{
+				for( int axis = 0; axis < 3; ++axis )
+				{
+					const int j = i | ( 1 << axis );
+					if( j == i )
+					{
+						continue;
+					}
+					polygon.clear();
+					polygon.push_back( corner( entry.objectBound, i ) * entry.transform );
+					polygon.push_back( corner( entry.objectBound, j ) * entry.transform );
+					if( clipToPlanes( polygon, frustum ) )
+					{
+						return true;
+					}
+				}
+			}
+			return false;
+		}
+
+		static V3f corner( const Box3f &box, int i )
+		{
+			return V3f(
+				i & 1 ? box.max.x : box.min.x,
+				i & 2 ? box.max.y : box.min.y,
+				i & 4 ? box.max.z : box.min.z
+			);
+		}
+
+		// Used to fetch meshes for triangleIndex().
+		GafferScene::ConstScenePlugPtr m_scene;
+		Gaffer::ConstContextPtr m_context;
+
+		std::vector<Entry> m_entries;
+		std::vector<Node> m_nodes;
+		// True if something is drawn that we can't
+		// account for, in which case we can't answer any
+		// queries.
+		bool m_undecidable;
+		// True if the base state draws meshes exactly
+		// as their triangles.
+		bool m_baseDrawStyleExact;
+		// The entries which currently hold a triangleIndex,
+		// and the memory used by those indices.
+		mutable std::vector<const Entry *> m_indexedEntries;
+		mutable size_t m_triangleIndexMemory;
+
+};
+
 //////////////////////////////////////////////////////////////////////////
 // SceneGadget implementation
 //////////////////////////////////////////////////////////////////////////
@@ -618,6 +1536,7 @@ SceneGadget::SceneGadget()
 		m_dirtyFlags( UpdateTask::AllDirty ),
 		m_expandedPaths( new PathMatcherData ),
 		m_minimumExpansionDepth( 0 ),
+		m_minimumScreenSize( 1.0f ),
 		m_baseState( new IECoreGL::State( true ) ),
 		m_sceneGraph( new SceneGraph ),
 		m_selection( new PathMatcherData )
@@ -709,8 +1628,26 @@ size_t SceneGadget::getMinimumExpansionDepth() const
 	return m_minimumExpansionDepth;
 }
 
+void SceneGadget::setMinimumScreenSize( float pixels )
+{
+	if( pixels == m_minimumScreenSize )
+	{
+		return;
+	}
+	m_minimumScreenSize = pixels;
+	requestRender();
+}
+
+float SceneGadget::getMinimumScreenSize() const
+{
+	return m_minimumScreenSize;
+}
+
 IECoreGL::State *SceneGadget::baseState()
 {
+	// The caller may change the draw style, which
+	// the pick index depends on.
+	m_pickIndex.reset();
 	return m_baseState.get();
 }
 
@@ -718,6 +1655,17 @@ bool SceneGadget::objectAt( const IECore::LineSegment3f &lineInGadgetSpace, Gaff
 {
 	updateSceneGraph();
 
+	switch( pickIndex()->objectAt( lineInGadgetSpace, path ) )
+	{
+		case PickIndex::Hit :
+			return true;
+		case PickIndex::Miss :
+			return false;
+		default :
+			// Fall back to OpenGL selection.
+			break;
+	}
+
 	std::vector<IECoreGL::HitRecord> selection;
 	{
 		ViewportGadget::SelectionScope selectionScope( lineInGadgetSpace, this, selection, IECoreGL::Selector::IDRender );
@@ -740,6 +1688,16 @@ size_t SceneGadget::objectsAt(
 {
 	updateSceneGraph();
 
+	std::vector<Plane3f> frustum;
+	if( selectionFrustum( corner0InGadgetSpace, corner1InGadgetSpace, frustum ) )
+	{
+		size_t numAdded = 0;
+		if( pickIndex()->objectsAt( frustum, paths, numAdded ) != PickIndex::Undecided )
+		{
+			return numAdded;
+		}
+	}
+
 	std::vector<IECoreGL::HitRecord> selection;
 	{
 		ViewportGadget::SelectionScope selectionScope( corner0InGadgetSpace, corner1InGadgetSpace, this, selection, IECoreGL::Selector::OcclusionQuery );
@@ -882,6 +1840,10 @@ void SceneGadget::updateSceneGraph() const
 		IECore::msg( IECore::Msg::Error, "SceneGadget::updateSceneGraph", e.what() );
 	}
 
+	// The pick index refers to the previous state of the scene
+	// graph, so must be rebuilt on demand.
+	m_pickIndex.reset();
+
 	// Even if an error occurred when updating the scene, we clear
 	// the dirty flags. This prevents us from repeating the same
 	// error over and over when nothing has been done to prevent it.
@@ -901,7 +1863,24 @@ void SceneGadget::renderSceneGraph( const IECoreGL::State *stateToBind ) const
 	{
 		IECoreGL::State::bindBaseState();
 		stateToBind->bind();
-		m_sceneGraph->render( const_cast<IECoreGL::State *>( stateToBind ), IECoreGL::Selector::currentSelector() );
+		if( IECoreGL::Selector *selector = IECoreGL::Selector::currentSelector() )
+		{
+			// We don't cull when selecting, because culled locations
+			// wouldn't be assigned the selection ids that
+			// pathFromSelectionId() relies on.
+			m_sceneGraph->render( const_cast<IECoreGL::State *>( stateToBind ), selector );
+		}
+		else
+		{
+			M44f modelView, projection;
+			glGetFloatv( GL_MODELVIEW_MATRIX, modelView.getValue() );
+			glGetFloatv( GL_PROJECTION_MATRIX, projection.getValue() );
+			GLint viewport[4];
+			glGetIntegerv( GL_VIEWPORT, viewport );
+
+			const FrustumCuller culler( V2i( viewport[2], viewport[3] ), m_minimumScreenSize );
+			m_sceneGraph->render( const_cast<IECoreGL::State *>( stateToBind ), NULL, &culler, modelView * projection );
+		}
 	}
 	catch( const std::exception& e )
 	{
@@ -911,3 +1890,64 @@ void SceneGadget::renderSceneGraph( const IECoreGL::State *stateToBind ) const
 	glPopAttrib();
 	glUseProgram( prevProgram );
 }
+
+const SceneGadget::PickIndex *SceneGadget::pickIndex() const
+{
+	if( !m_pickIndex )
+	{
+		m_pickIndex.reset( new PickIndex( this ) );
+	}
+	return m_pickIndex.get();
+}
+
+bool SceneGadget::selectionFrustum( const Imath::V3f &corner0InGadgetSpace, const Imath::V3f &corner1InGadgetSpace, std::vector<Imath::Plane3f> &frustum ) const
+{
+	const ViewportGadget *viewportGadget = ancestor<ViewportGadget>();
+	if( !viewportGadget )
+	{
+		return false;
+	}
+
+	Box2f rasterBox;
+	rasterBox.extendBy( viewportGadget->gadgetToRasterSpace( corner0InGadgetSpace, this ) );
+	rasterBox.extendBy( viewportGadget->gadgetToRasterSpace( corner1InGadgetSpace, this ) );
+	if( rasterBox.size().x <= 0.0f || rasterBox.size().y <= 0.0f )
+	{
+		return false;
+	}
+
+	const V2f rasterCorners[4] = {
+		rasterBox.min,
+		V2f( rasterBox.max.x, rasterBox.min.y ),
+		rasterBox.max,
+		V2f( rasterBox.min.x, rasterBox.max.y )
+	};
+
+	IECore::LineSegment3f lines[4];
+	V3f center( 0 );
+	for( int i = 0; i < 4; ++i )
+	{
+		lines[i] = viewportGadget->rasterToGadgetSpace( rasterCorners[i], this );
+		center += ( lines[i].p0 + lines[i].p1 ) / 8.0f;
+	}
+
+	frustum.clear();
+	frustum.push_back( Plane3f( lines[0].p0, lines[1].p0, lines[2].p0 ) );
+	frustum.push_back( Plane3f( lines[0].p1, lines[1].p1, lines[2].p1 ) );
+	for( int i = 0; i < 4; ++i )
+	{
+		const IECore::LineSegment3f &next = lines[(i+1)%4];
+		frustum.push_back( Plane3f( lines[i].p0, lines[i].p1, next.p0 ) );
+	}
+
+	// Orient the planes to face inwards.
+	for( std::vector<Plane3f>::iterator it = frustum.begin(), eIt = frustum.end(); it != eIt; ++it )
+	{
+		if( it->distanceTo( center ) < 0.0f )
+		{
+			*it = Plane3f( -it->normal, -it->distance );
+		}
+	}
+
+	return true;
+}
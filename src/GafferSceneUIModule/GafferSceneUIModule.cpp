@@ -41,6 +41,7 @@
 #include "GafferUIBindings/GadgetBinding.h"
 
 #include "GafferSceneUI/SceneGadget.h"
+#include "GafferSceneUI/FrustumCuller.h"
 #include "GafferSceneUI/SelectionTool.h"
 #include "GafferSceneUI/CropWindowTool.h"
 
@@ -87,6 +88,8 @@ BOOST_PYTHON_MODULE( _GafferSceneUI )
 		.def( "getExpandedPaths", &SceneGadget::getExpandedPaths, return_value_policy<CastToIntrusivePtr>() )
 		.def( "setMinimumExpansionDepth", &SceneGadget::setMinimumExpansionDepth )
 		.def( "getMinimumExpansionDepth", &SceneGadget::getMinimumExpansionDepth )
+		.def( "setMinimumScreenSize", &SceneGadget::setMinimumScreenSize )
+		.def( "getMinimumScreenSize", &SceneGadget::getMinimumScreenSize )
 		.def( "baseState", &SceneGadget::baseState, return_value_policy<CastToIntrusivePtr>() )
 		.def( "objectAt", &objectAt )
 		.def( "objectsAt", &SceneGadget::objectsAt )
@@ -95,6 +98,19 @@ BOOST_PYTHON_MODULE( _GafferSceneUI )
 		.def( "selectionBound", &SceneGadget::selectionBound )
 	;
 
+	{
+		scope s = class_<FrustumCuller>( "FrustumCuller", init<const Imath::V2i &, float>() )
+			.def( "visibility", &FrustumCuller::visibility, ( arg( "bound" ), arg( "objectToClip" ), arg( "parentContained" ) = false ) )
+		;
+
+		enum_<FrustumCuller::Visibility>( "Visibility" )
+			.value( "Culled", FrustumCuller::Culled )
+			.value( "StandIn", FrustumCuller::StandIn )
+			.value( "Intersecting", FrustumCuller::Intersecting )
+			.value( "Contained", FrustumCuller::Contained )
+		;
+	}
+
 	GafferBindings::NodeClass<SelectionTool>( NULL, no_init );
 	GafferBindings::NodeClass<CropWindowTool>( NULL, no_init );
 
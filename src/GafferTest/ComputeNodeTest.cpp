@@ -39,6 +39,8 @@
 
 #include "IECore/Timer.h"
 
+#include "Gaffer/Context.h"
+
 #include "GafferTest/Assert.h"
 #include "GafferTest/MultiplyNode.h"
 #include "GafferTest/ComputeNodeTest.h"
@@ -103,6 +105,53 @@ struct Compute
 
 };
 
+// A MultiplyNode which counts calls to hash(), and
+// optionally declares that "testVar" is irrelevant.
+class CountingNode : public GafferTest::MultiplyNode
+{
+
+	public :
+
+		CountingNode( bool ignoreTestVar )
+			:	hashCount( 0 ), sawTestVar( false ), m_ignoreTestVar( ignoreTestVar )
+		{
+		}
+
+		virtual const std::vector<IECore::InternedString> *ignoredContextVariables( const ValuePlug *output ) const
+		{
+			if( m_ignoreTestVar && output == productPlug() )
+			{
+				static const std::vector<IECore::InternedString> g_ignored( 1, IECore::InternedString( "testVar" ) );
+				return &g_ignored;
+			}
+			return MultiplyNode::ignoredContextVariables( output );
+		}
+
+		mutable int hashCount;
+		mutable bool sawTestVar;
+
+	protected :
+
+		virtual void hash( const ValuePlug *output, const Context *context, IECore::MurmurHash &h ) const
+		{
+			MultiplyNode::hash( output, context, h );
+			if( output == productPlug() )
+			{
+				hashCount++;
+				const int testVar = context->get<int>( "testVar", -1 );
+				sawTestVar = sawTestVar || testVar != -1;
+				h.append( testVar );
+			}
+		}
+
+	private :
+
+		bool m_ignoreTestVar;
+
+};
+
+IE_CORE_DECLAREPTR( CountingNode )
+
 } // namespace
 
 void GafferTest::testComputeNodeThreading()
@@ -127,3 +176,59 @@ void GafferTest::testComputeNodeThreading()
 	//std::cerr << t.stop() << std::endl;
 	stop = true;
 }
+
+void GafferTest::testComputeNodeIgnoredContextVariables()
+{
+	CountingNodePtr upstream = new CountingNode( false );
+	upstream->op1Plug()->setValue( 2 );
+	upstream->op2Plug()->setValue( 3 );
+
+	CountingNodePtr downstream = new CountingNode( true );
+	downstream->op1Plug()->setInput( upstream->productPlug() );
+	downstream->op2Plug()->setValue( 4 );
+
+	// Evaluations in contexts differing only by the ignored
+	// variable should share hashes, and the variable should
+	// be invisible both to the node and to everything upstream.
+
+	ContextPtr context = new Context();
+	IECore::MurmurHash firstHash;
+	for( int i = 0; i < 10; ++i )
+	{
+		context->set( "testVar", i );
+		Context::Scope scope( context.get() );
+		const IECore::MurmurHash h = downstream->productPlug()->hash();
+		if( i == 0 )
+		{
+			firstHash = h;
+		}
+		GAFFERTEST_ASSERT( h == firstHash );
+		GAFFERTEST_ASSERT( downstream->productPlug()->getValue() == 24 );
+	}
+
+	GAFFERTEST_ASSERT( !downstream->sawTestVar );
+	GAFFERTEST_ASSERT( !upstream->sawTestVar );
+	// Allow for the hash cache being cleared periodically
+	// in the middle of our evaluations.
+	GAFFERTEST_ASSERT( downstream->hashCount <= 2 );
+	GAFFERTEST_ASSERT( upstream->hashCount <= 2 );
+
+	// Other variables must still be taken into account,
+	// and the upstream node must still see the variable
+	// when evaluated directly.
+
+	const int downstreamHashCount = downstream->hashCount;
+	for( int i = 0; i < 10; ++i )
+	{
+		context->set( "otherVar", i );
+		Context::Scope scope( context.get() );
+		downstream->productPlug()->hash();
+	}
+	GAFFERTEST_ASSERT( downstream->hashCount >= downstreamHashCount + 9 );
+
+	{
+		Context::Scope scope( context.get() );
+		upstream->productPlug()->hash();
+	}
+	GAFFERTEST_ASSERT( upstream->sawTestVar );
+}
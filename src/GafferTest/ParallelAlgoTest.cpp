@@ -0,0 +1,147 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "tbb/parallel_for.h"
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/atomic.h"
+
+#include "IECore/Timer.h"
+
+#include "Gaffer/ParallelAlgo.h"
+
+#include "GafferTest/Assert.h"
+#include "GafferTest/ParallelAlgoTest.h"
+
+using namespace tbb;
+using namespace Gaffer;
+
+namespace
+{
+
+struct InnerBody
+{
+
+	void operator()( const blocked_range<size_t> &r ) const
+	{
+		volatile double x = 0;
+		for( size_t i = r.begin(); i != r.end(); ++i )
+		{
+			for( int j = 0; j < 1000; ++j )
+			{
+				x += j;
+			}
+		}
+	}
+
+};
+
+struct OuterBody
+{
+
+	OuterBody( enumerable_thread_specific<int> &depth, tbb::atomic<int> &reentries )
+		:	m_depth( depth ), m_reentries( reentries )
+	{
+	}
+
+	void operator()( const blocked_range<size_t> &r ) const
+	{
+		int &depth = m_depth.local();
+		for( size_t i = r.begin(); i != r.end(); ++i )
+		{
+			// If we're already inside an outer task on this thread,
+			// then it must have been stolen while we were waiting
+			// for nested work - exactly what isolation should prevent.
+			if( depth )
+			{
+				++m_reentries;
+			}
+			++depth;
+			isolatedParallelFor( blocked_range<size_t>( 0, 100, 1 ), InnerBody() );
+			--depth;
+		}
+	}
+
+	enumerable_thread_specific<int> &m_depth;
+	tbb::atomic<int> &m_reentries;
+
+};
+
+template<typename ParallelFor>
+void runSmallLoops( ParallelFor parallelFor )
+{
+	for( int i = 0; i < 10000; ++i )
+	{
+		parallelFor( blocked_range<size_t>( 0, 10, 1 ), InnerBody() );
+	}
+}
+
+void plainParallelFor( const blocked_range<size_t> &range, const InnerBody &body )
+{
+	parallel_for( range, body );
+}
+
+} // namespace
+
+void GafferTest::testParallelAlgoIsolation()
+{
+	enumerable_thread_specific<int> depth( 0 );
+	tbb::atomic<int> reentries;
+	reentries = 0;
+
+	parallel_for( blocked_range<size_t>( 0, 1000, 1 ), OuterBody( depth, reentries ) );
+
+	GAFFERTEST_ASSERT( reentries == 0 );
+}
+
+void GafferTest::testParallelAlgoIsolationOverhead()
+{
+	// Isolation is used on hot paths, launching many small loops,
+	// so its overhead must stay small relative to the work itself.
+	// With older TBB versions this is a useful benchmark for the
+	// reuse of arenas, rather than creating a new one per call.
+
+	runSmallLoops( plainParallelFor ); // Warm up the scheduler.
+
+	IECore::Timer plainTimer;
+	runSmallLoops( plainParallelFor );
+	// Uncomment for timing information.
+	//std::cerr << "Plain : " << plainTimer.stop() << std::endl;
+
+	IECore::Timer isolatedTimer;
+	runSmallLoops( isolatedParallelFor<blocked_range<size_t>, InnerBody> );
+	// Uncomment for timing information.
+	//std::cerr << "Isolated : " << isolatedTimer.stop() << std::endl;
+}
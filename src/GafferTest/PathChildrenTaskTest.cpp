@@ -0,0 +1,303 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/lexical_cast.hpp"
+#include "boost/make_shared.hpp"
+#include "boost/thread.hpp"
+
+#include "IECore/SimpleTypedData.h"
+
+#include "Gaffer/PathChildrenTask.h"
+
+#include "GafferTest/Assert.h"
+#include "GafferTest/PathChildrenTaskTest.h"
+
+using namespace std;
+using namespace boost;
+using namespace IECore;
+using namespace Gaffer;
+
+namespace
+{
+
+InternedString g_indexPropertyName( "test:index" );
+
+// Used to hold up property evaluation on the
+// background thread until the test is ready.
+class Gate
+{
+
+	public :
+
+		Gate()
+			:	m_open( false )
+		{
+		}
+
+		void wait()
+		{
+			boost::unique_lock<boost::mutex> lock( m_mutex );
+			while( !m_open )
+			{
+				m_condition.wait( lock );
+			}
+		}
+
+		void open()
+		{
+			boost::lock_guard<boost::mutex> lock( m_mutex );
+			m_open = true;
+			m_condition.notify_all();
+		}
+
+	private :
+
+		boost::mutex m_mutex;
+		boost::condition_variable m_condition;
+		bool m_open;
+
+};
+
+typedef boost::shared_ptr<Gate> GatePtr;
+
+// A path with `numChildren` leaf children named by their
+// index. A negative `numChildren` causes children() to throw.
+class TestPath : public Path
+{
+
+	public :
+
+		TestPath( const Names &names, int numChildren, GatePtr gate = GatePtr() )
+			:	Path( names ), m_numChildren( numChildren ), m_gate( gate )
+		{
+		}
+
+		virtual bool isLeaf() const
+		{
+			return names().size();
+		}
+
+		virtual void propertyNames( std::vector<IECore::InternedString> &names ) const
+		{
+			Path::propertyNames( names );
+			names.push_back( g_indexPropertyName );
+		}
+
+		virtual IECore::ConstRunTimeTypedPtr property( const IECore::InternedString &name ) const
+		{
+			if( name == g_indexPropertyName && names().size() )
+			{
+				if( m_gate )
+				{
+					m_gate->wait();
+				}
+				return new IntData( lexical_cast<int>( names().back().string() ) );
+			}
+			return Path::property( name );
+		}
+
+		virtual PathPtr copy() const
+		{
+			return new TestPath( names(), m_numChildren, m_gate );
+		}
+
+	protected :
+
+		virtual void doChildren( std::vector<PathPtr> &children ) const
+		{
+			if( m_numChildren < 0 )
+			{
+				throw IECore::Exception( "Oops" );
+			}
+
+			if( isLeaf() )
+			{
+				return;
+			}
+
+			for( int i = 0; i < m_numChildren; ++i )
+			{
+				Names childNames( names() );
+				childNames.push_back( lexical_cast<string>( i ) );
+				children.push_back( new TestPath( childNames, 0, m_gate ) );
+			}
+		}
+
+	private :
+
+		int m_numChildren;
+		GatePtr m_gate;
+
+};
+
+} // namespace
+
+void GafferTest::testPathChildrenTaskOrdering()
+{
+	const int numChildren = 1050;
+	PathPtr path = new TestPath( Path::Names(), numChildren );
+
+	PathChildrenTask::PropertyNames propertyNames;
+	propertyNames.push_back( g_indexPropertyName );
+	PathChildrenTaskPtr task = new PathChildrenTask( path.get(), propertyNames, 100 );
+
+	// The task works on a copy, so we should be
+	// free to modify the original.
+	path->setFromString( "/modified" );
+
+	PathChildrenTask::Children children;
+	PathChildrenTask::Status status = PathChildrenTask::Running;
+	while( status == PathChildrenTask::Running )
+	{
+		const size_t previousSize = children.size();
+		status = task->takeChildren( children );
+		// Children must always arrive in whole chunks,
+		// apart from the final partial one.
+		GAFFERTEST_ASSERT( ( children.size() - previousSize ) % 100 == 0 || children.size() == (size_t)numChildren );
+		boost::this_thread::yield();
+	}
+
+	GAFFERTEST_ASSERT( status == PathChildrenTask::Completed );
+	GAFFERTEST_ASSERT( task->wait() == PathChildrenTask::Completed );
+	GAFFERTEST_ASSERT( children.size() == (size_t)numChildren );
+
+	for( int i = 0; i < numChildren; ++i )
+	{
+		const PathChildrenTask::Child &child = children[i];
+		GAFFERTEST_ASSERT( child.path->string() == "/" + lexical_cast<string>( i ) );
+		GAFFERTEST_ASSERT( child.properties.size() == 1 );
+		const IntData *index = runTimeCast<const IntData>( child.properties[0].get() );
+		GAFFERTEST_ASSERT( index && index->readable() == i );
+	}
+
+	// Nothing more should be delivered once complete.
+	PathChildrenTask::Children more;
+	GAFFERTEST_ASSERT( task->takeChildren( more ) == PathChildrenTask::Completed );
+	GAFFERTEST_ASSERT( more.empty() );
+}
+
+void GafferTest::testPathChildrenTaskCancellation()
+{
+	PathChildrenTask::PropertyNames propertyNames;
+	propertyNames.push_back( g_indexPropertyName );
+
+	// Cancel while property evaluation is held up by the
+	// gate. No children should be delivered, even after
+	// the gate is opened.
+
+	GatePtr gate = boost::make_shared<Gate>();
+	PathPtr path = new TestPath( Path::Names(), 1000, gate );
+	PathChildrenTaskPtr task = new PathChildrenTask( path.get(), propertyNames, 10 );
+
+	PathChildrenTask::Children children;
+	GAFFERTEST_ASSERT( task->takeChildren( children ) == PathChildrenTask::Running );
+	GAFFERTEST_ASSERT( children.empty() );
+
+	task->cancel();
+	GAFFERTEST_ASSERT( task->status() == PathChildrenTask::Cancelled );
+	GAFFERTEST_ASSERT( task->wait() == PathChildrenTask::Cancelled );
+
+	gate->open();
+	boost::this_thread::sleep( boost::posix_time::milliseconds( 50 ) );
+
+	GAFFERTEST_ASSERT( task->takeChildren( children ) == PathChildrenTask::Cancelled );
+	GAFFERTEST_ASSERT( children.empty() );
+
+	// Cancelling a task before the children have been
+	// taken discards them.
+
+	gate = boost::make_shared<Gate>();
+	path = new TestPath( Path::Names(), 1000, gate );
+	task = new PathChildrenTask( path.get(), propertyNames, 10 );
+	task->cancel();
+	gate->open();
+	GAFFERTEST_ASSERT( task->takeChildren( children ) == PathChildrenTask::Cancelled );
+	GAFFERTEST_ASSERT( children.empty() );
+
+	// Cancelling a completed task has no effect.
+
+	path = new TestPath( Path::Names(), 1000 );
+	task = new PathChildrenTask( path.get(), propertyNames, 10 );
+	task->wait();
+	task->cancel();
+	GAFFERTEST_ASSERT( task->takeChildren( children ) == PathChildrenTask::Completed );
+	GAFFERTEST_ASSERT( children.size() == 1000 );
+
+	// Destroying a running task must not wait for, or
+	// interfere with, the background thread.
+
+	gate = boost::make_shared<Gate>();
+	path = new TestPath( Path::Names(), 1000, gate );
+	task = new PathChildrenTask( path.get(), propertyNames, 10 );
+	task = NULL;
+	gate->open();
+	boost::this_thread::sleep( boost::posix_time::milliseconds( 50 ) );
+}
+
+void GafferTest::testPathChildrenTaskErrors()
+{
+	PathPtr path = new TestPath( Path::Names(), -1 );
+	PathChildrenTaskPtr task = new PathChildrenTask( path.get() );
+	GAFFERTEST_ASSERT( task->wait() == PathChildrenTask::Errored );
+	GAFFERTEST_ASSERT( task->error() == "Oops" );
+
+	PathChildrenTask::Children children;
+	GAFFERTEST_ASSERT( task->takeChildren( children ) == PathChildrenTask::Errored );
+	GAFFERTEST_ASSERT( children.empty() );
+}
+
+void GafferTest::testPathChildrenTaskForeground()
+{
+	PathPtr path = new TestPath( Path::Names(), 250 );
+
+	PathChildrenTask::PropertyNames propertyNames;
+	propertyNames.push_back( g_indexPropertyName );
+	PathChildrenTaskPtr task = new PathChildrenTask( path.get(), propertyNames, 100, /* background = */ false );
+
+	// Everything should have been evaluated before
+	// the constructor returned.
+
+	GAFFERTEST_ASSERT( task->status() == PathChildrenTask::Completed );
+
+	PathChildrenTask::Children children;
+	GAFFERTEST_ASSERT( task->takeChildren( children ) == PathChildrenTask::Completed );
+	GAFFERTEST_ASSERT( children.size() == 250 );
+	for( int i = 0; i < 250; ++i )
+	{
+		const IntData *index = runTimeCast<const IntData>( children[i].properties[0].get() );
+		GAFFERTEST_ASSERT( index && index->readable() == i );
+	}
+}
@@ -46,6 +46,8 @@
 #include "GafferTest/ContextTest.h"
 #include "GafferTest/ComputeNodeTest.h"
 #include "GafferTest/DownstreamIteratorTest.h"
+#include "GafferTest/PathChildrenTaskTest.h"
+#include "GafferTest/ParallelAlgoTest.h"
 
 using namespace boost::python;
 using namespace GafferTest;
@@ -69,6 +71,13 @@ BOOST_PYTHON_MODULE( _GafferTest )
 	def( "testManyEnvironmentSubstitutions", &testManyEnvironmentSubstitutions );
 	def( "testScopingNullContext", &testScopingNullContext );
 	def( "testComputeNodeThreading", &testComputeNodeThreading );
+	def( "testComputeNodeIgnoredContextVariables", &testComputeNodeIgnoredContextVariables );
 	def( "testDownstreamIterator", &testDownstreamIterator );
+	def( "testPathChildrenTaskOrdering", &testPathChildrenTaskOrdering );
+	def( "testPathChildrenTaskCancellation", &testPathChildrenTaskCancellation );
+	def( "testPathChildrenTaskErrors", &testPathChildrenTaskErrors );
+	def( "testPathChildrenTaskForeground", &testPathChildrenTaskForeground );
+	def( "testParallelAlgoIsolation", &testParallelAlgoIsolation );
+	def( "testParallelAlgoIsolationOverhead", &testParallelAlgoIsolationOverhead );
 
 }
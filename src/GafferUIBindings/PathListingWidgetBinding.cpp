@@ -44,6 +44,7 @@
 #include "QtCore/QModelIndex"
 #include "QtCore/QVariant"
 #include "QtCore/QDateTime"
+#include "QtCore/QTimerEvent"
 #include "QtGui/QTreeView"
 #include "QtGui/QFileIconProvider"
 
@@ -59,6 +60,7 @@
 
 #include "Gaffer/Path.h"
 #include "Gaffer/FileSystemPath.h"
+#include "Gaffer/PathChildrenTask.h"
 
 #include "GafferUIBindings/PathListingWidgetBinding.h"
 
@@ -71,6 +73,45 @@ namespace
 
 IECore::InternedString g_namePropertyName( "name" );
 
+// Provides access to the properties of a Path, using values
+// prefetched on a background thread by a PathChildrenTask
+// where they are available, and querying the path directly
+// otherwise.
+class PropertySource
+{
+
+	public :
+
+		PropertySource( const Path *path, const PathChildrenTask::PropertyNames &names, const PathChildrenTask::Properties &values )
+			:	m_path( path ), m_names( names ), m_values( values )
+		{
+		}
+
+		const Path *path() const
+		{
+			return m_path;
+		}
+
+		IECore::ConstRunTimeTypedPtr property( const IECore::InternedString &name ) const
+		{
+			for( size_t i = 0, e = std::min( m_names.size(), m_values.size() ); i < e; ++i )
+			{
+				if( m_names[i] == name )
+				{
+					return m_values[i];
+				}
+			}
+			return m_path->property( name );
+		}
+
+	private :
+
+		const Path *m_path;
+		const PathChildrenTask::PropertyNames &m_names;
+		const PathChildrenTask::Properties &m_values;
+
+};
+
 // Abstract class for extracting QVariants from Path objects
 // in order to populate columns in the PathMode. Column
 // objects only do the extraction, they are not responsible
@@ -82,7 +123,13 @@ class Column : public IECore::RefCounted
 
 		IE_CORE_DECLAREMEMBERPTR( Column )
 
-		virtual QVariant data( const Path *path, int role = Qt::DisplayRole ) const = 0;
+		// Appends the names of any properties queried by data(),
+		// so that they may be prefetched on a background thread.
+		virtual void propertyNames( std::vector<IECore::InternedString> &names ) const
+		{
+		}
+
+		virtual QVariant data( const PropertySource &source, int role = Qt::DisplayRole ) const = 0;
 		virtual QVariant headerData( int role = Qt::DisplayRole ) const = 0;
 
 };
@@ -101,12 +148,20 @@ class StandardColumn : public Column
 		{
 		}
 
-		virtual QVariant data( const Path *path, int role = Qt::DisplayRole ) const
+		virtual void propertyNames( std::vector<IECore::InternedString> &names ) const
+		{
+			if( m_propertyName != g_namePropertyName )
+			{
+				names.push_back( m_propertyName );
+			}
+		}
+
+		virtual QVariant data( const PropertySource &source, int role = Qt::DisplayRole ) const
 		{
 			switch( role )
 			{
 				case Qt::DisplayRole :
-					return variantFromProperty( path );
+					return variantFromProperty( source );
 				default :
 					return QVariant();
 			}
@@ -123,11 +178,12 @@ class StandardColumn : public Column
 
 	private :
 
-		QVariant variantFromProperty( const Path *path ) const
+		QVariant variantFromProperty( const PropertySource &source ) const
 		{
 			// shortcut for getting the name property directly
 			if( m_propertyName == g_namePropertyName )
 			{
+				const Path *path = source.path();
 				if( path->names().size() )
 				{
 					return QVariant( path->names().back().c_str() );
@@ -138,7 +194,7 @@ class StandardColumn : public Column
 				}
 			}
 
-			IECore::ConstRunTimeTypedPtr property = path->property( m_propertyName );
+			IECore::ConstRunTimeTypedPtr property = source.property( m_propertyName );
 
 			if( !property )
 			{
@@ -197,11 +253,16 @@ class IconColumn : public Column
 		{
 		}
 
-		virtual QVariant data( const Path *path, int role = Qt::DisplayRole ) const
+		virtual void propertyNames( std::vector<IECore::InternedString> &names ) const
+		{
+			names.push_back( m_propertyName );
+		}
+
+		virtual QVariant data( const PropertySource &source, int role = Qt::DisplayRole ) const
 		{
 			if( role == Qt::DecorationRole )
 			{
-				IECore::ConstRunTimeTypedPtr property = path->property( m_propertyName );
+				IECore::ConstRunTimeTypedPtr property = source.property( m_propertyName );
 				if( !property )
 				{
 					return QVariant();
@@ -285,10 +346,11 @@ class FileIconColumn : public Column
 		{
 		}
 
-		virtual QVariant data( const Path *path, int role = Qt::DisplayRole ) const
+		virtual QVariant data( const PropertySource &source, int role = Qt::DisplayRole ) const
 		{
 			if( role == Qt::DecorationRole )
 			{
+				const Path *path = source.path();
 				std::string s = path->string();
 
 				if( const FileSystemPath *fileSystemPath = IECore::runTimeCast<const FileSystemPath>( path ) )
@@ -332,7 +394,9 @@ IE_CORE_DECLAREPTR( FileIconColumn )
 // A QAbstractItemModel for the navigation of Gaffer::Paths.
 // This allows us to view Paths in QTreeViews. This forms part
 // of the internal implementation of PathListingWidget, the rest
-// of which is implemented in Python.
+// of which is implemented in Python. Children are evaluated
+// on a background thread using PathChildrenTask, and are added
+// to the model progressively as they become available.
 class PathModel : public QAbstractItemModel
 {
 
@@ -350,7 +414,9 @@ class PathModel : public QAbstractItemModel
 				m_rootItem( new Item( NULL, 0, NULL ) ),
 				m_flat( true ),
 				m_sortColumn( -1 ),
-				m_sortOrder( Qt::AscendingOrder )
+				m_sortOrder( Qt::AscendingOrder ),
+				m_background( true ),
+				m_timerId( 0 )
 		{
 		}
 
@@ -366,7 +432,16 @@ class PathModel : public QAbstractItemModel
 		void setColumns( const std::vector<ColumnPtr> columns )
 		{
 			m_columns = columns;
-			setRoot( getRoot() ); // force a rebuild of our items
+
+			m_propertyNames.clear();
+			for( std::vector<ColumnPtr>::const_iterator it = m_columns.begin(), eIt = m_columns.end(); it != eIt; ++it )
+			{
+				(*it)->propertyNames( m_propertyNames );
+			}
+			std::sort( m_propertyNames.begin(), m_propertyNames.end() );
+			m_propertyNames.erase( std::unique( m_propertyNames.begin(), m_propertyNames.end() ), m_propertyNames.end() );
+
+			setRoot( getRoot(), m_background ); // force a rebuild of our items
 		}
 
 		const std::vector<ColumnPtr> &getColumns() const
@@ -379,9 +454,16 @@ class PathModel : public QAbstractItemModel
 			return m_rootItem->path();
 		}
 
-		void setRoot( PathPtr root )
+		// If `background` is false, children are evaluated directly
+		// on the UI thread. See PathChildrenTask for details.
+		void setRoot( PathPtr root, bool background )
 		{
+			m_background = background;
 			beginResetModel();
+			// Deleting the items cancels any
+			// background tasks they own.
+			m_pendingItems.clear();
+			stopTimer();
 			delete m_rootItem;
 			m_rootItem = new Item( root, 0, NULL );
 			endResetModel();
@@ -437,6 +519,10 @@ class PathModel : public QAbstractItemModel
 			for( size_t i = rootPath->names().size(); i < path->names().size(); ++i )
 			{
 				bool foundNextItem = false;
+				// We need a definitive answer, so must wait for
+				// the children to be evaluated in full.
+				item->childItems( this );
+				item->updateChildItems( this, /* wait = */ true );
 				const std::vector<Item *> &childItems = item->childItems( this );
 				for( std::vector<Item *>::const_iterator it = childItems.begin(), eIt = childItems.end(); it != eIt; ++it )
 				{
@@ -469,7 +555,7 @@ class PathModel : public QAbstractItemModel
 			}
 
 			Item *item = static_cast<Item *>( index.internalPointer() );
-			return item->data( index.column(), role, m_columns );
+			return item->data( index.column(), role, this );
 		}
 
 		virtual QVariant headerData( int section, Qt::Orientation orientation, int role = Qt::DisplayRole ) const
@@ -545,15 +631,82 @@ class PathModel : public QAbstractItemModel
 			layoutChanged();
 		}
 
+	protected :
+
+		virtual void timerEvent( QTimerEvent *event )
+		{
+			if( event->timerId() != m_timerId )
+			{
+				QAbstractItemModel::timerEvent( event );
+				return;
+			}
+
+			// Updating may emit signals which cause further items
+			// to become pending, or even the whole model to be
+			// reset, so we work from a copy of the pending list.
+			std::vector<Item *> pendingItems;
+			pendingItems.swap( m_pendingItems );
+			Item *rootItem = m_rootItem;
+			for( size_t i = 0; i < pendingItems.size(); ++i )
+			{
+				if( m_rootItem != rootItem )
+				{
+					// Model was reset, and the remaining
+					// pending items have been deleted.
+					return;
+				}
+				if( !pendingItems[i]->updateChildItems( this, /* wait = */ false ) )
+				{
+					m_pendingItems.push_back( pendingItems[i] );
+				}
+			}
+
+			if( m_pendingItems.empty() )
+			{
+				stopTimer();
+				// All children have now arrived. We don't have signals of
+				// our own (see note about Q_OBJECT above), so we use this
+				// to let the view know that now would be a good time to
+				// recalculate the column widths, rather than doing it as
+				// each chunk of children arrives.
+				const int lastColumn = columnCount() - 1;
+				if( lastColumn >= 0 )
+				{
+					headerDataChanged( Qt::Horizontal, 0, lastColumn );
+				}
+			}
+		}
+
 	private :
 
+		struct Item;
+
+		void addPendingItem( Item *item )
+		{
+			m_pendingItems.push_back( item );
+			if( !m_timerId )
+			{
+				m_timerId = startTimer( 20 );
+			}
+		}
+
+		void stopTimer()
+		{
+			if( m_timerId )
+			{
+				killTimer( m_timerId );
+				m_timerId = 0;
+			}
+		}
+
 		// A single item in the PathModel - stores a path and caches
 		// data extracted from it to provide the model content.
 		struct Item
 		{
 
-			Item( Gaffer::PathPtr path, int row, Item *parent )
-				:	m_path( path ), m_parent( parent ), m_row( row ), m_dataDone( false ), m_childItemsDone( false )
+			Item( Gaffer::PathPtr path, int row, Item *parent, const PathChildrenTask::Properties &prefetchedProperties = PathChildrenTask::Properties() )
+				:	m_path( path ), m_parent( parent ), m_row( row ), m_prefetchedProperties( prefetchedProperties ),
+					m_dataDone( false ), m_childItemsDone( false ), m_numSortedChildItems( 0 )
 			{
 			}
 
@@ -583,11 +736,11 @@ class PathModel : public QAbstractItemModel
 			// Returns the data for the specified column and role, using the provided
 			// Columns to generate it as necessary. The Item is responsible for caching
 			// the results of these queries internally.
-			QVariant data( int column, int role, const std::vector<ColumnPtr> &columns )
+			QVariant data( int column, int role, const PathModel *model )
 			{
 				// We generate data for all columns and roles at once, on the assumption
 				// that access to one is likely to indicate upcoming accesses to the others.
-				ensureData( columns );
+				ensureData( model );
 
 				switch( role )
 				{
@@ -600,32 +753,98 @@ class PathModel : public QAbstractItemModel
 				}
 			}
 
+			// Returns the child items available so far. The first call launches
+			// a background task to evaluate the children, and they are added
+			// later by updateChildItems().
 			std::vector<Item *> &childItems( const PathModel *model )
 			{
 				if( !m_childItemsDone && m_path )
 				{
-					std::vector<Gaffer::PathPtr> children;
 					try
 					{
-						m_path->children( children );
+						m_childrenTask = new PathChildrenTask( m_path.get(), model->m_propertyNames, 100, model->m_background );
+						const_cast<PathModel *>( model )->addPendingItem( this );
 					}
 					catch( const std::exception &e )
 					{
 						IECore::msg( IECore::Msg::Error, "PathListingWidget", e.what() );
 					}
-
-					for( std::vector<Gaffer::PathPtr>::const_iterator it = children.begin(), eIt = children.end(); it != eIt; ++it )
-					{
-						m_childItems.push_back( new Item( *it, it - children.begin(), this ) );
-					}
-					// If the model is sorted, then we need to apply that same
-					// sorting to the new items - see comment for PathModel::sort().
-					sort( model );
 				}
 				m_childItemsDone = true;
 				return m_childItems;
 			}
 
+			// Appends any children made available by the background task,
+			// emitting the appropriate signals from the model. If wait is
+			// true, blocks until all children are available. Returns true
+			// if there are no more children to come.
+			bool updateChildItems( PathModel *model, bool wait )
+			{
+				if( !m_childrenTask )
+				{
+					return true;
+				}
+
+				if( wait )
+				{
+					m_childrenTask->wait();
+				}
+
+				PathChildrenTask::Children children;
+				const PathChildrenTask::Status status = m_childrenTask->takeChildren( children );
+				if( status == PathChildrenTask::Errored )
+				{
+					IECore::msg( IECore::Msg::Error, "PathListingWidget", m_childrenTask->error() );
+				}
+
+				const bool finished = status != PathChildrenTask::Running;
+				if( finished )
+				{
+					m_childrenTask = NULL;
+				}
+
+				if( children.empty() )
+				{
+					return finished;
+				}
+
+				// In flat mode the model only exposes the children of the root,
+				// so we mustn't signal changes for items the view can't see.
+				const bool notify = this == model->m_rootItem || !model->m_flat;
+				const int firstRow = m_childItems.size();
+				if( notify )
+				{
+					const QModelIndex parentIndex = this == model->m_rootItem ? QModelIndex() : model->createIndex( m_row, 0, this );
+					model->beginInsertRows( parentIndex, firstRow, firstRow + children.size() - 1 );
+				}
+
+				m_childItems.reserve( firstRow + children.size() );
+				for( PathChildrenTask::Children::const_iterator it = children.begin(), eIt = children.end(); it != eIt; ++it )
+				{
+					m_childItems.push_back( new Item( it->path, m_childItems.size(), this, it->properties ) );
+				}
+
+				if( notify )
+				{
+					model->endInsertRows();
+				}
+
+				// If the model is sorted, then we need to apply that same
+				// sorting to the new items - see comment for PathModel::sort().
+				// Re-sorting for every chunk would be quadratic, so we only do it
+				// when the number of items has doubled, and then a final time
+				// once all the children have arrived.
+				if( model->m_sortColumn >= 0 && ( finished || m_childItems.size() >= 2 * m_numSortedChildItems ) )
+				{
+					model->layoutAboutToBeChanged();
+					sort( model );
+					model->layoutChanged();
+					m_numSortedChildItems = m_childItems.size();
+				}
+
+				return finished;
+			}
+
 			void sort( const PathModel *model )
 			{
 				if( model->m_sortColumn < 0 || model->m_sortColumn >= model->columnCount() )
@@ -642,7 +861,7 @@ class PathModel : public QAbstractItemModel
 				sortableChildren.reserve( m_childItems.size() );
 				for( int i = 0, e = m_childItems.size(); i < e; ++i )
 				{
-					m_childItems[i]->ensureData( model->getColumns() );
+					m_childItems[i]->ensureData( model );
 					sortableChildren.push_back( SortableItem( m_childItems[i], i ) );
 				}
 
@@ -655,6 +874,7 @@ class PathModel : public QAbstractItemModel
 					int fromRow = sortableChildren[i].second;
 					int toRow = reverse ? e - i - 1 : i;
 					m_childItems[toRow] = sortableChildren[i].first;
+					m_childItems[toRow]->m_row = toRow;
 					for( int c = 0, ce = model->getColumns().size(); c < ce; ++c )
 					{
 						changedPersistentIndexesFrom.append( model->createIndex( fromRow, c, sortableChildren[i].first ) );
@@ -675,13 +895,16 @@ class PathModel : public QAbstractItemModel
 				typedef std::pair<Item *, size_t> SortableItem;
 				typedef std::vector<SortableItem> SortableItems;
 
-				void ensureData( const std::vector<ColumnPtr> &columns )
+				void ensureData( const PathModel *model )
 				{
 					if( m_dataDone )
 					{
 						return;
 					}
 
+					const std::vector<ColumnPtr> &columns = model->getColumns();
+					const PropertySource propertySource( m_path.get(), model->m_propertyNames, m_prefetchedProperties );
+
 					m_displayData.reserve( columns.size() );
 					m_decorationData.reserve( columns.size() );
 					for( int i = 0, e = columns.size(); i < e; ++i )
@@ -690,8 +913,8 @@ class PathModel : public QAbstractItemModel
 						QVariant decorationData;
 						try
 						{
-							displayData = columns[i]->data( m_path.get(), Qt::DisplayRole );
-							decorationData = columns[i]->data( m_path.get(), Qt::DecorationRole );
+							displayData = columns[i]->data( propertySource, Qt::DisplayRole );
+							decorationData = columns[i]->data( propertySource, Qt::DecorationRole );
 						}
 						catch( const std::exception &e )
 						{
@@ -760,6 +983,7 @@ class PathModel : public QAbstractItemModel
 				Gaffer::PathPtr m_path;
 				Item *m_parent;
 				int m_row;
+				PathChildrenTask::Properties m_prefetchedProperties;
 
 				bool m_dataDone;
 				std::vector<QVariant> m_displayData;
@@ -767,14 +991,26 @@ class PathModel : public QAbstractItemModel
 
 				bool m_childItemsDone;
 				std::vector<Item *> m_childItems;
+				// Non-null while the children are still
+				// being evaluated in the background.
+				PathChildrenTaskPtr m_childrenTask;
+				size_t m_numSortedChildItems;
 
 		};
 
 		Item *m_rootItem;
 		bool m_flat;
 		std::vector<ColumnPtr> m_columns;
+		PathChildrenTask::PropertyNames m_propertyNames;
 		int m_sortColumn;
 		Qt::SortOrder m_sortOrder;
+		bool m_background;
+
+		// Items whose children are being evaluated
+		// in the background, and the timer we use to
+		// poll them for results.
+		std::vector<Item *> m_pendingItems;
+		int m_timerId;
 
 };
 
@@ -800,7 +1036,7 @@ list getColumns( uint64_t treeViewAddress )
 	return result;
 }
 
-void updateModel( uint64_t treeViewAddress, Gaffer::PathPtr path )
+void updateModel( uint64_t treeViewAddress, Gaffer::PathPtr path, bool background )
 {
 	QTreeView *treeView = reinterpret_cast<QTreeView *>( treeViewAddress );
 	PathModel *model = dynamic_cast<PathModel *>( treeView->model() );
@@ -809,7 +1045,7 @@ void updateModel( uint64_t treeViewAddress, Gaffer::PathPtr path )
 		model = new PathModel( treeView );
 		treeView->setModel( model );
 	}
-	model->setRoot( path );
+	model->setRoot( path, background );
 }
 
 void setFlat( uint64_t treeViewAddress, bool flat )